@@ -0,0 +1,26 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class FootSyncCompute : ModuleRules
+{
+	public FootSyncCompute(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]
+		{
+			"Core"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[]
+		{
+			"CoreUObject",
+			"Engine",
+			"Projects",
+			"RenderCore",
+			"Renderer",
+			"RHI"
+		});
+	}
+}
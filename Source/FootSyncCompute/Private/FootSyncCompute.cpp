@@ -0,0 +1,26 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncCompute.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+#include "ShaderCore.h"
+
+#define LOCTEXT_NAMESPACE "FFootSyncComputeModule"
+
+void FFootSyncComputeModule::StartupModule()
+{
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("FootSyncMarkerGenerator"));
+	if (Plugin.IsValid())
+	{
+		AddShaderSourceDirectoryMapping(TEXT("/Plugin/FootSyncMarkerGenerator"),
+			FPaths::Combine(Plugin->GetBaseDir(), TEXT("Shaders")));
+	}
+}
+
+void FFootSyncComputeModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FFootSyncComputeModule, FootSyncCompute)
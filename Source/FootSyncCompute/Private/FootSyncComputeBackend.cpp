@@ -0,0 +1,406 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncComputeBackend.h"
+#include "GlobalShader.h"
+#include "ShaderParameterStruct.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "ComputeShaderUtils.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
+#include "DataDrivenShaderPlatformInfo.h"
+#include "Misc/App.h"
+#include "EngineLogs.h"
+
+/** Per-trajectory statistics written by ReduceCS, matches NUM_STATS in the shader */
+static constexpr int32 NumTrajectoryStats = 8;
+static constexpr int32 StatMaxSpeed = 0;
+static constexpr int32 StatMaxCurvature = 1;
+static constexpr int32 StatMinRelX = 4;
+static constexpr int32 StatMaxRelX = 5;
+static constexpr int32 StatMinRelY = 6;
+static constexpr int32 StatMaxRelY = 7;
+
+/** Candidate as appended by CandidatesCS (uint4 in the shader) */
+struct FFootSyncCandidateRecord
+{
+	uint32 Trajectory;
+	uint32 FrameAndKind;
+	float Value;
+	float PrevValue;
+};
+static_assert(sizeof(FFootSyncCandidateRecord) == 16, "Must match the uint4 candidate layout of FootSyncTrajectory.usf");
+
+// ============== Shaders ==============
+
+BEGIN_SHADER_PARAMETER_STRUCT(FFootSyncTrajectoryParameters, )
+	SHADER_PARAMETER(uint32, NumTotalFrames)
+	SHADER_PARAMETER(uint32, NumTrajectories)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Times)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, PositionX)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, PositionY)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, PositionZ)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, PelvisRelativeX)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, PelvisRelativeY)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, FrameTrajectory)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint2>, TrajectoryRanges)
+END_SHADER_PARAMETER_STRUCT()
+
+/** Base for the trajectory kernels, compiled for SM5 platforms only */
+class FFootSyncTrajectoryCS : public FGlobalShader
+{
+public:
+	static constexpr int32 ThreadGroupSize = 64;
+
+	FFootSyncTrajectoryCS() = default;
+	FFootSyncTrajectoryCS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+		: FGlobalShader(Initializer)
+	{
+	}
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZE"), ThreadGroupSize);
+	}
+};
+
+/** Speed and curvature for every frame */
+class FFootSyncSignalsCS : public FFootSyncTrajectoryCS
+{
+	DECLARE_GLOBAL_SHADER(FFootSyncSignalsCS);
+	SHADER_USE_PARAMETER_STRUCT(FFootSyncSignalsCS, FFootSyncTrajectoryCS);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_INCLUDE(FFootSyncTrajectoryParameters, Trajectories)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, OutSpeed)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, OutCurvature)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+/** Maxima, curvature derivative statistics and pelvis-relative ranges per trajectory */
+class FFootSyncReduceCS : public FFootSyncTrajectoryCS
+{
+	DECLARE_GLOBAL_SHADER(FFootSyncReduceCS);
+	SHADER_USE_PARAMETER_STRUCT(FFootSyncReduceCS, FFootSyncTrajectoryCS);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_INCLUDE(FFootSyncTrajectoryParameters, Trajectories)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Speed)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Curvature)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, OutStats)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+/** Candidate frames appended to a compact list */
+class FFootSyncCandidatesCS : public FFootSyncTrajectoryCS
+{
+	DECLARE_GLOBAL_SHADER(FFootSyncCandidatesCS);
+	SHADER_USE_PARAMETER_STRUCT(FFootSyncCandidatesCS, FFootSyncTrajectoryCS);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_INCLUDE(FFootSyncTrajectoryParameters, Trajectories)
+		SHADER_PARAMETER(uint32, CandidateCapacity)
+		SHADER_PARAMETER(uint32, KindMask)
+		SHADER_PARAMETER(float, VelocityThreshold)
+		SHADER_PARAMETER(float, SaliencyThreshold)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Speed)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Curvature)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, Stats)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint4>, OutCandidates)
+		SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, OutCandidateCount)
+	END_SHADER_PARAMETER_STRUCT()
+};
+
+IMPLEMENT_GLOBAL_SHADER(FFootSyncSignalsCS, "/Plugin/FootSyncMarkerGenerator/Private/FootSyncTrajectory.usf", "SignalsCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FFootSyncReduceCS, "/Plugin/FootSyncMarkerGenerator/Private/FootSyncTrajectory.usf", "ReduceCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FFootSyncCandidatesCS, "/Plugin/FootSyncMarkerGenerator/Private/FootSyncTrajectory.usf", "CandidatesCS", SF_Compute);
+
+// ============== Batch Upload ==============
+
+/**
+ * Trajectories of a batch concatenated into flat per-channel arrays
+ */
+struct FFootSyncComputeBatch
+{
+	TArray<float> Times;
+	TArray<float> PositionX;
+	TArray<float> PositionY;
+	TArray<float> PositionZ;
+	TArray<float> PelvisRelativeX;
+	TArray<float> PelvisRelativeY;
+	TArray<uint32> FrameTrajectory;
+	TArray<FUintVector2> TrajectoryRanges;
+
+	void Build(TConstArrayView<FFootSyncComputeTrajectory> Trajectories)
+	{
+		int32 NumTotalFrames = 0;
+		for (const FFootSyncComputeTrajectory& Trajectory : Trajectories)
+		{
+			NumTotalFrames += Trajectory.Times.Num();
+		}
+
+		for (TArray<float>* Channel : { &Times, &PositionX, &PositionY, &PositionZ, &PelvisRelativeX, &PelvisRelativeY })
+		{
+			Channel->Reset(NumTotalFrames);
+		}
+		FrameTrajectory.Reset(NumTotalFrames);
+		TrajectoryRanges.Reset(Trajectories.Num());
+
+		for (int32 TrajectoryIndex = 0; TrajectoryIndex < Trajectories.Num(); ++TrajectoryIndex)
+		{
+			const FFootSyncComputeTrajectory& Trajectory = Trajectories[TrajectoryIndex];
+			const int32 NumFrames = Trajectory.Times.Num();
+			check(Trajectory.PositionX.Num() == NumFrames && Trajectory.PositionY.Num() == NumFrames
+				&& Trajectory.PositionZ.Num() == NumFrames && Trajectory.PelvisRelativeX.Num() == NumFrames
+				&& Trajectory.PelvisRelativeY.Num() == NumFrames);
+
+			TrajectoryRanges.Add(FUintVector2(Times.Num(), NumFrames));
+
+			// Times are rebased to the first frame so float precision does not depend on the clip offset
+			const double StartTime = NumFrames > 0 ? Trajectory.Times[0] : 0.0;
+			for (double Time : Trajectory.Times)
+			{
+				Times.Add(static_cast<float>(Time - StartTime));
+			}
+
+			PositionX.Append(Trajectory.PositionX.GetData(), NumFrames);
+			PositionY.Append(Trajectory.PositionY.GetData(), NumFrames);
+			PositionZ.Append(Trajectory.PositionZ.GetData(), NumFrames);
+			PelvisRelativeX.Append(Trajectory.PelvisRelativeX.GetData(), NumFrames);
+			PelvisRelativeY.Append(Trajectory.PelvisRelativeY.GetData(), NumFrames);
+
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				FrameTrajectory.Add(static_cast<uint32>(TrajectoryIndex));
+			}
+		}
+	}
+
+	int32 GetNumTotalFrames() const { return Times.Num(); }
+};
+
+static uint32 GetKindMask(const FFootSyncComputeParams& Params)
+{
+	return (Params.bVelocityMinima ? 1u << static_cast<uint32>(EFootSyncComputeCandidateKind::VelocityMinimum) : 0u)
+		| (Params.bSaliencyPeaks ? 1u << static_cast<uint32>(EFootSyncComputeCandidateKind::SaliencyPeak) : 0u)
+		| (Params.bPelvisCrossings ? 1u << static_cast<uint32>(EFootSyncComputeCandidateKind::PelvisCrossing) : 0u);
+}
+
+// ============== Backend ==============
+
+bool FFootSyncComputeBackend::IsAvailable()
+{
+	return FApp::CanEverRender()
+		&& GDynamicRHI != nullptr
+		&& GMaxRHIFeatureLevel >= ERHIFeatureLevel::SM5;
+}
+
+bool FFootSyncComputeBackend::AnalyzeTrajectories(
+	TConstArrayView<FFootSyncComputeTrajectory> Trajectories,
+	const FFootSyncComputeParams& Params,
+	TArray<FFootSyncComputeTrajectoryResult>& OutResults)
+{
+	check(IsInGameThread());
+	OutResults.Reset();
+
+	if (!IsAvailable())
+	{
+		return false;
+	}
+
+	FFootSyncComputeBatch Batch;
+	Batch.Build(Trajectories);
+
+	const int32 NumTotalFrames = Batch.GetNumTotalFrames();
+	const int32 NumTrajectories = Trajectories.Num();
+	if (NumTotalFrames == 0)
+	{
+		OutResults.SetNum(NumTrajectories);
+		return true;
+	}
+
+	// Each kind emits at most one candidate per frame, so the list can never overflow
+	const uint32 KindMask = GetKindMask(Params);
+	const uint32 CandidateCapacity = static_cast<uint32>(NumTotalFrames) * FMath::CountBits(KindMask);
+
+	TArray<float> StatsData;
+	TArray<FFootSyncCandidateRecord> CandidateData;
+	bool bSucceeded = false;
+
+	ENQUEUE_RENDER_COMMAND(FootSyncAnalyzeTrajectories)(
+		[&Batch, &Params, &StatsData, &CandidateData, &bSucceeded, NumTotalFrames, NumTrajectories, KindMask, CandidateCapacity]
+		(FRHICommandListImmediate& RHICmdList)
+	{
+		FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+		TShaderMapRef<FFootSyncSignalsCS> SignalsShader(ShaderMap);
+		TShaderMapRef<FFootSyncReduceCS> ReduceShader(ShaderMap);
+		TShaderMapRef<FFootSyncCandidatesCS> CandidatesShader(ShaderMap);
+
+		if (!SignalsShader.IsValid() || !ReduceShader.IsValid() || !CandidatesShader.IsValid())
+		{
+			return;
+		}
+
+		FRHIGPUBufferReadback CountReadback(TEXT("FootSync.CandidateCountReadback"));
+		FRHIGPUBufferReadback StatsReadback(TEXT("FootSync.StatsReadback"));
+		TRefCountPtr<FRDGPooledBuffer> PooledCandidates;
+
+		// Pass 1: signals, statistics and candidates; only the count and statistics are read back
+		{
+			FRDGBuilder GraphBuilder(RHICmdList, RDG_EVENT_NAME("FootSyncTrajectoryAnalysis"));
+
+			auto Upload = [&GraphBuilder](const TCHAR* Name, const auto& Data)
+			{
+				return GraphBuilder.CreateSRV(CreateStructuredBuffer(GraphBuilder, Name, Data, ERDGInitialDataFlags::NoCopy));
+			};
+
+			FFootSyncTrajectoryParameters TrajectoryParameters;
+			TrajectoryParameters.NumTotalFrames = NumTotalFrames;
+			TrajectoryParameters.NumTrajectories = NumTrajectories;
+			TrajectoryParameters.Times = Upload(TEXT("FootSync.Times"), Batch.Times);
+			TrajectoryParameters.PositionX = Upload(TEXT("FootSync.PositionX"), Batch.PositionX);
+			TrajectoryParameters.PositionY = Upload(TEXT("FootSync.PositionY"), Batch.PositionY);
+			TrajectoryParameters.PositionZ = Upload(TEXT("FootSync.PositionZ"), Batch.PositionZ);
+			TrajectoryParameters.PelvisRelativeX = Upload(TEXT("FootSync.PelvisRelativeX"), Batch.PelvisRelativeX);
+			TrajectoryParameters.PelvisRelativeY = Upload(TEXT("FootSync.PelvisRelativeY"), Batch.PelvisRelativeY);
+			TrajectoryParameters.FrameTrajectory = Upload(TEXT("FootSync.FrameTrajectory"), Batch.FrameTrajectory);
+			TrajectoryParameters.TrajectoryRanges = Upload(TEXT("FootSync.TrajectoryRanges"), Batch.TrajectoryRanges);
+
+			FRDGBufferRef SpeedBuffer = GraphBuilder.CreateBuffer(
+				FRDGBufferDesc::CreateStructuredDesc(sizeof(float), NumTotalFrames), TEXT("FootSync.Speed"));
+			FRDGBufferRef CurvatureBuffer = GraphBuilder.CreateBuffer(
+				FRDGBufferDesc::CreateStructuredDesc(sizeof(float), NumTotalFrames), TEXT("FootSync.Curvature"));
+			FRDGBufferRef StatsBuffer = GraphBuilder.CreateBuffer(
+				FRDGBufferDesc::CreateStructuredDesc(sizeof(float), NumTrajectories * NumTrajectoryStats), TEXT("FootSync.Stats"));
+			FRDGBufferRef CandidatesBuffer = GraphBuilder.CreateBuffer(
+				FRDGBufferDesc::CreateStructuredDesc(sizeof(FFootSyncCandidateRecord), FMath::Max(CandidateCapacity, 1u)), TEXT("FootSync.Candidates"));
+			FRDGBufferRef CountBuffer = GraphBuilder.CreateBuffer(
+				FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), 1), TEXT("FootSync.CandidateCount"));
+
+			const FIntVector FrameGroups = FComputeShaderUtils::GetGroupCountWrapped(NumTotalFrames, FFootSyncTrajectoryCS::ThreadGroupSize);
+
+			FFootSyncSignalsCS::FParameters* SignalsParameters = GraphBuilder.AllocParameters<FFootSyncSignalsCS::FParameters>();
+			SignalsParameters->Trajectories = TrajectoryParameters;
+			SignalsParameters->OutSpeed = GraphBuilder.CreateUAV(SpeedBuffer);
+			SignalsParameters->OutCurvature = GraphBuilder.CreateUAV(CurvatureBuffer);
+			FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("FootSync.Signals"),
+				SignalsShader, SignalsParameters, FrameGroups);
+
+			FFootSyncReduceCS::FParameters* ReduceParameters = GraphBuilder.AllocParameters<FFootSyncReduceCS::FParameters>();
+			ReduceParameters->Trajectories = TrajectoryParameters;
+			ReduceParameters->Speed = GraphBuilder.CreateSRV(SpeedBuffer);
+			ReduceParameters->Curvature = GraphBuilder.CreateSRV(CurvatureBuffer);
+			ReduceParameters->OutStats = GraphBuilder.CreateUAV(StatsBuffer);
+			FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("FootSync.Reduce"),
+				ReduceShader, ReduceParameters, FComputeShaderUtils::GetGroupCountWrapped(NumTrajectories));
+
+			FRDGBufferUAVRef CountUAV = GraphBuilder.CreateUAV(CountBuffer);
+			AddClearUAVPass(GraphBuilder, CountUAV, 0u);
+
+			FFootSyncCandidatesCS::FParameters* CandidatesParameters = GraphBuilder.AllocParameters<FFootSyncCandidatesCS::FParameters>();
+			CandidatesParameters->Trajectories = TrajectoryParameters;
+			CandidatesParameters->CandidateCapacity = CandidateCapacity;
+			CandidatesParameters->KindMask = KindMask;
+			CandidatesParameters->VelocityThreshold = Params.VelocityThreshold;
+			CandidatesParameters->SaliencyThreshold = Params.SaliencyThreshold;
+			CandidatesParameters->Speed = GraphBuilder.CreateSRV(SpeedBuffer);
+			CandidatesParameters->Curvature = GraphBuilder.CreateSRV(CurvatureBuffer);
+			CandidatesParameters->Stats = GraphBuilder.CreateSRV(StatsBuffer);
+			CandidatesParameters->OutCandidates = GraphBuilder.CreateUAV(CandidatesBuffer);
+			CandidatesParameters->OutCandidateCount = CountUAV;
+			FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("FootSync.Candidates"),
+				CandidatesShader, CandidatesParameters, FrameGroups);
+
+			AddEnqueueCopyPass(GraphBuilder, &CountReadback, CountBuffer, sizeof(uint32));
+			AddEnqueueCopyPass(GraphBuilder, &StatsReadback, StatsBuffer, NumTrajectories * NumTrajectoryStats * sizeof(float));
+			GraphBuilder.QueueBufferExtraction(CandidatesBuffer, &PooledCandidates);
+
+			GraphBuilder.Execute();
+		}
+
+		RHICmdList.BlockUntilGPUIdle();
+		if (!CountReadback.IsReady() || !StatsReadback.IsReady())
+		{
+			return;
+		}
+
+		const uint32 NumCandidates = FMath::Min(*static_cast<const uint32*>(CountReadback.Lock(sizeof(uint32))), CandidateCapacity);
+		CountReadback.Unlock();
+
+		StatsData.SetNumUninitialized(NumTrajectories * NumTrajectoryStats);
+		FMemory::Memcpy(StatsData.GetData(), StatsReadback.Lock(StatsData.Num() * sizeof(float)), StatsData.Num() * sizeof(float));
+		StatsReadback.Unlock();
+
+		// Pass 2: copy back only the candidates that were written
+		if (NumCandidates > 0)
+		{
+			const uint32 NumBytes = NumCandidates * sizeof(FFootSyncCandidateRecord);
+
+			FRHIGPUBufferReadback CandidateReadback(TEXT("FootSync.CandidateReadback"));
+			CandidateReadback.EnqueueCopy(RHICmdList, PooledCandidates->GetRHI(), NumBytes);
+			RHICmdList.BlockUntilGPUIdle();
+			if (!CandidateReadback.IsReady())
+			{
+				return;
+			}
+
+			CandidateData.SetNumUninitialized(NumCandidates);
+			FMemory::Memcpy(CandidateData.GetData(), CandidateReadback.Lock(NumBytes), NumBytes);
+			CandidateReadback.Unlock();
+		}
+
+		bSucceeded = true;
+	});
+	FlushRenderingCommands();
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncComputeBackend: Trajectory analysis of %d trajectories failed (shaders unavailable or readback not ready)"),
+			NumTrajectories);
+		return false;
+	}
+
+	// Scatter the compact list back to its trajectories
+	OutResults.SetNum(NumTrajectories);
+	for (int32 TrajectoryIndex = 0; TrajectoryIndex < NumTrajectories; ++TrajectoryIndex)
+	{
+		const float* TrajectoryStats = StatsData.GetData() + TrajectoryIndex * NumTrajectoryStats;
+		FFootSyncComputeTrajectoryResult& Result = OutResults[TrajectoryIndex];
+		Result.MaxSpeed = TrajectoryStats[StatMaxSpeed];
+		Result.MaxCurvature = TrajectoryStats[StatMaxCurvature];
+		Result.bMoveAxisY = (TrajectoryStats[StatMaxRelY] - TrajectoryStats[StatMinRelY])
+			> (TrajectoryStats[StatMaxRelX] - TrajectoryStats[StatMinRelX]);
+	}
+
+	for (const FFootSyncCandidateRecord& Record : CandidateData)
+	{
+		if (Record.Trajectory >= static_cast<uint32>(NumTrajectories))
+		{
+			continue;
+		}
+
+		FFootSyncComputeCandidate& Candidate = OutResults[Record.Trajectory].Candidates.AddDefaulted_GetRef();
+		Candidate.Frame = static_cast<int32>(Record.FrameAndKind >> 2);
+		Candidate.Kind = static_cast<EFootSyncComputeCandidateKind>(Record.FrameAndKind & 3u);
+		Candidate.Value = Record.Value;
+		Candidate.PrevValue = Record.PrevValue;
+	}
+
+	// Appends are unordered on the GPU
+	for (FFootSyncComputeTrajectoryResult& Result : OutResults)
+	{
+		Result.Candidates.Sort([](const FFootSyncComputeCandidate& A, const FFootSyncComputeCandidate& B)
+		{
+			return A.Frame != B.Frame ? A.Frame < B.Frame : A.Kind < B.Kind;
+		});
+	}
+
+	return true;
+}
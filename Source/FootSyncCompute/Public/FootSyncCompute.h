@@ -0,0 +1,18 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * GPU compute backend for FootSync trajectory analysis
+ * Loaded at PostConfigInit so the plugin shader directory is mapped before shaders compile.
+ */
+class FFootSyncComputeModule : public IModuleInterface
+{
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};
@@ -0,0 +1,117 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Kind of candidate frame produced by the GPU trajectory analysis
+ */
+enum class EFootSyncComputeCandidateKind : uint8
+{
+	/** Local minimum of the foot speed below the velocity threshold */
+	VelocityMinimum = 0,
+
+	/** Curvature peak or rapid curvature change (saliency) */
+	SaliencyPeak = 1,
+
+	/** Sign change of the pelvis-relative position along the primary axis */
+	PelvisCrossing = 2
+};
+
+/**
+ * Candidate frame read back from the GPU
+ */
+struct FFootSyncComputeCandidate
+{
+	/** Frame of the candidate within its trajectory */
+	int32 Frame = 0;
+
+	/** What the candidate marks */
+	EFootSyncComputeCandidateKind Kind = EFootSyncComputeCandidateKind::VelocityMinimum;
+
+	/** Speed, curvature or projected position at Frame, depending on Kind */
+	float Value = 0.0f;
+
+	/** Projected position at Frame - 1 (pelvis crossings only) */
+	float PrevValue = 0.0f;
+};
+
+/**
+ * Single foot trajectory uploaded for analysis
+ * Views must stay valid until AnalyzeTrajectories returns. All views have the same length.
+ */
+struct FFootSyncComputeTrajectory
+{
+	/** Time of each frame in seconds */
+	TConstArrayView<double> Times;
+
+	/** Foot position in animation (component) space */
+	TConstArrayView<float> PositionX;
+	TConstArrayView<float> PositionY;
+	TConstArrayView<float> PositionZ;
+
+	/** Foot position relative to the pelvis, in pelvis space (only X and Y are projected) */
+	TConstArrayView<float> PelvisRelativeX;
+	TConstArrayView<float> PelvisRelativeY;
+};
+
+/**
+ * Thresholds and candidate kinds shared by every trajectory of a batch
+ */
+struct FFootSyncComputeParams
+{
+	/** Speed below which a local minimum is a candidate (cm/s) */
+	float VelocityThreshold = 10.0f;
+
+	/** Fraction between mean and max curvature derivative for the adaptive saliency threshold */
+	float SaliencyThreshold = 0.5f;
+
+	/** Candidate kinds to emit */
+	bool bVelocityMinima = true;
+	bool bSaliencyPeaks = true;
+	bool bPelvisCrossings = true;
+};
+
+/**
+ * Analysis output of a single trajectory
+ */
+struct FFootSyncComputeTrajectoryResult
+{
+	/** Candidates in frame order (kinds interleaved) */
+	TArray<FFootSyncComputeCandidate> Candidates;
+
+	/** Maximum foot speed, for velocity confidence scaling */
+	float MaxSpeed = 0.0f;
+
+	/** Maximum curvature, for saliency confidence scaling */
+	float MaxCurvature = 0.0f;
+
+	/** Whether the pelvis crossings were projected on Y (strafing) rather than X */
+	bool bMoveAxisY = false;
+};
+
+/**
+ * Optional GPU backend computing the velocity, curvature and pelvis-projection signals
+ * of many trajectories in one render graph, and reading back only the candidate frames.
+ * Selection, confidence and merging stay on the CPU; the CPU detectors remain the
+ * reference, GPU float arithmetic may differ from them in the last bits.
+ */
+class FOOTSYNCCOMPUTE_API FFootSyncComputeBackend
+{
+public:
+	/** Whether compute shaders can be dispatched in this process (false for null RHI) */
+	static bool IsAvailable();
+
+	/**
+	 * Analyze a batch of trajectories on the GPU (game thread, blocks until read back)
+	 * @param Trajectories Trajectories to analyze
+	 * @param Params Thresholds and candidate kinds
+	 * @param OutResults Receives one result per trajectory, in input order
+	 * @return False if the backend is unavailable or the readback failed, OutResults is then empty
+	 */
+	static bool AnalyzeTrajectories(
+		TConstArrayView<FFootSyncComputeTrajectory> Trajectories,
+		const FFootSyncComputeParams& Params,
+		TArray<FFootSyncComputeTrajectoryResult>& OutResults);
+};
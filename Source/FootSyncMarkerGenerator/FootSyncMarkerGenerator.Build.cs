@@ -14,7 +14,9 @@ public class FootSyncMarkerGenerator : ModuleRules
 			"CoreUObject",
 			"Engine",
 			"AnimationBlueprintLibrary",
-			"AnimationModifiers"
+			"AnimationModifiers",
+			"FootSyncCompute",
+			"FootSyncRuntime"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[]
@@ -22,7 +24,9 @@ public class FootSyncMarkerGenerator : ModuleRules
 			"Slate",
 			"SlateCore",
 			"UnrealEd",
-			"DeveloperSettings"
+			"DeveloperSettings",
+			"AssetRegistry",
+			"DerivedDataCache"
 		});
 	}
 }
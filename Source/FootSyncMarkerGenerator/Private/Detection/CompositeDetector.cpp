@@ -1,150 +1,290 @@
 // Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
 
 #include "Detection/CompositeDetector.h"
-#include "FootSyncMarkerSettings.h"
+#include "FootSyncStats.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
 
 FCompositeDetector::FCompositeDetector()
+	: FCompositeDetector(FFootSyncDetectionConfig::FromProjectSettings())
 {
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-	PelvisCrossingWeight = Settings->CompositeWeights.PelvisCrossingWeight;
-	VelocityCurveWeight = Settings->CompositeWeights.VelocityCurveWeight;
-	SaliencyWeight = Settings->CompositeWeights.SaliencyWeight;
-
-	PelvisDetector = MakeUnique<FPelvisCrossingDetector>();
-	VelocityDetector = MakeUnique<FVelocityCurveDetector>();
-	SaliencyDetector = MakeUnique<FSaliencyDetector>();
 }
 
-FCompositeDetector::FCompositeDetector(const FCompositeDetectionWeights& Weights)
-	: PelvisCrossingWeight(Weights.PelvisCrossingWeight)
-	, VelocityCurveWeight(Weights.VelocityCurveWeight)
-	, SaliencyWeight(Weights.SaliencyWeight)
+FCompositeDetector::FCompositeDetector(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+	, PelvisDetector(InConfig)
+	, VelocityDetector(InConfig)
+	, SaliencyDetector(InConfig)
+	, GroundHeightDetector(InConfig)
 {
-	PelvisDetector = MakeUnique<FPelvisCrossingDetector>();
-	VelocityDetector = MakeUnique<FVelocityCurveDetector>();
-	SaliencyDetector = MakeUnique<FSaliencyDetector>();
 }
 
 TArray<FFootContactResult> FCompositeDetector::DetectContacts(
-	UAnimSequence* AnimSequence,
+	const FFootSyncSamplingContext& Context,
 	const FSyncFootDefinition& Foot,
 	const FLocomotionPreset& Preset)
 {
-	// Run all detectors
+	FOOTSYNC_SCOPE(DetectComposite);
+
+	// Tiered mode holds Saliency back until the cheap detectors have been merged
+	const bool bRunSaliency = Config.CompositeWeights.SaliencyWeight > KINDA_SMALL_NUMBER;
+	const bool bTiered = Config.bTieredComposite && bRunSaliency;
+
+	// Run all detectors concurrently, they only read the shared sampling context
 	TArray<FFootContactResult> PelvisResults;
 	TArray<FFootContactResult> VelocityResults;
 	TArray<FFootContactResult> SaliencyResults;
+	TArray<FFootContactResult> GroundHeightResults;
 
-	if (PelvisDetector && PelvisCrossingWeight > KINDA_SMALL_NUMBER)
+	ParallelFor(4, [this, bRunSaliency, bTiered, &Context, &Foot, &Preset, &PelvisResults, &VelocityResults, &SaliencyResults, &GroundHeightResults](int32 DetectorIndex)
 	{
-		PelvisResults = PelvisDetector->DetectContacts(AnimSequence, Foot, Preset);
-	}
+		switch (DetectorIndex)
+		{
+		case 0:
+			if (Config.CompositeWeights.PelvisCrossingWeight > KINDA_SMALL_NUMBER)
+			{
+				PelvisResults = PelvisDetector.DetectContacts(Context, Foot, Preset);
+			}
+			break;
+
+		case 1:
+			if (Config.CompositeWeights.VelocityCurveWeight > KINDA_SMALL_NUMBER)
+			{
+				VelocityResults = VelocityDetector.DetectContacts(Context, Foot, Preset);
+			}
+			break;
+
+		case 2:
+			if (bRunSaliency && !bTiered)
+			{
+				SaliencyResults = SaliencyDetector.DetectContacts(Context, Foot, Preset);
+			}
+			break;
+
+		case 3:
+			if (Config.CompositeWeights.GroundHeightWeight > KINDA_SMALL_NUMBER)
+			{
+				GroundHeightResults = GroundHeightDetector.DetectContacts(Context, Foot, Preset);
+			}
+			break;
+
+		default:
+			break;
+		}
+	}, EParallelForFlags::Unbalanced);
 
-	if (VelocityDetector && VelocityCurveWeight > KINDA_SMALL_NUMBER)
+	if (bTiered)
 	{
-		VelocityResults = VelocityDetector->DetectContacts(AnimSequence, Foot, Preset);
-	}
+		++NumTieredFeet;
 
-	if (SaliencyDetector && SaliencyWeight > KINDA_SMALL_NUMBER)
-	{
-		SaliencyResults = SaliencyDetector->DetectContacts(AnimSequence, Foot, Preset);
+		const TArray<TInterval<float>> OpenWindows = FindOpenWindows(PelvisResults, VelocityResults, GroundHeightResults);
+		if (OpenWindows.Num() == 0)
+		{
+			++NumSaliencySkips;
+		}
+		else
+		{
+			// Saliency thresholds on statistics of the whole trajectory, so it runs on the whole
+			// foot and only votes in the open windows. Settled clusters merge as the cheap
+			// detectors found them.
+			SaliencyResults = SaliencyDetector.DetectContacts(Context, Foot, Preset);
+			SaliencyResults.RemoveAll([&OpenWindows](const FFootContactResult& Result)
+			{
+				const int32 Next = Algo::UpperBoundBy(OpenWindows, Result.Time, &TInterval<float>::Min);
+				return Next == 0 || Result.Time > OpenWindows[Next - 1].Max;
+			});
+		}
 	}
 
 	UE_LOG(LogAnimation, Verbose,
-		TEXT("CompositeDetector: Pelvis=%d, Velocity=%d, Saliency=%d results"),
-		PelvisResults.Num(), VelocityResults.Num(), SaliencyResults.Num());
+		TEXT("CompositeDetector: Pelvis=%d, Velocity=%d, Saliency=%d, GroundHeight=%d results"),
+		PelvisResults.Num(), VelocityResults.Num(), SaliencyResults.Num(), GroundHeightResults.Num());
 
 	// Merge results
-	return MergeResults(PelvisResults, VelocityResults, SaliencyResults);
+	return MergeResults(PelvisResults, VelocityResults, SaliencyResults, GroundHeightResults);
 }
 
 TArray<FFootContactResult> FCompositeDetector::MergeResults(
 	const TArray<FFootContactResult>& PelvisResults,
 	const TArray<FFootContactResult>& VelocityResults,
-	const TArray<FFootContactResult>& SaliencyResults)
+	const TArray<FFootContactResult>& SaliencyResults,
+	const TArray<FFootContactResult>& GroundHeightResults)
 {
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
+	FOOTSYNC_SCOPE(MergeResults);
 
-	// Combine all results
-	TArray<FFootContactResult> AllResults;
-	AllResults.Append(PelvisResults);
-	AllResults.Append(VelocityResults);
-	AllResults.Append(SaliencyResults);
-
-	if (AllResults.Num() == 0)
+	const int32 NumResults = PelvisResults.Num() + VelocityResults.Num() + SaliencyResults.Num() + GroundHeightResults.Num();
+	if (NumResults == 0)
 	{
 		return TArray<FFootContactResult>();
 	}
 
-	// Sort by time
-	AllResults.Sort([](const FFootContactResult& A, const FFootContactResult& B)
-	{
-		return A.Time < B.Time;
-	});
+	// Scratch memory comes from the thread's stack allocator and is released on return
+	FMemMark Mark(FMemStack::Get());
 
-	// Cluster by time proximity
-	TArray<TArray<FFootContactResult>> Clusters = ClusterResultsByTime(
-		AllResults, Settings->ResultMergeThreshold);
+	// Ties keep pelvis, velocity, saliency, ground height order
+	const TArray<FFootContactResult>* Inputs[] = { &PelvisResults, &VelocityResults, &SaliencyResults, &GroundHeightResults };
+	TArray<FFootContactResult, TMemStackAllocator<>> AllResults;
+	MergeInputs(Inputs, AllResults);
 
-	// Calculate final results from clusters
+	// Clusters are contiguous index ranges of the merged results
 	TArray<FFootContactResult> FinalResults;
-	for (const TArray<FFootContactResult>& Cluster : Clusters)
+	FinalResults.Reserve(NumResults);
+
+	for (int32 ClusterStart = 0; ClusterStart < NumResults;)
+	{
+		const int32 ClusterEnd = FindClusterEnd(AllResults, ClusterStart, Config.ResultMergeThreshold);
+
+		FinalResults.Add(CalculateClusterResult(
+			TConstArrayView<FFootContactResult>(AllResults.GetData() + ClusterStart, ClusterEnd - ClusterStart)));
+
+		ClusterStart = ClusterEnd;
+	}
+
+	return FinalResults;
+}
+
+TConstArrayView<FFootContactResult> FCompositeDetector::GetTimeSorted(
+	const TArray<FFootContactResult>& Results,
+	TArray<FFootContactResult, TMemStackAllocator<>>& Scratch)
+{
+	for (int32 i = 1; i < Results.Num(); ++i)
 	{
-		if (Cluster.Num() > 0)
+		if (Results[i].Time < Results[i - 1].Time)
 		{
-			FinalResults.Add(CalculateClusterResult(Cluster));
+			Scratch.Reset(Results.Num());
+			Scratch.Append(Results);
+			Scratch.StableSort([](const FFootContactResult& A, const FFootContactResult& B)
+			{
+				return A.Time < B.Time;
+			});
+			return Scratch;
 		}
 	}
 
-	return FinalResults;
+	return Results;
 }
 
-TArray<TArray<FFootContactResult>> FCompositeDetector::ClusterResultsByTime(
-	const TArray<FFootContactResult>& AllResults,
-	float MergeThreshold)
+void FCompositeDetector::MergeInputs(
+	TConstArrayView<const TArray<FFootContactResult>*> Results,
+	TArray<FFootContactResult, TMemStackAllocator<>>& OutMerged)
 {
-	TArray<TArray<FFootContactResult>> Clusters;
+	constexpr int32 MaxInputs = 4;
+	check(Results.Num() <= MaxInputs);
+
+	// Detectors emit results in time order; sort a scratch copy only if one does not
+	TArray<FFootContactResult, TMemStackAllocator<>> SortedScratch[MaxInputs];
+	TConstArrayView<FFootContactResult> Inputs[MaxInputs];
+	int32 NumResults = 0;
+	for (int32 InputIndex = 0; InputIndex < Results.Num(); ++InputIndex)
+	{
+		Inputs[InputIndex] = GetTimeSorted(*Results[InputIndex], SortedScratch[InputIndex]);
+		NumResults += Inputs[InputIndex].Num();
+	}
 
-	if (AllResults.Num() == 0)
+	// K-way merge of the sorted inputs
+	OutMerged.SetNumUninitialized(NumResults);
+
+	int32 Cursors[MaxInputs] = { 0, 0, 0, 0 };
+	for (int32 OutIndex = 0; OutIndex < NumResults; ++OutIndex)
 	{
-		return Clusters;
+		int32 Best = INDEX_NONE;
+		for (int32 InputIndex = 0; InputIndex < Results.Num(); ++InputIndex)
+		{
+			if (Cursors[InputIndex] < Inputs[InputIndex].Num()
+				&& (Best == INDEX_NONE || Inputs[InputIndex][Cursors[InputIndex]].Time < Inputs[Best][Cursors[Best]].Time))
+			{
+				Best = InputIndex;
+			}
+		}
+
+		OutMerged[OutIndex] = Inputs[Best][Cursors[Best]++];
 	}
+}
+
+TArray<TInterval<float>> FCompositeDetector::FindOpenWindows(
+	const TArray<FFootContactResult>& PelvisResults,
+	const TArray<FFootContactResult>& VelocityResults,
+	const TArray<FFootContactResult>& GroundHeightResults)
+{
+	TArray<TInterval<float>> OpenWindows;
+
+	FMemMark Mark(FMemStack::Get());
 
-	// Start first cluster
-	TArray<FFootContactResult> CurrentCluster;
-	CurrentCluster.Add(AllResults[0]);
-	float ClusterStartTime = AllResults[0].Time;
+	const TArray<FFootContactResult>* Inputs[] = { &PelvisResults, &VelocityResults, &GroundHeightResults };
+	TArray<FFootContactResult, TMemStackAllocator<>> AllResults;
+	MergeInputs(Inputs, AllResults);
 
-	for (int32 i = 1; i < AllResults.Num(); ++i)
+	bool bFoundContact = false;
+	for (int32 ClusterStart = 0; ClusterStart < AllResults.Num();)
 	{
-		const FFootContactResult& Result = AllResults[i];
+		const int32 ClusterEnd = FindClusterEnd(AllResults, ClusterStart, Config.ResultMergeThreshold);
+		const TConstArrayView<FFootContactResult> Cluster(AllResults.GetData() + ClusterStart, ClusterEnd - ClusterStart);
+		ClusterStart = ClusterEnd;
+
+		uint32 Sources = 0;
+		int32 ContactVotes = 0;
+		for (const FFootContactResult& Result : Cluster)
+		{
+			Sources |= 1u << static_cast<uint32>(Result.Source);
+			ContactVotes += Result.bIsContact ? 1 : 0;
+		}
+
+		if (ContactVotes == 0)
+		{
+			continue;
+		}
+		bFoundContact = true;
+
+		// Settled when at least two detectors agree on a confident contact
+		const bool bAgreed = FMath::CountBits(Sources) >= 2 && ContactVotes == Cluster.Num();
+		if (bAgreed && CalculateClusterResult(Cluster).Confidence > Config.MinimumConfidence)
+		{
+			continue;
+		}
 
-		// Check if this result is close enough to the current cluster
-		if (Result.Time - ClusterStartTime <= MergeThreshold)
+		const TInterval<float> Window(
+			Cluster[0].Time - Config.ResultMergeThreshold,
+			Cluster.Last().Time + Config.ResultMergeThreshold);
+
+		if (OpenWindows.Num() > 0 && Window.Min <= OpenWindows.Last().Max)
 		{
-			CurrentCluster.Add(Result);
+			OpenWindows.Last().Max = Window.Max;
 		}
 		else
 		{
-			// Save current cluster and start new one
-			Clusters.Add(CurrentCluster);
-			CurrentCluster.Empty();
-			CurrentCluster.Add(Result);
-			ClusterStartTime = Result.Time;
+			OpenWindows.Add(Window);
 		}
 	}
 
-	// Don't forget the last cluster
-	if (CurrentCluster.Num() > 0)
+	// Nothing to confirm, Saliency decides the whole foot
+	if (!bFoundContact)
+	{
+		OpenWindows.Reset();
+		OpenWindows.Emplace(TNumericLimits<float>::Lowest(), TNumericLimits<float>::Max());
+	}
+
+	return OpenWindows;
+}
+
+int32 FCompositeDetector::FindClusterEnd(
+	TConstArrayView<FFootContactResult> SortedResults,
+	int32 ClusterStart,
+	float MergeThreshold)
+{
+	// Results within MergeThreshold of the first result of the cluster join it
+	const float ClusterStartTime = SortedResults[ClusterStart].Time;
+
+	int32 ClusterEnd = ClusterStart + 1;
+	while (ClusterEnd < SortedResults.Num() && SortedResults[ClusterEnd].Time - ClusterStartTime <= MergeThreshold)
 	{
-		Clusters.Add(CurrentCluster);
+		++ClusterEnd;
 	}
 
-	return Clusters;
+	return ClusterEnd;
 }
 
 FFootContactResult FCompositeDetector::CalculateClusterResult(
-	const TArray<FFootContactResult>& Cluster)
+	TConstArrayView<FFootContactResult> Cluster)
 {
 	if (Cluster.Num() == 0)
 	{
@@ -203,8 +343,7 @@ FFootContactResult FCompositeDetector::CalculateClusterResult(
 
 	// Confidence is higher when multiple detectors agree
 	// Base confidence + bonus for agreement
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-	float AgreementBonus = (Cluster.Num() - 1) * Settings->DetectorAgreementBonus;
+	float AgreementBonus = (Cluster.Num() - 1) * Config.DetectorAgreementBonus;
 	MergedResult.Confidence = FMath::Clamp(MaxConfidence + AgreementBonus, 0.0f, 1.0f);
 
 	// Majority vote for contact/lift-off
@@ -221,28 +360,20 @@ float FCompositeDetector::GetWeightForMethod(EFootContactDetectionMethod Method)
 	switch (Method)
 	{
 	case EFootContactDetectionMethod::PelvisCrossing:
-		return PelvisCrossingWeight;
+		return Config.CompositeWeights.PelvisCrossingWeight;
 	case EFootContactDetectionMethod::VelocityCurve:
-		return VelocityCurveWeight;
+		return Config.CompositeWeights.VelocityCurveWeight;
 	case EFootContactDetectionMethod::Saliency:
-		return SaliencyWeight;
+		return Config.CompositeWeights.SaliencyWeight;
+	case EFootContactDetectionMethod::GroundHeight:
+		return Config.CompositeWeights.GroundHeightWeight;
 	default:
 		return 1.0f;
 	}
 }
 
-void FCompositeDetector::SetVelocityThreshold(float Threshold)
-{
-	if (VelocityDetector)
-	{
-		VelocityDetector->SetVelocityThreshold(Threshold);
-	}
-}
-
-void FCompositeDetector::SetSaliencyThreshold(float Threshold)
+void FCompositeDetector::AddClipStats(FFootSyncClipStats& OutStats) const
 {
-	if (SaliencyDetector)
-	{
-		SaliencyDetector->SetSaliencyThreshold(Threshold);
-	}
+	OutStats.NumTieredFeet += NumTieredFeet.load();
+	OutStats.NumSaliencySkips += NumSaliencySkips.load();
 }
@@ -0,0 +1,423 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/FootSyncAnalysisExport.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+// ============== Writer ==============
+
+FFootSyncAnalysisWriter::FFootSyncAnalysisWriter() = default;
+
+FFootSyncAnalysisWriter::~FFootSyncAnalysisWriter()
+{
+	if (IsOpen())
+	{
+		Close();
+	}
+}
+
+bool FFootSyncAnalysisWriter::Open(const FString& InFilename)
+{
+	Archive.Reset(IFileManager::Get().CreateFileWriter(*InFilename));
+	if (!Archive)
+	{
+		UE_LOG(LogAnimation, Error, TEXT("FootSyncAnalysisWriter: Failed to create %s"), *InFilename);
+		return false;
+	}
+
+	Filename = InFilename;
+	Clips.Reset();
+	Feet.Reset();
+	Strings.Reset();
+
+	// Patched with the table offsets on close
+	FFootSyncAnalysisHeader Header;
+	Archive->Serialize(&Header, sizeof(Header));
+
+	return true;
+}
+
+void FFootSyncAnalysisWriter::AddClip(
+	const FString& Name,
+	const FFootSyncSamplingContext& Context,
+	EFootContactDetectionMethod DetectionMethod,
+	bool bGaitSolver,
+	const TMap<FName, TArray<FFootContactResult>>& Results)
+{
+	if (!IsOpen() || !Context.IsValid())
+	{
+		return;
+	}
+
+	const int32 NumFrames = Context.GetNumFrames();
+
+	FFootSyncAnalysisClipRecord& Clip = Clips.AddDefaulted_GetRef();
+	AddString(Name, Clip.NameOffset, Clip.NameLength);
+	AddString(Context.PelvisBoneName.ToString(), Clip.PelvisNameOffset, Clip.PelvisNameLength);
+	Clip.NumFrames = NumFrames;
+	Clip.FirstFoot = Feet.Num();
+	Clip.NumFeet = Context.Feet.Num();
+	Clip.DetectionMethod = static_cast<uint8>(DetectionMethod);
+
+	EFootSyncAnalysisClipFlags Flags = EFootSyncAnalysisClipFlags::None;
+	if (Context.bCyclic)
+	{
+		EnumAddFlags(Flags, EFootSyncAnalysisClipFlags::Cyclic);
+	}
+	if (bGaitSolver)
+	{
+		EnumAddFlags(Flags, EFootSyncAnalysisClipFlags::GaitSolver);
+	}
+	Clip.Flags = static_cast<uint8>(Flags);
+
+	Clip.TimesOffset = WriteColumn(Context.Times.GetData(), Context.Times.NumBytes());
+	Clip.PelvisOffset = WriteStream(Context.Pelvis);
+
+	// Signals that were not computed for this frame count are left out
+	auto WriteSignal = [this, NumFrames](const TArray<float>& Signal)
+	{
+		return Signal.Num() == NumFrames ? WriteColumn(Signal.GetData(), Signal.NumBytes()) : 0;
+	};
+
+	TArray<FFootSyncAnalysisResult> PackedResults;
+	for (const FFootTrajectory& Trajectory : Context.Feet)
+	{
+		FFootSyncAnalysisFootRecord& Foot = Feet.AddDefaulted_GetRef();
+		AddString(Trajectory.BoneName.ToString(), Foot.BoneNameOffset, Foot.BoneNameLength);
+
+		Foot.PositionOffset = WriteStream(Trajectory.Position);
+		Foot.PelvisRelativeOffset = WriteStream(Trajectory.PelvisRelative);
+		Foot.SpeedOffset = WriteSignal(Trajectory.Speed);
+		Foot.CurvatureOffset = WriteSignal(Trajectory.Curvature);
+		Foot.PelvisProjectionOffset = WriteSignal(Trajectory.PelvisProjection);
+
+		PackedResults.Reset();
+		if (const TArray<FFootContactResult>* FootResults = Results.Find(Trajectory.BoneName))
+		{
+			for (const FFootContactResult& Result : *FootResults)
+			{
+				FFootSyncAnalysisResult& Packed = PackedResults.AddDefaulted_GetRef();
+				Packed.Time = Result.Time;
+				Packed.Confidence = Result.Confidence;
+				Packed.bIsContact = Result.bIsContact ? 1 : 0;
+				Packed.Source = static_cast<uint8>(Result.Source);
+			}
+		}
+
+		Foot.NumResults = PackedResults.Num();
+		Foot.ResultsOffset = WriteColumn(PackedResults.GetData(), PackedResults.NumBytes());
+	}
+}
+
+bool FFootSyncAnalysisWriter::Close()
+{
+	if (!IsOpen())
+	{
+		return false;
+	}
+
+	FFootSyncAnalysisHeader Header;
+	Header.NumClips = Clips.Num();
+	Header.NumFeet = Feet.Num();
+
+	PadToAlignment();
+	Header.ClipTableOffset = Archive->Tell();
+	Archive->Serialize(Clips.GetData(), Clips.NumBytes());
+
+	PadToAlignment();
+	Header.FootTableOffset = Archive->Tell();
+	Archive->Serialize(Feet.GetData(), Feet.NumBytes());
+
+	PadToAlignment();
+	Header.StringTableOffset = Archive->Tell();
+	Header.StringTableSize = Strings.Num();
+	Archive->Serialize(Strings.GetData(), Strings.NumBytes());
+
+	Archive->Seek(0);
+	Archive->Serialize(&Header, sizeof(Header));
+
+	const bool bSucceeded = !Archive->IsError() && Archive->Close();
+	Archive.Reset();
+
+	if (bSucceeded)
+	{
+		UE_LOG(LogAnimation, Log,
+			TEXT("FootSyncAnalysisWriter: Wrote %d clips (%d feet) to %s"),
+			Header.NumClips, Header.NumFeet, *Filename);
+	}
+	else
+	{
+		UE_LOG(LogAnimation, Error, TEXT("FootSyncAnalysisWriter: Failed to write %s"), *Filename);
+	}
+
+	return bSucceeded;
+}
+
+uint64 FFootSyncAnalysisWriter::WriteColumn(const void* ColumnData, int64 NumBytes)
+{
+	if (NumBytes <= 0)
+	{
+		return 0;
+	}
+
+	PadToAlignment();
+	const uint64 Offset = Archive->Tell();
+	Archive->Serialize(const_cast<void*>(ColumnData), NumBytes);
+	return Offset;
+}
+
+uint64 FFootSyncAnalysisWriter::WriteStream(const FTrajectoryStream& Stream)
+{
+	const uint64 Offset = WriteColumn(Stream.X.GetData(), Stream.X.NumBytes());
+	Archive->Serialize(const_cast<float*>(Stream.Y.GetData()), Stream.Y.NumBytes());
+	Archive->Serialize(const_cast<float*>(Stream.Z.GetData()), Stream.Z.NumBytes());
+	return Offset;
+}
+
+void FFootSyncAnalysisWriter::AddString(const FString& String, uint64& OutOffset, uint32& OutLength)
+{
+	const FTCHARToUTF8 Converted(*String);
+	OutOffset = Strings.Num();
+	OutLength = Converted.Length();
+	Strings.Append(reinterpret_cast<const UTF8CHAR*>(Converted.Get()), Converted.Length());
+}
+
+void FFootSyncAnalysisWriter::PadToAlignment()
+{
+	static const uint8 Zeros[FootSyncAnalysis::Alignment] = {};
+
+	const int64 Position = Archive->Tell();
+	const int64 Padding = ::Align(Position, static_cast<int64>(FootSyncAnalysis::Alignment)) - Position;
+	if (Padding > 0)
+	{
+		Archive->Serialize(const_cast<uint8*>(Zeros), Padding);
+	}
+}
+
+// ============== Memory-Mapped File ==============
+
+FFootSyncAnalysisFile::FFootSyncAnalysisFile() = default;
+
+FFootSyncAnalysisFile::~FFootSyncAnalysisFile()
+{
+	Close();
+}
+
+bool FFootSyncAnalysisFile::Open(const FString& Filename)
+{
+	Close();
+
+	FOpenMappedResult MappedResult = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Filename);
+	if (MappedResult.HasError())
+	{
+		UE_LOG(LogAnimation, Error, TEXT("FootSyncAnalysisFile: Failed to map %s"), *Filename);
+		return false;
+	}
+
+	Handle = MappedResult.StealValue();
+	Size = Handle->GetFileSize();
+	if (Size < sizeof(FFootSyncAnalysisHeader))
+	{
+		UE_LOG(LogAnimation, Error, TEXT("FootSyncAnalysisFile: %s is too small"), *Filename);
+		Close();
+		return false;
+	}
+
+	Region.Reset(Handle->MapRegion(0, Size));
+	if (!Region)
+	{
+		UE_LOG(LogAnimation, Error, TEXT("FootSyncAnalysisFile: Failed to map a view of %s"), *Filename);
+		Close();
+		return false;
+	}
+	Data = Region->GetMappedPtr();
+
+	const FFootSyncAnalysisHeader& Header = *reinterpret_cast<const FFootSyncAnalysisHeader*>(Data);
+	const bool bValidHeader = Header.Magic == FootSyncAnalysis::Magic
+		&& Header.Version == FootSyncAnalysis::Version
+		&& IsInFile(Header.ClipTableOffset, Header.NumClips, sizeof(FFootSyncAnalysisClipRecord))
+		&& IsInFile(Header.FootTableOffset, Header.NumFeet, sizeof(FFootSyncAnalysisFootRecord))
+		&& IsInFile(Header.StringTableOffset, Header.StringTableSize, 1);
+
+	if (!bValidHeader)
+	{
+		UE_LOG(LogAnimation, Error, TEXT("FootSyncAnalysisFile: %s is not a version %u analysis export"),
+			*Filename, FootSyncAnalysis::Version);
+		Close();
+		return false;
+	}
+
+	Clips = GetColumn<FFootSyncAnalysisClipRecord>(Header.ClipTableOffset, Header.NumClips);
+	Feet = GetColumn<FFootSyncAnalysisFootRecord>(Header.FootTableOffset, Header.NumFeet);
+	StringTableOffset = Header.StringTableOffset;
+	StringTableSize = Header.StringTableSize;
+
+	// Validate every column once, views are unchecked afterwards
+	auto IsInStrings = [this](uint64 Offset, uint32 Length)
+	{
+		return Offset <= StringTableSize && Length <= StringTableSize - Offset;
+	};
+
+	for (const FFootSyncAnalysisClipRecord& Clip : Clips)
+	{
+		const uint64 NumFrames = Clip.NumFrames;
+		bool bValid = IsInStrings(Clip.NameOffset, Clip.NameLength)
+			&& IsInStrings(Clip.PelvisNameOffset, Clip.PelvisNameLength)
+			&& static_cast<uint64>(Clip.FirstFoot) + Clip.NumFeet <= Header.NumFeet
+			&& IsInFile(Clip.TimesOffset, NumFrames, sizeof(double))
+			&& IsInFile(Clip.PelvisOffset, 3 * NumFrames, sizeof(float));
+
+		for (uint32 FootIndex = 0; bValid && FootIndex < Clip.NumFeet; ++FootIndex)
+		{
+			const FFootSyncAnalysisFootRecord& Foot = Feet[Clip.FirstFoot + FootIndex];
+			bValid = IsInStrings(Foot.BoneNameOffset, Foot.BoneNameLength)
+				&& IsInFile(Foot.PositionOffset, 3 * NumFrames, sizeof(float))
+				&& IsInFile(Foot.PelvisRelativeOffset, 3 * NumFrames, sizeof(float))
+				&& IsOptionalInFile(Foot.SpeedOffset, NumFrames, sizeof(float))
+				&& IsOptionalInFile(Foot.CurvatureOffset, NumFrames, sizeof(float))
+				&& IsOptionalInFile(Foot.PelvisProjectionOffset, NumFrames, sizeof(float))
+				&& IsInFile(Foot.ResultsOffset, Foot.NumResults, sizeof(FFootSyncAnalysisResult));
+		}
+
+		if (!bValid)
+		{
+			UE_LOG(LogAnimation, Error, TEXT("FootSyncAnalysisFile: %s is truncated or corrupt"), *Filename);
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FFootSyncAnalysisFile::Close()
+{
+	Clips = TConstArrayView<FFootSyncAnalysisClipRecord>();
+	Feet = TConstArrayView<FFootSyncAnalysisFootRecord>();
+	StringTableOffset = 0;
+	StringTableSize = 0;
+	Data = nullptr;
+	Size = 0;
+
+	// The region must be released before its file
+	Region.Reset();
+	Handle.Reset();
+}
+
+FFootSyncAnalysisClipView FFootSyncAnalysisFile::GetClip(int32 ClipIndex) const
+{
+	const FFootSyncAnalysisClipRecord& Clip = Clips[ClipIndex];
+	const TConstArrayView<float> Pelvis = GetColumn<float>(Clip.PelvisOffset, 3 * Clip.NumFrames);
+
+	FFootSyncAnalysisClipView View;
+	View.Name = GetString(Clip.NameOffset, Clip.NameLength);
+	View.PelvisBoneName = GetString(Clip.PelvisNameOffset, Clip.PelvisNameLength);
+	View.DetectionMethod = static_cast<EFootContactDetectionMethod>(Clip.DetectionMethod);
+	View.Flags = static_cast<EFootSyncAnalysisClipFlags>(Clip.Flags);
+	View.Times = GetColumn<double>(Clip.TimesOffset, Clip.NumFrames);
+	if (Pelvis.Num() > 0)
+	{
+		View.PelvisX = Pelvis.Slice(0, Clip.NumFrames);
+		View.PelvisY = Pelvis.Slice(Clip.NumFrames, Clip.NumFrames);
+		View.PelvisZ = Pelvis.Slice(2 * Clip.NumFrames, Clip.NumFrames);
+	}
+	View.NumFeet = Clip.NumFeet;
+	return View;
+}
+
+FFootSyncAnalysisFootView FFootSyncAnalysisFile::GetFoot(int32 ClipIndex, int32 FootIndex) const
+{
+	const FFootSyncAnalysisClipRecord& Clip = Clips[ClipIndex];
+	check(FootIndex >= 0 && static_cast<uint32>(FootIndex) < Clip.NumFeet);
+
+	const FFootSyncAnalysisFootRecord& Foot = Feet[Clip.FirstFoot + FootIndex];
+	const int32 NumFrames = Clip.NumFrames;
+	const TConstArrayView<float> Position = GetColumn<float>(Foot.PositionOffset, 3 * NumFrames);
+	const TConstArrayView<float> PelvisRelative = GetColumn<float>(Foot.PelvisRelativeOffset, 3 * NumFrames);
+
+	FFootSyncAnalysisFootView View;
+	View.BoneName = GetString(Foot.BoneNameOffset, Foot.BoneNameLength);
+	if (Position.Num() > 0)
+	{
+		View.PositionX = Position.Slice(0, NumFrames);
+		View.PositionY = Position.Slice(NumFrames, NumFrames);
+		View.PositionZ = Position.Slice(2 * NumFrames, NumFrames);
+	}
+	if (PelvisRelative.Num() > 0)
+	{
+		View.PelvisRelativeX = PelvisRelative.Slice(0, NumFrames);
+		View.PelvisRelativeY = PelvisRelative.Slice(NumFrames, NumFrames);
+		View.PelvisRelativeZ = PelvisRelative.Slice(2 * NumFrames, NumFrames);
+	}
+	View.Speed = GetColumn<float>(Foot.SpeedOffset, NumFrames);
+	View.Curvature = GetColumn<float>(Foot.CurvatureOffset, NumFrames);
+	View.PelvisProjection = GetColumn<float>(Foot.PelvisProjectionOffset, NumFrames);
+	View.Results = GetColumn<FFootSyncAnalysisResult>(Foot.ResultsOffset, Foot.NumResults);
+	return View;
+}
+
+bool FFootSyncAnalysisFile::MakeSamplingContext(int32 ClipIndex, FFootSyncSamplingContext& OutContext) const
+{
+	const FFootSyncAnalysisClipView Clip = GetClip(ClipIndex);
+	if (Clip.Times.Num() == 0 || Clip.PelvisX.Num() == 0)
+	{
+		return false;
+	}
+
+	auto CopyColumn = [](TConstArrayView<float> Column, TArray<float>& OutValues)
+	{
+		OutValues.Reset(Column.Num());
+		OutValues.Append(Column.GetData(), Column.Num());
+	};
+
+	auto CopyStream = [&CopyColumn](TConstArrayView<float> X, TConstArrayView<float> Y, TConstArrayView<float> Z, FTrajectoryStream& OutStream)
+	{
+		CopyColumn(X, OutStream.X);
+		CopyColumn(Y, OutStream.Y);
+		CopyColumn(Z, OutStream.Z);
+	};
+
+	OutContext = FFootSyncSamplingContext();
+	OutContext.Times.Append(Clip.Times.GetData(), Clip.Times.Num());
+	OutContext.PelvisBoneName = FName(FString(Clip.PelvisBoneName));
+	CopyStream(Clip.PelvisX, Clip.PelvisY, Clip.PelvisZ, OutContext.Pelvis);
+	OutContext.NumEvaluatedFrames = Clip.Times.Num();
+	OutContext.bCyclic = EnumHasAnyFlags(Clip.Flags, EFootSyncAnalysisClipFlags::Cyclic);
+
+	OutContext.Feet.Reserve(Clip.NumFeet);
+	for (int32 FootIndex = 0; FootIndex < Clip.NumFeet; ++FootIndex)
+	{
+		const FFootSyncAnalysisFootView Foot = GetFoot(ClipIndex, FootIndex);
+
+		FFootTrajectory& Trajectory = OutContext.Feet.AddDefaulted_GetRef();
+		Trajectory.BoneName = FName(FString(Foot.BoneName));
+		CopyStream(Foot.PositionX, Foot.PositionY, Foot.PositionZ, Trajectory.Position);
+		CopyStream(Foot.PelvisRelativeX, Foot.PelvisRelativeY, Foot.PelvisRelativeZ, Trajectory.PelvisRelative);
+		CopyColumn(Foot.Speed, Trajectory.Speed);
+		CopyColumn(Foot.Curvature, Trajectory.Curvature);
+		CopyColumn(Foot.PelvisProjection, Trajectory.PelvisProjection);
+	}
+
+	return true;
+}
+
+bool FFootSyncAnalysisFile::IsInFile(uint64 Offset, uint64 Count, uint64 ElementSize) const
+{
+	if (Count == 0)
+	{
+		return true;
+	}
+
+	// Offset 0 is the header, so a table or column with elements can never start there
+	return Offset != 0
+		&& Offset % FootSyncAnalysis::Alignment == 0
+		&& Offset <= Size
+		&& Count <= (Size - Offset) / ElementSize;
+}
+
+FUtf8StringView FFootSyncAnalysisFile::GetString(uint64 Offset, uint32 Length) const
+{
+	return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Data + StringTableOffset + Offset), Length);
+}
@@ -0,0 +1,72 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/FootSyncDetectionConfig.h"
+#include "FootSyncMarkerSettings.h"
+
+FFootSyncDetectionConfig FFootSyncDetectionConfig::FromSettings(const UFootSyncMarkerSettings& Settings)
+{
+	FFootSyncDetectionConfig Config;
+
+	Config.DetectionMethod = Settings.DetectionMethod;
+	Config.CustomDetector = Settings.CustomDetector;
+	Config.CompositeWeights = Settings.CompositeWeights;
+	Config.bTieredComposite = Settings.bTieredComposite;
+
+	Config.CrossingThreshold = Settings.CrossingThreshold;
+	Config.PelvisConfidenceScale = Settings.PelvisConfidenceScale;
+	Config.LoopBoundaryConfidence = Settings.LoopBoundaryConfidence;
+
+	Config.VelocityThreshold = Settings.VelocityMinimumThreshold;
+	Config.VelocityDefaultConfidence = Settings.VelocityDefaultConfidence;
+
+	Config.SaliencyWindowSize = Settings.SaliencyWindowSize;
+	Config.SaliencyThreshold = Settings.SaliencyThreshold;
+	Config.SaliencyDefaultConfidence = Settings.SaliencyDefaultConfidence;
+	Config.SaliencyMinConfidence = Settings.SaliencyMinConfidence;
+
+	Config.GroundPercentile = Settings.GroundPercentile;
+	Config.GroundWindowSize = Settings.GroundWindowSize;
+	Config.GroundContactHeight = Settings.GroundContactHeight;
+	Config.GroundVerticalSpeedThreshold = Settings.GroundVerticalSpeedThreshold;
+	Config.GroundHeightMinConfidence = Settings.GroundHeightMinConfidence;
+
+	Config.ResultMergeThreshold = Settings.ResultMergeThreshold;
+	Config.DetectorAgreementBonus = Settings.DetectorAgreementBonus;
+
+	Config.MinimumConfidence = Settings.MinimumConfidence;
+	Config.MaxMarkersPerFoot = Settings.MaxMarkersPerFoot;
+	Config.bGuaranteeMinimumOne = Settings.bGuaranteeMinimumOne;
+	Config.MinimumMarkerInterval = Settings.MinimumMarkerInterval;
+
+	Config.bUseQuadrupedGaitSolver = Settings.bUseQuadrupedGaitSolver;
+	Config.GaitSearchWindow = Settings.GaitSearchWindow;
+	Config.GaitMinimumHitRatio = Settings.GaitMinimumHitRatio;
+
+	if (Settings.bCoarseToFineSampling)
+	{
+		Config.Sampling.CoarseStride = Settings.CoarseSamplingStride;
+		Config.Sampling.CoarseMinFrames = Settings.CoarseSamplingMinFrames;
+		Config.Sampling.RefinementRadius = Settings.CoarseRefinementRadius;
+	}
+	Config.Sampling.CycleMode = Settings.CycleMode;
+	Config.Sampling.CyclicPoseTolerance = Settings.CyclicPoseTolerance;
+	Config.Sampling.Smoothing.Filter = Settings.SmoothingFilter;
+	Config.Sampling.Smoothing.HalfWindow = Settings.SmoothingHalfWindow;
+	Config.Sampling.Smoothing.CutoffFrequency = Settings.SmoothingCutoffFrequency;
+	if (Settings.bStreamLongTakes)
+	{
+		Config.StreamingMinFrames = Settings.StreamingMinFrames;
+		Config.StreamingChunkFrames = Settings.StreamingChunkFrames;
+	}
+
+	Config.bUseDerivedDataCache = Settings.bUseDerivedDataCache;
+	Config.bUseGpuTrajectoryAnalysis = Settings.bUseGpuTrajectoryAnalysis;
+
+	return Config;
+}
+
+FFootSyncDetectionConfig FFootSyncDetectionConfig::FromProjectSettings()
+{
+	check(IsInGameThread());
+	return FromSettings(*UFootSyncMarkerSettings::Get());
+}
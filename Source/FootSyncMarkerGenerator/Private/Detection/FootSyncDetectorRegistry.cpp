@@ -0,0 +1,136 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/FootSyncDetectorRegistry.h"
+#include "Detection/PelvisCrossingDetector.h"
+#include "Detection/VelocityCurveDetector.h"
+#include "Detection/SaliencyDetector.h"
+#include "Detection/CompositeDetector.h"
+#include "Detection/GroundHeightDetector.h"
+
+FFootSyncDetectorRegistry& FFootSyncDetectorRegistry::Get()
+{
+	static FFootSyncDetectorRegistry Registry;
+	return Registry;
+}
+
+template <typename DetectorType>
+void FFootSyncDetectorRegistry::RegisterBuiltIn(EFootContactDetectionMethod Method, EFootSyncTrajectorySignals Signals)
+{
+	FFootSyncDetectorRegistration Registration;
+	Registration.Name = GetMethodName(Method);
+	Registration.Signals = Signals;
+	Registration.Factory = [](const FFootSyncDetectionConfig& Config) -> TUniquePtr<IFootContactDetector>
+	{
+		return MakeUnique<DetectorType>(Config);
+	};
+
+	BuiltInRegistrations.Add(Registration.Name, Registration);
+	Registrations.Add(Registration.Name, MoveTemp(Registration));
+}
+
+FFootSyncDetectorRegistry::FFootSyncDetectorRegistry()
+{
+	RegisterBuiltIn<FPelvisCrossingDetector>(EFootContactDetectionMethod::PelvisCrossing,
+		EFootSyncTrajectorySignals::PelvisProjection);
+	RegisterBuiltIn<FVelocityCurveDetector>(EFootContactDetectionMethod::VelocityCurve,
+		EFootSyncTrajectorySignals::Speed);
+	RegisterBuiltIn<FSaliencyDetector>(EFootContactDetectionMethod::Saliency,
+		EFootSyncTrajectorySignals::Curvature);
+	RegisterBuiltIn<FCompositeDetector>(EFootContactDetectionMethod::Composite,
+		EFootSyncTrajectorySignals::All);
+	RegisterBuiltIn<FGroundHeightDetector>(EFootContactDetectionMethod::GroundHeight,
+		EFootSyncTrajectorySignals::None);
+}
+
+FName FFootSyncDetectorRegistry::GetMethodName(EFootContactDetectionMethod Method)
+{
+	switch (Method)
+	{
+	case EFootContactDetectionMethod::PelvisCrossing:	return TEXT("PelvisCrossing");
+	case EFootContactDetectionMethod::VelocityCurve:	return TEXT("VelocityCurve");
+	case EFootContactDetectionMethod::Saliency:			return TEXT("Saliency");
+	case EFootContactDetectionMethod::GroundHeight:		return TEXT("GroundHeight");
+	default:											return TEXT("Composite");
+	}
+}
+
+void FFootSyncDetectorRegistry::Register(const FFootSyncDetectorRegistration& Registration)
+{
+	if (Registration.Name.IsNone() || !Registration.Factory)
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncDetectorRegistry: Ignoring detector registration without a name or factory"));
+		return;
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	Registrations.Add(Registration.Name, Registration);
+}
+
+void FFootSyncDetectorRegistry::Unregister(FName Name)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	if (const FFootSyncDetectorRegistration* BuiltIn = BuiltInRegistrations.Find(Name))
+	{
+		Registrations.Add(Name, *BuiltIn);
+	}
+	else
+	{
+		Registrations.Remove(Name);
+	}
+}
+
+bool FFootSyncDetectorRegistry::Find(FName Name, FFootSyncDetectorRegistration& OutRegistration) const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	if (const FFootSyncDetectorRegistration* Registration = Registrations.Find(Name))
+	{
+		OutRegistration = *Registration;
+		return true;
+	}
+
+	return false;
+}
+
+FFootSyncDetectorRegistration FFootSyncDetectorRegistry::Resolve(const FFootSyncDetectionConfig& Config) const
+{
+	const FName Name = Config.CustomDetector.IsNone() ? GetMethodName(Config.DetectionMethod) : Config.CustomDetector;
+
+	FFootSyncDetectorRegistration Registration;
+	if (!Find(Name, Registration))
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncDetectorRegistry: Unknown detector %s, using Composite"),
+			*Name.ToString());
+		Find(GetMethodName(EFootContactDetectionMethod::Composite), Registration);
+	}
+
+	// The tiered composite computes curvature only for the feet that need Saliency
+	if (Config.bTieredComposite && Config.CustomDetector.IsNone()
+		&& Registration.Name == GetMethodName(EFootContactDetectionMethod::Composite))
+	{
+		EnumRemoveFlags(Registration.Signals, EFootSyncTrajectorySignals::Curvature);
+	}
+
+	return Registration;
+}
+
+TUniquePtr<IFootContactDetector> FFootSyncDetectorRegistry::CreateDetector(const FFootSyncDetectionConfig& Config) const
+{
+	const FFootSyncDetectorRegistration Registration = Resolve(Config);
+	return Registration.Factory ? Registration.Factory(Config) : nullptr;
+}
+
+TArray<FName> FFootSyncDetectorRegistry::GetDetectorNames() const
+{
+	TArray<FName> Names;
+	{
+		FReadScopeLock ReadLock(Lock);
+		Registrations.GetKeys(Names);
+	}
+
+	Names.Sort(FNameLexicalLess());
+	return Names;
+}
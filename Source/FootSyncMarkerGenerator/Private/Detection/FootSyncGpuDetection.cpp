@@ -0,0 +1,284 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/FootSyncGpuDetection.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "Detection/PelvisCrossingDetector.h"
+#include "Detection/VelocityCurveDetector.h"
+#include "Detection/SaliencyDetector.h"
+#include "Detection/CompositeDetector.h"
+#include "FootSyncStats.h"
+
+/** Velocity minima as contact results, same rules as FVelocityCurveDetector */
+static TArray<FFootContactResult> MakeVelocityResults(
+	const FFootSyncComputeTrajectoryResult& Analysis,
+	const FFootSyncSamplingContext& Context,
+	const FFootSyncDetectionConfig& Config)
+{
+	TArray<FFootContactResult> Results;
+	if (Context.GetNumFrames() < 3)
+	{
+		return Results;
+	}
+
+	const FVelocityCurveDetector Detector(Config);
+	for (const FFootSyncComputeCandidate& Candidate : Analysis.Candidates)
+	{
+		if (Candidate.Kind == EFootSyncComputeCandidateKind::VelocityMinimum)
+		{
+			Results.Add(Detector.MakeMinimumResult(Context.Times[Candidate.Frame], Candidate.Value, Analysis.MaxSpeed));
+		}
+	}
+
+	return Results;
+}
+
+/** Salient points as contact results, same rules as FSaliencyDetector */
+static TArray<FFootContactResult> MakeSaliencyResults(
+	const FFootSyncComputeTrajectoryResult& Analysis,
+	const FFootSyncSamplingContext& Context,
+	const FFootTrajectory& Trajectory,
+	const FFootSyncDetectionConfig& Config)
+{
+	TArray<FFootContactResult> Results;
+	if (Context.GetNumFrames() < 4)
+	{
+		return Results;
+	}
+
+	const FSaliencyDetector Detector(Config);
+	const TArray<double>& Times = Context.Times;
+
+	// Candidates are in frame order, keep only those at least a window apart
+	int32 LastAccepted = INDEX_NONE;
+	for (const FFootSyncComputeCandidate& Candidate : Analysis.Candidates)
+	{
+		if (Candidate.Kind != EFootSyncComputeCandidateKind::SaliencyPeak)
+		{
+			continue;
+		}
+
+		const bool bTooClose = LastAccepted != INDEX_NONE &&
+			static_cast<float>(Times[Candidate.Frame] - Times[LastAccepted]) < Config.SaliencyWindowSize;
+
+		if (!bTooClose)
+		{
+			LastAccepted = Candidate.Frame;
+			Results.Add(Detector.MakeSalientResult(
+				Trajectory.Position, Times, Candidate.Frame, Candidate.Value, Analysis.MaxCurvature));
+		}
+	}
+
+	return Results;
+}
+
+/** Pelvis line crossings as contact results, same rules as FPelvisCrossingDetector */
+static TArray<FFootContactResult> MakePelvisResults(
+	const FFootSyncComputeTrajectoryResult& Analysis,
+	const FFootSyncSamplingContext& Context,
+	const FFootTrajectory& Trajectory,
+	const FFootSyncDetectionConfig& Config)
+{
+	TArray<FFootContactResult> Results;
+	if (Context.GetNumFrames() < 2)
+	{
+		return Results;
+	}
+
+	const FPelvisCrossingDetector Detector(Config);
+	const TArray<double>& Times = Context.Times;
+
+	for (const FFootSyncComputeCandidate& Candidate : Analysis.Candidates)
+	{
+		if (Candidate.Kind == EFootSyncComputeCandidateKind::PelvisCrossing)
+		{
+			Results.Add(Detector.MakeCrossingResult(
+				Times[Candidate.Frame - 1], Candidate.PrevValue, Times[Candidate.Frame], Candidate.Value));
+		}
+	}
+
+	// The loop boundary only needs the first and last frame
+	const TArray<float>& Projected = Analysis.bMoveAxisY ? Trajectory.PelvisRelative.Y : Trajectory.PelvisRelative.X;
+	const float FirstPos = Projected[0];
+	const float LastPos = Projected.Last();
+	if (FirstPos * LastPos < 0.0f)
+	{
+		Results.Add(Detector.MakeLoopBoundaryResult(Times.Last(), FirstPos, LastPos));
+	}
+
+	return Results;
+}
+
+bool FFootSyncGpuDetection::IsAvailable()
+{
+	return FFootSyncComputeBackend::IsAvailable();
+}
+
+FFootSyncComputeParams FFootSyncGpuDetection::MakeParams(const FFootSyncDetectionConfig& Config)
+{
+	FFootSyncComputeParams Params;
+	Params.VelocityThreshold = Config.VelocityThreshold;
+	Params.SaliencyThreshold = Config.SaliencyThreshold;
+
+	switch (Config.DetectionMethod)
+	{
+	case EFootContactDetectionMethod::PelvisCrossing:
+		Params.bVelocityMinima = false;
+		Params.bSaliencyPeaks = false;
+		break;
+
+	case EFootContactDetectionMethod::VelocityCurve:
+		Params.bSaliencyPeaks = false;
+		Params.bPelvisCrossings = false;
+		break;
+
+	case EFootContactDetectionMethod::Saliency:
+		Params.bVelocityMinima = false;
+		Params.bPelvisCrossings = false;
+		break;
+
+	default:
+		Params.bPelvisCrossings = Config.CompositeWeights.PelvisCrossingWeight > KINDA_SMALL_NUMBER;
+		Params.bVelocityMinima = Config.CompositeWeights.VelocityCurveWeight > KINDA_SMALL_NUMBER;
+		Params.bSaliencyPeaks = Config.CompositeWeights.SaliencyWeight > KINDA_SMALL_NUMBER;
+		break;
+	}
+
+	return Params;
+}
+
+bool FFootSyncGpuDetection::Analyze(
+	TConstArrayView<const FFootSyncSamplingContext*> Contexts,
+	const FFootSyncDetectionConfig& Config,
+	TArray<FFootSyncGpuSignals>& OutSignals)
+{
+	FOOTSYNC_SCOPE(GpuTrajectoryAnalysis);
+
+	OutSignals.Reset();
+	OutSignals.SetNum(Contexts.Num());
+
+	// One trajectory per foot of every valid context
+	TArray<FFootSyncComputeTrajectory> Trajectories;
+	for (const FFootSyncSamplingContext* Context : Contexts)
+	{
+		if (!Context || !Context->IsValid())
+		{
+			continue;
+		}
+
+		for (const FFootTrajectory& Foot : Context->Feet)
+		{
+			FFootSyncComputeTrajectory& Trajectory = Trajectories.AddDefaulted_GetRef();
+			Trajectory.Times = Context->Times;
+			Trajectory.PositionX = Foot.Position.X;
+			Trajectory.PositionY = Foot.Position.Y;
+			Trajectory.PositionZ = Foot.Position.Z;
+			Trajectory.PelvisRelativeX = Foot.PelvisRelative.X;
+			Trajectory.PelvisRelativeY = Foot.PelvisRelative.Y;
+		}
+	}
+
+	if (Trajectories.Num() == 0)
+	{
+		return true;
+	}
+
+	TArray<FFootSyncComputeTrajectoryResult> Results;
+	if (!FFootSyncComputeBackend::AnalyzeTrajectories(Trajectories, MakeParams(Config), Results))
+	{
+		return false;
+	}
+
+	int32 ResultIndex = 0;
+	for (int32 ContextIndex = 0; ContextIndex < Contexts.Num(); ++ContextIndex)
+	{
+		const FFootSyncSamplingContext* Context = Contexts[ContextIndex];
+		if (!Context || !Context->IsValid())
+		{
+			continue;
+		}
+
+		for (int32 FootIndex = 0; FootIndex < Context->Feet.Num(); ++FootIndex)
+		{
+			OutSignals[ContextIndex].Feet.Add(MoveTemp(Results[ResultIndex++]));
+		}
+	}
+
+	UE_LOG(LogAnimation, Log,
+		TEXT("FootSyncGpuDetection: Analyzed %d trajectories of %d sequences on the GPU"),
+		Trajectories.Num(), Contexts.Num());
+
+	return true;
+}
+
+bool FFootSyncGpuDetection::DetectContacts(
+	const FFootSyncGpuSignals& Signals,
+	const FFootSyncSamplingContext& Context,
+	const FSyncFootDefinition& Foot,
+	const FLocomotionPreset& Preset,
+	const FFootSyncDetectionConfig& Config,
+	TArray<FFootContactResult>& OutResults)
+{
+	OutResults.Reset();
+
+	const int32 FootIndex = Context.Feet.IndexOfByPredicate([&Foot](const FFootTrajectory& Trajectory)
+	{
+		return Trajectory.BoneName == Foot.BoneName;
+	});
+
+	if (!Signals.Feet.IsValidIndex(FootIndex) || !Context.IsValid())
+	{
+		return false;
+	}
+
+	const FFootSyncComputeTrajectoryResult& Analysis = Signals.Feet[FootIndex];
+	const FFootTrajectory& Trajectory = Context.Feet[FootIndex];
+
+	switch (Config.DetectionMethod)
+	{
+	case EFootContactDetectionMethod::PelvisCrossing:
+		if (!Preset.PelvisBoneName.IsNone())
+		{
+			OutResults = MakePelvisResults(Analysis, Context, Trajectory, Config);
+		}
+		break;
+
+	case EFootContactDetectionMethod::VelocityCurve:
+		OutResults = MakeVelocityResults(Analysis, Context, Config);
+		break;
+
+	case EFootContactDetectionMethod::Saliency:
+		OutResults = MakeSaliencyResults(Analysis, Context, Trajectory, Config);
+		break;
+
+	case EFootContactDetectionMethod::GroundHeight:
+		// No GPU counterpart, detected on the CPU
+		return false;
+
+	default:
+	{
+		// Composite: same weighting gates as FCompositeDetector, merged by its clustering
+		TArray<FFootContactResult> PelvisResults;
+		TArray<FFootContactResult> VelocityResults;
+		TArray<FFootContactResult> SaliencyResults;
+
+		if (Config.CompositeWeights.PelvisCrossingWeight > KINDA_SMALL_NUMBER && !Preset.PelvisBoneName.IsNone())
+		{
+			PelvisResults = MakePelvisResults(Analysis, Context, Trajectory, Config);
+		}
+		if (Config.CompositeWeights.VelocityCurveWeight > KINDA_SMALL_NUMBER)
+		{
+			VelocityResults = MakeVelocityResults(Analysis, Context, Config);
+		}
+		if (Config.CompositeWeights.SaliencyWeight > KINDA_SMALL_NUMBER)
+		{
+			SaliencyResults = MakeSaliencyResults(Analysis, Context, Trajectory, Config);
+		}
+
+		FCompositeDetector Merger(Config);
+		OutResults = Merger.MergeResults(PelvisResults, VelocityResults, SaliencyResults, TArray<FFootContactResult>());
+		break;
+	}
+	}
+
+	return true;
+}
@@ -0,0 +1,705 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/FootSyncSamplingContext.h"
+#include "Detection/TrajectoryKernels.h"
+#include "FootSyncStats.h"
+#include "AnimationBlueprintLibrary.h"
+#include "AnimPose.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/AnimData/IAnimationDataModel.h"
+#include "Animation/Skeleton.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarFootSyncForcePoseEvaluation(
+	TEXT("FootSync.ForcePoseEvaluation"),
+	false,
+	TEXT("Always evaluate full poses instead of reading key-aligned bone tracks (for validation)."));
+
+bool FFootSyncSamplingContext::Initialize(
+	const UAnimSequence* InAnimSequence,
+	const FLocomotionPreset& Preset,
+	const FFootSyncSamplingOptions& Options)
+{
+	int32 NumKeys = 0;
+	if (InAnimSequence)
+	{
+		UAnimationBlueprintLibrary::GetNumKeys(InAnimSequence, NumKeys);
+	}
+
+	if (!SetupFrames(InAnimSequence, Preset, 0, NumKeys))
+	{
+		return false;
+	}
+
+	// Reading keys is cheap enough that interpolating part of them would only lose accuracy
+	const int32 Stride = FMath::Max(1, Options.CoarseStride);
+	const bool bCoarseToFine = !bReadBoneTracks && Stride > 1 && NumKeys >= FMath::Max(Options.CoarseMinFrames, 2 * Stride);
+
+	if (!bCoarseToFine)
+	{
+		TArray<int32> AllFrames;
+		AllFrames.SetNumUninitialized(NumKeys);
+		for (int32 Frame = 0; Frame < NumKeys; ++Frame)
+		{
+			AllFrames[Frame] = Frame;
+		}
+
+		if (!EvaluateFrames(AllFrames))
+		{
+			return false;
+		}
+
+		ResolveCycle(Options);
+		SmoothTrajectories(Options.Smoothing);
+		return true;
+	}
+
+	// Coarse pass: every Stride-th key plus the last one
+	TArray<int32> CoarseFrames;
+	CoarseFrames.Reserve(NumKeys / Stride + 2);
+	for (int32 Frame = 0; Frame < NumKeys; Frame += Stride)
+	{
+		CoarseFrames.Add(Frame);
+	}
+	if (CoarseFrames.Last() != NumKeys - 1)
+	{
+		CoarseFrames.Add(NumKeys - 1);
+	}
+
+	if (!EvaluateFrames(CoarseFrames))
+	{
+		return false;
+	}
+
+	// The first and last keys are part of the coarse pass
+	ResolveCycle(Options);
+
+	TBitArray<> Evaluated(false, NumKeys);
+	for (int32 Frame : CoarseFrames)
+	{
+		Evaluated[Frame] = true;
+	}
+
+	// Fine pass: full rate around candidate contacts only
+	TBitArray<> Refine(false, NumKeys);
+	FindRefinementFrames(CoarseFrames, Options.RefinementRadius, Refine);
+
+	TArray<int32> FineFrames;
+	for (TConstSetBitIterator<> It(Refine); It; ++It)
+	{
+		if (!Evaluated[It.GetIndex()])
+		{
+			FineFrames.Add(It.GetIndex());
+			Evaluated[It.GetIndex()] = true;
+		}
+	}
+
+	if (!EvaluateFrames(FineFrames))
+	{
+		return false;
+	}
+
+	InterpolateFrames(Evaluated);
+	SmoothTrajectories(Options.Smoothing);
+
+	UE_LOG(LogAnimation, Verbose,
+		TEXT("FootSyncSamplingContext: %s evaluated %d of %d frames (stride %d)"),
+		*AnimSequence->GetName(), NumEvaluatedFrames, NumKeys, Stride);
+
+	return true;
+}
+
+bool FFootSyncSamplingContext::InitializeFrameRange(
+	const UAnimSequence* InAnimSequence,
+	const FLocomotionPreset& Preset,
+	int32 FirstFrame,
+	int32 NumFrames)
+{
+	if (!SetupFrames(InAnimSequence, Preset, FirstFrame, NumFrames))
+	{
+		return false;
+	}
+
+	TArray<int32> Frames;
+	Frames.SetNumUninitialized(NumFrames);
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Frames[Frame] = Frame;
+	}
+
+	return EvaluateFrames(Frames);
+}
+
+bool FFootSyncSamplingContext::SetupFrames(
+	const UAnimSequence* InAnimSequence,
+	const FLocomotionPreset& Preset,
+	int32 FirstFrame,
+	int32 NumFrames)
+{
+	AnimSequence = InAnimSequence;
+	Times.Reset();
+	PelvisBoneName = Preset.PelvisBoneName;
+	Pelvis.Reset();
+	Feet.Reset();
+	NumEvaluatedFrames = 0;
+	bCyclic = false;
+	FirstKey = FirstFrame;
+	bReadBoneTracks = false;
+
+	if (!AnimSequence || PelvisBoneName.IsNone() || FirstFrame < 0 || NumFrames <= 0)
+	{
+		return false;
+	}
+
+	// Build time intervals for batch evaluation
+	Times.SetNumUninitialized(NumFrames);
+	const FFrameRate FrameRate = AnimSequence->GetSamplingFrameRate();
+	if (FrameRate.IsValid())
+	{
+		// Uniform sampling: key times follow directly from the frame rate
+		const double PlayLength = AnimSequence->GetPlayLength();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Times[Frame] = FMath::Clamp(FrameRate.AsSeconds(FFrameTime(FirstFrame + Frame)), 0.0, PlayLength);
+		}
+	}
+	else
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			float Time;
+			UAnimationBlueprintLibrary::GetTimeAtFrame(AnimSequence, FirstFrame + Frame, Time);
+			Times[Frame] = static_cast<double>(Time);
+		}
+	}
+
+	// Allocate trajectory buffers for the bones of the preset only
+	Pelvis.SetNum(NumFrames);
+	for (const FSyncFootDefinition& Foot : Preset.Feet)
+	{
+		if (Foot.BoneName.IsNone() || FindFoot(Foot.BoneName))
+		{
+			continue;
+		}
+
+		FFootTrajectory& Trajectory = Feet.AddDefaulted_GetRef();
+		Trajectory.BoneName = Foot.BoneName;
+		Trajectory.Position.SetNum(NumFrames);
+		Trajectory.PelvisRelative.SetNum(NumFrames);
+	}
+
+	if (!BuildBoneChains())
+	{
+		Times.Reset();
+		Pelvis.Reset();
+		Feet.Reset();
+		return false;
+	}
+
+	bReadBoneTracks = CanReadBoneTracks();
+	return true;
+}
+
+bool FFootSyncSamplingContext::CanReadBoneTracks() const
+{
+	if (CVarFootSyncForcePoseEvaluation.GetValueOnAnyThread())
+	{
+		return false;
+	}
+
+	const IAnimationDataModel* DataModel = AnimSequence->GetDataModel();
+	if (!DataModel || AnimSequence->IsValidAdditive() || AnimSequence->bForceRootLock)
+	{
+		return false;
+	}
+
+	// A retarget source changes the reference the translations are retargeted against
+	if (!AnimSequence->RetargetSource.IsNone() || !AnimSequence->RetargetSourceAsset.IsNull())
+	{
+		return false;
+	}
+
+	// Sample times follow the frame rate, so they are keys as long as the range stays within the track
+	const FFrameRate FrameRate = AnimSequence->GetSamplingFrameRate();
+	return FrameRate.IsValid()
+		&& FrameRate == DataModel->GetFrameRate()
+		&& FirstKey + Times.Num() <= DataModel->GetNumberOfKeys();
+}
+
+bool FFootSyncSamplingContext::BuildBoneChains()
+{
+	ChainBoneNames.Reset();
+	ChainParentIndices.Reset();
+	FootChainIndices.Reset();
+	PelvisChainIndex = INDEX_NONE;
+
+	const USkeleton* Skeleton = AnimSequence->GetSkeleton();
+	if (!Skeleton)
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncSamplingContext: %s has no skeleton"),
+			*AnimSequence->GetName());
+		return false;
+	}
+
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	const int32 NumBones = RefSkeleton.GetNum();
+
+	TArray<int32> BoneIndices;
+	BoneIndices.Reserve(Feet.Num() + 1);
+	BoneIndices.Add(RefSkeleton.FindBoneIndex(PelvisBoneName));
+	for (const FFootTrajectory& Trajectory : Feet)
+	{
+		BoneIndices.Add(RefSkeleton.FindBoneIndex(Trajectory.BoneName));
+	}
+
+	// Mark every ancestor once; shared chain segments are only composed once per frame
+	TBitArray<> InChain(false, NumBones);
+	for (int32 Index = 0; Index < BoneIndices.Num(); ++Index)
+	{
+		if (BoneIndices[Index] == INDEX_NONE)
+		{
+			UE_LOG(LogAnimation, Warning,
+				TEXT("FootSyncSamplingContext: Bone %s not found in the skeleton of %s"),
+				*(Index == 0 ? PelvisBoneName : Feet[Index - 1].BoneName).ToString(), *AnimSequence->GetName());
+			return false;
+		}
+
+		for (int32 BoneIndex = BoneIndices[Index]; BoneIndex != INDEX_NONE && !InChain[BoneIndex];
+			BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+		{
+			InChain[BoneIndex] = true;
+		}
+	}
+
+	// Reference skeleton bones are ordered parents before children
+	TArray<int32> ChainIndexOfBone;
+	ChainIndexOfBone.Init(INDEX_NONE, NumBones);
+	ChainRefTransforms.Reset();
+	ChainRefTranslations.Reset();
+	for (TConstSetBitIterator<> It(InChain); It; ++It)
+	{
+		const int32 BoneIndex = It.GetIndex();
+		const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+
+		ChainIndexOfBone[BoneIndex] = ChainBoneNames.Num();
+		ChainBoneNames.Add(RefSkeleton.GetBoneName(BoneIndex));
+		ChainParentIndices.Add(ParentIndex != INDEX_NONE ? ChainIndexOfBone[ParentIndex] : INDEX_NONE);
+		ChainRefTransforms.Add(RefSkeleton.GetRefBonePose()[BoneIndex]);
+		ChainRefTranslations.Add(
+			Skeleton->GetBoneTranslationRetargetingMode(BoneIndex) == EBoneTranslationRetargetingMode::Skeleton);
+	}
+
+	PelvisChainIndex = ChainIndexOfBone[BoneIndices[0]];
+	FootChainIndices.Reserve(Feet.Num());
+	for (int32 Index = 1; Index < BoneIndices.Num(); ++Index)
+	{
+		FootChainIndices.Add(ChainIndexOfBone[BoneIndices[Index]]);
+	}
+
+	return true;
+}
+
+bool FFootSyncSamplingContext::EvaluateFrames(TConstArrayView<int32> Frames)
+{
+	FOOTSYNC_SCOPE(SamplePoses);
+
+	if (bReadBoneTracks)
+	{
+		ReadBoneTracks(Frames);
+		return true;
+	}
+
+	FAnimPoseEvaluationOptions Options;
+	Options.EvaluationType = EAnimDataEvalType::Source;
+	Options.bEvaluateCurves = false;
+
+	// Evaluate poses in bounded chunks and keep only the required bone positions
+	TArray<double> ChunkTimes;
+	TArray<FAnimPose> ChunkPoses;
+	TArray<FTransform> ChainTransforms;
+	ChainTransforms.SetNum(ChainBoneNames.Num());
+	for (int32 ChunkStart = 0; ChunkStart < Frames.Num(); ChunkStart += PoseChunkSize)
+	{
+		const int32 ChunkNum = FMath::Min(PoseChunkSize, Frames.Num() - ChunkStart);
+		ChunkTimes.Reset();
+		for (int32 i = 0; i < ChunkNum; ++i)
+		{
+			ChunkTimes.Add(Times[Frames[ChunkStart + i]]);
+		}
+		ChunkPoses.Reset();
+
+		UAnimPoseExtensions::GetAnimPoseAtTimeIntervals(AnimSequence, ChunkTimes, Options, ChunkPoses);
+
+		if (ChunkPoses.Num() != ChunkNum)
+		{
+			UE_LOG(LogAnimation, Warning,
+				TEXT("FootSyncSamplingContext: Pose count mismatch for %s (%d vs %d)"),
+				*AnimSequence->GetName(), ChunkPoses.Num(), ChunkNum);
+			Times.Reset();
+			Pelvis.Reset();
+			Feet.Reset();
+			return false;
+		}
+
+		for (int32 i = 0; i < ChunkNum; ++i)
+		{
+			const FAnimPose& Pose = ChunkPoses[i];
+			for (int32 ChainIndex = 0; ChainIndex < ChainBoneNames.Num(); ++ChainIndex)
+			{
+				ChainTransforms[ChainIndex] = UAnimPoseExtensions::GetBonePose(
+					Pose, ChainBoneNames[ChainIndex], EAnimPoseSpaces::Local);
+			}
+
+			StoreChainFrame(Frames[ChunkStart + i], ChainTransforms);
+		}
+
+		NumEvaluatedFrames += ChunkNum;
+		INC_DWORD_STAT_BY(STAT_FootSync_PosesEvaluated, ChunkNum);
+	}
+
+	return true;
+}
+
+void FFootSyncSamplingContext::ReadBoneTracks(TConstArrayView<int32> Frames)
+{
+	const IAnimationDataModel* DataModel = AnimSequence->GetDataModel();
+	const int32 NumChainBones = ChainBoneNames.Num();
+
+	// Bones without a track keep their reference pose
+	TBitArray<> HasTrack(false, NumChainBones);
+	for (int32 ChainIndex = 0; ChainIndex < NumChainBones; ++ChainIndex)
+	{
+		HasTrack[ChainIndex] = DataModel->IsValidBoneTrackName(ChainBoneNames[ChainIndex]);
+	}
+
+	// Read the keys of each chain bone in bounded chunks
+	TArray<FFrameNumber> ChunkKeys;
+	TArray<TArray<FTransform>> TrackTransforms;
+	TrackTransforms.SetNum(NumChainBones);
+	TArray<FTransform> ChainTransforms;
+	ChainTransforms.SetNum(NumChainBones);
+	for (int32 ChunkStart = 0; ChunkStart < Frames.Num(); ChunkStart += PoseChunkSize)
+	{
+		const int32 ChunkNum = FMath::Min(PoseChunkSize, Frames.Num() - ChunkStart);
+		ChunkKeys.Reset();
+		for (int32 i = 0; i < ChunkNum; ++i)
+		{
+			ChunkKeys.Add(FFrameNumber(FirstKey + Frames[ChunkStart + i]));
+		}
+
+		for (int32 ChainIndex = 0; ChainIndex < NumChainBones; ++ChainIndex)
+		{
+			if (HasTrack[ChainIndex])
+			{
+				TrackTransforms[ChainIndex].Reset();
+				DataModel->GetBoneTrackTransforms(ChainBoneNames[ChainIndex], ChunkKeys, TrackTransforms[ChainIndex]);
+			}
+		}
+
+		for (int32 i = 0; i < ChunkNum; ++i)
+		{
+			for (int32 ChainIndex = 0; ChainIndex < NumChainBones; ++ChainIndex)
+			{
+				const FTransform& RefTransform = ChainRefTransforms[ChainIndex];
+				FTransform& LocalTransform = ChainTransforms[ChainIndex];
+
+				LocalTransform = HasTrack[ChainIndex] ? TrackTransforms[ChainIndex][i] : RefTransform;
+				if (ChainRefTranslations[ChainIndex])
+				{
+					LocalTransform.SetTranslation(RefTransform.GetTranslation());
+				}
+			}
+
+			StoreChainFrame(Frames[ChunkStart + i], ChainTransforms);
+		}
+
+		NumEvaluatedFrames += ChunkNum;
+		INC_DWORD_STAT_BY(STAT_FootSync_TrackFramesRead, ChunkNum);
+	}
+}
+
+void FFootSyncSamplingContext::StoreChainFrame(int32 Frame, TArray<FTransform>& ChainTransforms)
+{
+	// Compose component space along the chains only, parents are always composed first
+	for (int32 ChainIndex = 0; ChainIndex < ChainTransforms.Num(); ++ChainIndex)
+	{
+		const int32 ParentIndex = ChainParentIndices[ChainIndex];
+		if (ParentIndex != INDEX_NONE)
+		{
+			ChainTransforms[ChainIndex] = ChainTransforms[ChainIndex] * ChainTransforms[ParentIndex];
+		}
+	}
+
+	const FTransform& PelvisTransform = ChainTransforms[PelvisChainIndex];
+	Pelvis.SetPosition(Frame, PelvisTransform.GetLocation());
+
+	for (int32 FootIndex = 0; FootIndex < Feet.Num(); ++FootIndex)
+	{
+		FFootTrajectory& Trajectory = Feet[FootIndex];
+		const FVector FootLocation = ChainTransforms[FootChainIndices[FootIndex]].GetLocation();
+
+		Trajectory.Position.SetPosition(Frame, FootLocation);
+		Trajectory.PelvisRelative.SetPosition(Frame, PelvisTransform.InverseTransformPosition(FootLocation));
+	}
+}
+
+void FFootSyncSamplingContext::ResolveCycle(const FFootSyncSamplingOptions& Options)
+{
+	bCyclic = false;
+
+	const int32 NumKeys = Times.Num();
+	if (NumKeys < 3 || Options.CycleMode == EFootSyncCycleMode::Open)
+	{
+		return;
+	}
+
+	if (Options.CycleMode == EFootSyncCycleMode::Cyclic)
+	{
+		bCyclic = true;
+		return;
+	}
+
+	// Root motion moves the whole pose, so compare the feet relative to the pelvis
+	const float Tolerance = Options.CyclicPoseTolerance;
+	if (FMath::Abs(Pelvis.Z[NumKeys - 1] - Pelvis.Z[0]) > Tolerance)
+	{
+		return;
+	}
+
+	for (const FFootTrajectory& Trajectory : Feet)
+	{
+		const FVector Difference = Trajectory.PelvisRelative.GetPosition(NumKeys - 1) - Trajectory.PelvisRelative.GetPosition(0);
+		if (Difference.SizeSquared() > FMath::Square(Tolerance))
+		{
+			return;
+		}
+	}
+
+	bCyclic = true;
+
+	UE_LOG(LogAnimation, Verbose,
+		TEXT("FootSyncSamplingContext: %s detected as cyclic"),
+		*AnimSequence->GetName());
+}
+
+void FFootSyncSamplingContext::SmoothTrajectories(const FTrajectoryFilterSettings& Smoothing)
+{
+	const int32 NumKeys = Times.Num();
+	if (Smoothing.Filter == EFootSyncSmoothingFilter::None || NumKeys < 3)
+	{
+		return;
+	}
+
+	FOOTSYNC_SCOPE(SmoothTrajectories);
+
+	// Keys are uniformly spaced
+	const double Duration = Times.Last() - Times[0];
+	const double SampleRate = Duration > 0.0 ? (NumKeys - 1) / Duration : 0.0;
+
+	FTrajectoryFilters::Smooth(Pelvis, Smoothing, SampleRate, bCyclic);
+	for (FFootTrajectory& Trajectory : Feet)
+	{
+		FTrajectoryFilters::Smooth(Trajectory.Position, Smoothing, SampleRate, bCyclic);
+		FTrajectoryFilters::Smooth(Trajectory.PelvisRelative, Smoothing, SampleRate, bCyclic);
+	}
+}
+
+void FFootSyncSamplingContext::ComputeSignals(EFootSyncTrajectorySignals Signals)
+{
+	if (!IsValid() || Signals == EFootSyncTrajectorySignals::None)
+	{
+		return;
+	}
+
+	FOOTSYNC_SCOPE(ComputeSignals);
+
+	const int32 NumFrames = GetNumFrames();
+	for (FFootTrajectory& Trajectory : Feet)
+	{
+		const bool bSpeed = EnumHasAnyFlags(Signals, EFootSyncTrajectorySignals::Speed) && Trajectory.Speed.Num() != NumFrames;
+		const bool bCurvature = EnumHasAnyFlags(Signals, EFootSyncTrajectorySignals::Curvature) && Trajectory.Curvature.Num() != NumFrames;
+
+		if (bSpeed)
+		{
+			Trajectory.Speed.SetNumUninitialized(NumFrames);
+		}
+		if (bCurvature)
+		{
+			Trajectory.Curvature.SetNumUninitialized(NumFrames);
+		}
+
+		if (bSpeed && bCurvature)
+		{
+			FTrajectoryKernels::ComputeSpeedAndCurvature(Trajectory.Position, Times, Trajectory.Speed, Trajectory.Curvature, bCyclic);
+		}
+		else if (bSpeed)
+		{
+			FTrajectoryKernels::ComputeSpeed(Trajectory.Position, Times, Trajectory.Speed, bCyclic);
+		}
+		else if (bCurvature)
+		{
+			FTrajectoryKernels::ComputeCurvature(Trajectory.Position, Trajectory.Curvature, bCyclic);
+		}
+
+		if (EnumHasAnyFlags(Signals, EFootSyncTrajectorySignals::PelvisProjection) && Trajectory.PelvisProjection.Num() != NumFrames)
+		{
+			Trajectory.PelvisProjection.SetNumUninitialized(NumFrames);
+			FTrajectoryKernels::ProjectOnAxis(Trajectory.PelvisRelative,
+				FTrajectoryKernels::FindDominantHorizontalAxis(Trajectory.PelvisRelative), Trajectory.PelvisProjection);
+		}
+	}
+}
+
+void FFootSyncSamplingContext::FindRefinementFrames(
+	TConstArrayView<int32> CoarseFrames,
+	int32 Radius,
+	TBitArray<>& OutRefine) const
+{
+	const int32 NumKeys = Times.Num();
+	const int32 NumCoarse = CoarseFrames.Num();
+
+	// Mark the frames between two coarse samples, widened by the radius
+	auto MarkInterval = [&OutRefine, &CoarseFrames, NumKeys, NumCoarse, Radius](int32 FirstCoarse, int32 LastCoarse)
+	{
+		const int32 FirstFrame = FMath::Max(0, CoarseFrames[FMath::Max(0, FirstCoarse)] - Radius);
+		const int32 LastFrame = FMath::Min(NumKeys - 1, CoarseFrames[FMath::Min(NumCoarse - 1, LastCoarse)] + Radius);
+		OutRefine.SetRange(FirstFrame, LastFrame - FirstFrame + 1, true);
+	};
+
+	// Sequence ends of open sequences: loop boundary crossings and one-sided differences.
+	// Cyclic sequences have no ends, their first frame is tested like any other below.
+	if (!bCyclic)
+	{
+		MarkInterval(0, 1);
+		MarkInterval(NumCoarse - 2, NumCoarse - 1);
+	}
+
+	TArray<float> Speeds;
+	Speeds.SetNumUninitialized(NumCoarse);
+
+	for (const FFootTrajectory& Trajectory : Feet)
+	{
+		// Coarse speed, central difference over neighbouring coarse samples
+		for (int32 c = 0; c < NumCoarse; ++c)
+		{
+			const int32 From = CoarseFrames[FMath::Max(0, c - 1)];
+			const int32 To = CoarseFrames[FMath::Min(NumCoarse - 1, c + 1)];
+			const double DeltaTime = Times[To] - Times[From];
+
+			Speeds[c] = DeltaTime > KINDA_SMALL_NUMBER
+				? static_cast<float>((Trajectory.Position.GetPosition(To) - Trajectory.Position.GetPosition(From)).Size() / DeltaTime)
+				: 0.0f;
+		}
+
+		// The first frame of a cycle follows the second to last coarse sample
+		const int32 SeamFrame = CoarseFrames[NumCoarse - 2];
+		if (bCyclic)
+		{
+			const FVector Before = Trajectory.Position.GetCyclicPosition(SeamFrame - (NumKeys - 1));
+			const double DeltaTime = Times[CoarseFrames[1]] - Times[0] + Times[NumKeys - 1] - Times[SeamFrame];
+
+			Speeds[0] = DeltaTime > KINDA_SMALL_NUMBER
+				? static_cast<float>((Trajectory.Position.GetPosition(CoarseFrames[1]) - Before).Size() / DeltaTime)
+				: 0.0f;
+			Speeds[NumCoarse - 1] = Speeds[0];
+		}
+
+		for (int32 c = bCyclic ? 0 : 1; c < NumCoarse - 1; ++c)
+		{
+			const int32 Frame = CoarseFrames[c];
+			const int32 NextFrame = CoarseFrames[c + 1];
+			const float PrevSpeed = c > 0 ? Speeds[c - 1] : Speeds[NumCoarse - 2];
+			const float PrevZ = c > 0
+				? Trajectory.Position.Z[CoarseFrames[c - 1]]
+				: static_cast<float>(Trajectory.Position.GetCyclicPosition(SeamFrame - (NumKeys - 1)).Z);
+
+			// Velocity minima (velocity curve detector)
+			const bool bSpeedMinimum = Speeds[c] <= PrevSpeed && Speeds[c] <= Speeds[c + 1];
+
+			// Height minima (saliency detector)
+			const float Z = Trajectory.Position.Z[Frame];
+			const bool bHeightMinimum = Z <= PrevZ && Z <= Trajectory.Position.Z[NextFrame];
+
+			if (bSpeedMinimum || bHeightMinimum)
+			{
+				if (c > 0)
+				{
+					MarkInterval(c - 1, c + 1);
+				}
+				else
+				{
+					// Both sides of the seam
+					MarkInterval(0, 1);
+					MarkInterval(NumCoarse - 2, NumCoarse - 1);
+				}
+			}
+		}
+
+		// Pelvis line crossings (pelvis crossing detector), along the axis it will project onto
+		const FVector MoveAxis = FTrajectoryKernels::FindDominantHorizontalAxis(Trajectory.PelvisRelative, CoarseFrames);
+		float PrevDistance = static_cast<float>(Trajectory.PelvisRelative.GetPosition(CoarseFrames[0]) | MoveAxis);
+		for (int32 c = 1; c < NumCoarse; ++c)
+		{
+			const float Distance = static_cast<float>(Trajectory.PelvisRelative.GetPosition(CoarseFrames[c]) | MoveAxis);
+			if (PrevDistance * Distance <= 0.0f)
+			{
+				MarkInterval(c - 1, c);
+			}
+			PrevDistance = Distance;
+		}
+	}
+}
+
+void FFootSyncSamplingContext::InterpolateFrames(const TBitArray<>& Evaluated)
+{
+	const int32 NumKeys = Times.Num();
+
+	auto LerpStream = [](FTrajectoryStream& Stream, int32 From, int32 To, int32 Frame, float Alpha)
+	{
+		Stream.X[Frame] = FMath::Lerp(Stream.X[From], Stream.X[To], Alpha);
+		Stream.Y[Frame] = FMath::Lerp(Stream.Y[From], Stream.Y[To], Alpha);
+		Stream.Z[Frame] = FMath::Lerp(Stream.Z[From], Stream.Z[To], Alpha);
+	};
+
+	// First and last frames are always evaluated, so every gap is bounded
+	int32 From = 0;
+	while (From < NumKeys - 1)
+	{
+		int32 To = From + 1;
+		while (!Evaluated[To])
+		{
+			++To;
+		}
+
+		const double Span = Times[To] - Times[From];
+		for (int32 Frame = From + 1; Frame < To; ++Frame)
+		{
+			const float Alpha = Span > 0.0 ? static_cast<float>((Times[Frame] - Times[From]) / Span) : 0.0f;
+
+			LerpStream(Pelvis, From, To, Frame, Alpha);
+			for (FFootTrajectory& Trajectory : Feet)
+			{
+				LerpStream(Trajectory.Position, From, To, Frame, Alpha);
+				LerpStream(Trajectory.PelvisRelative, From, To, Frame, Alpha);
+			}
+		}
+
+		From = To;
+	}
+}
+
+void FFootSyncSamplingContext::Serialize(FArchive& Ar)
+{
+	Ar << Times;
+	Ar << PelvisBoneName;
+	Ar << Pelvis;
+	Ar << Feet;
+	Ar << bCyclic;
+
+	if (Ar.IsLoading())
+	{
+		AnimSequence = nullptr;
+		NumEvaluatedFrames = Times.Num();
+	}
+}
@@ -0,0 +1,124 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/FootSyncTrajectoryFixture.h"
+#include "FootSyncDetectionCache.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static constexpr uint32 TrajectoryFixtureMagic = 0x46535446; // 'FSTF'
+static constexpr int32 TrajectoryFixtureFormatVersion = 3;
+
+const TCHAR* FFootSyncTrajectoryFixture::FileExtension = TEXT(".fsfixture");
+
+TArray<FFootContactResult>& FFootSyncFixtureFootResults::GetResults(EFootContactDetectionMethod Method)
+{
+	switch (Method)
+	{
+	case EFootContactDetectionMethod::PelvisCrossing:
+		return PelvisCrossing;
+	case EFootContactDetectionMethod::VelocityCurve:
+		return VelocityCurve;
+	case EFootContactDetectionMethod::Saliency:
+		return Saliency;
+	case EFootContactDetectionMethod::GroundHeight:
+		return GroundHeight;
+	case EFootContactDetectionMethod::Composite:
+	default:
+		return Composite;
+	}
+}
+
+const TArray<FFootContactResult>& FFootSyncFixtureFootResults::GetResults(EFootContactDetectionMethod Method) const
+{
+	return const_cast<FFootSyncFixtureFootResults*>(this)->GetResults(Method);
+}
+
+bool FFootSyncTrajectoryFixture::SaveToFile(const FString& Filename) const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	const_cast<FFootSyncTrajectoryFixture*>(this)->Serialize(Writer);
+
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool FFootSyncTrajectoryFixture::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	return Serialize(Reader) && !Reader.IsError();
+}
+
+bool FFootSyncTrajectoryFixture::Serialize(FArchive& Ar)
+{
+	uint32 Magic = TrajectoryFixtureMagic;
+	int32 FormatVersion = TrajectoryFixtureFormatVersion;
+	Ar << Magic;
+	Ar << FormatVersion;
+
+	if (Magic != TrajectoryFixtureMagic || FormatVersion != TrajectoryFixtureFormatVersion)
+	{
+		return false;
+	}
+
+	Ar << Name;
+
+	// Presets are stored as exported text so fixtures survive property additions
+	UScriptStruct* PresetStruct = FLocomotionPreset::StaticStruct();
+	FString PresetText;
+	if (Ar.IsSaving())
+	{
+		PresetStruct->ExportText(PresetText, &Preset, nullptr, nullptr, PPF_None, nullptr);
+	}
+	Ar << PresetText;
+	if (Ar.IsLoading())
+	{
+		Preset = FLocomotionPreset();
+		if (!PresetStruct->ImportText(*PresetText, &Preset, nullptr, PPF_None, GLog, PresetStruct->GetName()))
+		{
+			return false;
+		}
+	}
+
+	Context.Serialize(Ar);
+
+	int32 NumFeet = Feet.Num();
+	Ar << NumFeet;
+	if (Ar.IsLoading())
+	{
+		if (NumFeet < 0)
+		{
+			return false;
+		}
+		Feet.SetNum(NumFeet);
+	}
+
+	static const EFootContactDetectionMethod Methods[] =
+	{
+		EFootContactDetectionMethod::PelvisCrossing,
+		EFootContactDetectionMethod::VelocityCurve,
+		EFootContactDetectionMethod::Saliency,
+		EFootContactDetectionMethod::Composite,
+		EFootContactDetectionMethod::GroundHeight
+	};
+
+	for (FFootSyncFixtureFootResults& Foot : Feet)
+	{
+		Ar << Foot.BoneName;
+		for (EFootContactDetectionMethod Method : Methods)
+		{
+			if (!FFootSyncDetectionCache::Serialize(Ar, Foot.GetResults(Method)))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
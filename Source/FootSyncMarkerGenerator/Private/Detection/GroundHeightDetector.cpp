@@ -0,0 +1,444 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/GroundHeightDetector.h"
+#include "FootSyncStats.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "FootSyncContactMath.h"
+#include "Misc/MemStack.h"
+
+namespace
+{
+	/** Finest height resolution of the ground histogram (cm) */
+	constexpr float MinGroundBinSize = 0.1f;
+
+	/** Most bins of the ground histogram, coarser bins beyond this height range */
+	constexpr int32 MaxGroundBins = 4096;
+}
+
+FGroundHeightDetector::FGroundHeightDetector()
+	: Config(FFootSyncDetectionConfig::FromProjectSettings())
+{
+}
+
+FGroundHeightDetector::FGroundHeightDetector(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+{
+}
+
+TArray<FFootContactResult> FGroundHeightDetector::DetectContacts(
+	const FFootSyncSamplingContext& Context,
+	const FSyncFootDefinition& Foot,
+	const FLocomotionPreset& Preset)
+{
+	FOOTSYNC_SCOPE(DetectGroundHeight);
+
+	TArray<FFootContactResult> Results;
+
+	if (!Context.IsValid() || Foot.BoneName.IsNone())
+	{
+		return Results;
+	}
+
+	const int32 NumFrames = Context.GetNumFrames();
+	if (NumFrames < 3)  // Need at least 3 frames for central differences
+	{
+		return Results;
+	}
+
+	const FFootTrajectory* FootTrajectory = Context.FindFoot(Foot.BoneName);
+	if (!FootTrajectory || FootTrajectory->Position.Num() != NumFrames)
+	{
+		return Results;
+	}
+
+	const double Duration = Context.GetCyclePeriod();
+	if (Duration <= UE_DOUBLE_KINDA_SMALL_NUMBER)
+	{
+		return Results;
+	}
+
+	const TConstArrayView<float> Heights = FootTrajectory->Position.Z;
+	const TConstArrayView<double> Times = Context.Times;
+	const int32 LastIndex = NumFrames - 1;
+
+	// Window in frames at the average frame interval
+	const int32 HalfWindow = FMath::Max(1, FMath::RoundToInt32(0.5 * Config.GroundWindowSize * LastIndex / Duration));
+
+	FMemMark Mark(FMemStack::Get());
+
+	TArray<float, TMemStackAllocator<>> Clearances;
+	TArray<float, TMemStackAllocator<>> VerticalSpeeds;
+	Clearances.SetNumUninitialized(NumFrames);
+	VerticalSpeeds.SetNumUninitialized(NumFrames);
+
+	const float ContactHeight = Config.GroundContactHeight;
+	const float LiftOffHeight = 2.0f * ContactHeight;
+	const float SpeedThreshold = Config.GroundVerticalSpeedThreshold;
+
+	CalculateVerticalSpeeds(Heights, Times, Context.bCyclic, VerticalSpeeds);
+
+	// Without a single stance the ground falls back to every frame of the clip
+	TBitArray<> GroundFrames;
+	FindGroundFrames(VerticalSpeeds, SpeedThreshold, Context.bCyclic, GroundFrames);
+
+	CalculateClearances(Heights, HalfWindow, Config.GroundPercentile, Context.bCyclic, GroundFrames, Clearances);
+
+	// Planted feet stay planted until they clear the lift-off height
+	auto IsPlanted = [&Clearances, &VerticalSpeeds, ContactHeight, LiftOffHeight, SpeedThreshold](bool bWasPlanted, int32 Frame)
+	{
+		return bWasPlanted
+			? Clearances[Frame] <= LiftOffHeight
+			: Clearances[Frame] <= ContactHeight && FMath::Abs(VerticalSpeeds[Frame]) <= SpeedThreshold;
+	};
+
+	bool bPlanted = IsPlanted(false, 0);
+
+	// A cycle enters its first frame in the state it left the last one (the same frame),
+	// so run the cycle once without reporting to find the state at the seam
+	if (Context.bCyclic)
+	{
+		for (int32 i = 1; i <= LastIndex; ++i)
+		{
+			bPlanted = IsPlanted(bPlanted, i);
+		}
+	}
+
+	for (int32 i = 1; i <= LastIndex; ++i)
+	{
+		const bool bWasPlanted = bPlanted;
+		bPlanted = IsPlanted(bWasPlanted, i);
+
+		if (bPlanted == bWasPlanted)
+		{
+			continue;
+		}
+
+		if (bPlanted)
+		{
+			// Interpolated where the foot came down through the contact height, otherwise
+			// the foot was already low and this is the frame it came to rest
+			const float Time = Clearances[i - 1] > ContactHeight
+				? FFootSyncContactMath::InterpolateCrossingTime(
+					static_cast<float>(Times[i - 1]), Clearances[i - 1] - ContactHeight,
+					static_cast<float>(Times[i]), Clearances[i] - ContactHeight)
+				: static_cast<float>(Times[i]);
+
+			Results.Add(FFootContactResult(Time, GetConfidence(VerticalSpeeds[i]), true,
+				EFootContactDetectionMethod::GroundHeight));
+		}
+		else
+		{
+			const float Time = FFootSyncContactMath::InterpolateCrossingTime(
+				static_cast<float>(Times[i - 1]), Clearances[i - 1] - LiftOffHeight,
+				static_cast<float>(Times[i]), Clearances[i] - LiftOffHeight);
+
+			Results.Add(FFootContactResult(Time, GetConfidence(VerticalSpeeds[i - 1]), false,
+				EFootContactDetectionMethod::GroundHeight));
+		}
+	}
+
+	return Results;
+}
+
+void FGroundHeightDetector::CalculateClearances(
+	TConstArrayView<float> Heights,
+	int32 HalfWindow,
+	float Percentile,
+	bool bCyclic,
+	const TBitArray<>& GroundFrames,
+	TArrayView<float> OutClearances)
+{
+	const int32 NumFrames = Heights.Num();
+	check(OutClearances.Num() == NumFrames);
+	check(GroundFrames.Num() == 0 || GroundFrames.Num() == NumFrames);
+
+	if (NumFrames < 2)
+	{
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			OutClearances[i] = 0.0f;
+		}
+		return;
+	}
+
+	const int32 LastIndex = NumFrames - 1;
+
+	// The last frame repeats the first one cycle later, offset by the drift over the cycle.
+	// Cyclic windows never hold a frame twice, open windows shrink at the ends.
+	const float CycleOffset = bCyclic ? Heights[LastIndex] - Heights[0] : 0.0f;
+	HalfWindow = FMath::Clamp(HalfWindow, 0, bCyclic ? (LastIndex - 1) / 2 : LastIndex);
+
+	auto GetHeight = [Heights, LastIndex, CycleOffset, bCyclic](int32 Frame)
+	{
+		if (!bCyclic)
+		{
+			return Heights[Frame];
+		}
+
+		const int32 Cycles = FMath::DivideAndRoundDown(Frame, LastIndex);
+		return Heights[Frame - Cycles * LastIndex] + CycleOffset * Cycles;
+	};
+
+	const bool bAllGround = GroundFrames.Num() == 0;
+	auto IsGround = [&GroundFrames, LastIndex, bAllGround, bCyclic](int32 Frame)
+	{
+		if (bAllGround)
+		{
+			return true;
+		}
+
+		return GroundFrames[bCyclic ? Frame - FMath::DivideAndRoundDown(Frame, LastIndex) * LastIndex : Frame];
+	};
+
+	// Windows reach at most one drift beyond the sampled heights
+	float MinHeight = Heights[0];
+	float MaxHeight = Heights[0];
+	for (float Height : Heights)
+	{
+		MinHeight = FMath::Min(MinHeight, Height);
+		MaxHeight = FMath::Max(MaxHeight, Height);
+	}
+	MinHeight -= FMath::Abs(CycleOffset);
+	MaxHeight += FMath::Abs(CycleOffset);
+
+	const float BinSize = FMath::Max(MinGroundBinSize, (MaxHeight - MinHeight) / (MaxGroundBins - 1));
+	const int32 NumBins = FMath::Min(FMath::FloorToInt32((MaxHeight - MinHeight) / BinSize) + 1, MaxGroundBins);
+
+	auto GetBin = [MinHeight, BinSize, NumBins](float Height)
+	{
+		return FMath::Clamp(FMath::FloorToInt32((Height - MinHeight) / BinSize), 0, NumBins - 1);
+	};
+
+	FMemMark Mark(FMemStack::Get());
+
+	TArray<int32, TMemStackAllocator<>> Counts;
+	Counts.SetNumZeroed(NumBins);
+
+	int32 Count = 0;
+	int32 Cursor = 0;	// Bin holding the percentile sample
+	int32 Below = 0;	// Samples in the bins below the cursor
+
+	auto AddSample = [&](int32 Frame)
+	{
+		if (IsGround(Frame))
+		{
+			const int32 Bin = GetBin(GetHeight(Frame));
+			++Counts[Bin];
+			++Count;
+			Below += Bin < Cursor ? 1 : 0;
+		}
+	};
+
+	auto RemoveSample = [&](int32 Frame)
+	{
+		if (IsGround(Frame))
+		{
+			const int32 Bin = GetBin(GetHeight(Frame));
+			--Counts[Bin];
+			--Count;
+			Below -= Bin < Cursor ? 1 : 0;
+		}
+	};
+
+	// Move the cursor to the bin of the percentile rank. One sample enters and one leaves
+	// per frame and both are near the current heights, so the cursor only moves a few bins.
+	auto GetGround = [&]()
+	{
+		const int32 Rank = FMath::Clamp(FMath::FloorToInt32(Percentile * (Count - 1)), 0, Count - 1);
+		while (Below > Rank)
+		{
+			--Cursor;
+			Below -= Counts[Cursor];
+		}
+		while (Below + Counts[Cursor] <= Rank)
+		{
+			Below += Counts[Cursor];
+			++Cursor;
+		}
+		return MinHeight + (Cursor + 0.5f) * BinSize;
+	};
+
+	// A window inside a swing holds no ground, its frames are never planted
+	auto GetClearance = [&](int32 Frame)
+	{
+		return Count > 0 ? Heights[Frame] - GetGround() : TNumericLimits<float>::Max();
+	};
+
+	if (bCyclic)
+	{
+		for (int32 i = -HalfWindow; i <= HalfWindow; ++i)
+		{
+			AddSample(i);
+		}
+
+		for (int32 i = 0; i < LastIndex; ++i)
+		{
+			OutClearances[i] = GetClearance(i);
+			AddSample(i + HalfWindow + 1);
+			RemoveSample(i - HalfWindow);
+		}
+
+		// Same frame as the first, its ground moved by the drift
+		OutClearances[LastIndex] = OutClearances[0];
+	}
+	else
+	{
+		for (int32 i = 0; i <= HalfWindow; ++i)
+		{
+			AddSample(i);
+		}
+
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			OutClearances[i] = GetClearance(i);
+			if (i + HalfWindow + 1 <= LastIndex)
+			{
+				AddSample(i + HalfWindow + 1);
+			}
+			if (i - HalfWindow >= 0)
+			{
+				RemoveSample(i - HalfWindow);
+			}
+		}
+	}
+}
+
+void FGroundHeightDetector::FindGroundFrames(
+	TConstArrayView<float> VerticalSpeeds,
+	float SpeedThreshold,
+	bool bCyclic,
+	TBitArray<>& OutGroundFrames)
+{
+	const int32 NumFrames = VerticalSpeeds.Num();
+	OutGroundFrames.Init(false, NumFrames);
+
+	// Cyclic clips repeat the first frame at the end, so the unique frames wrap around
+	const int32 NumUnique = bCyclic ? NumFrames - 1 : NumFrames;
+	if (NumUnique <= 0)
+	{
+		OutGroundFrames.Reset();
+		return;
+	}
+
+	auto IsStill = [VerticalSpeeds, SpeedThreshold](int32 Frame)
+	{
+		return FMath::Abs(VerticalSpeeds[Frame]) <= SpeedThreshold;
+	};
+
+	// Cyclic scans start on a moving frame so that no run spans the seam
+	int32 Start = 0;
+	if (bCyclic)
+	{
+		while (Start < NumUnique && IsStill(Start))
+		{
+			++Start;
+		}
+
+		if (Start == NumUnique)
+		{
+			OutGroundFrames.Init(true, NumFrames);
+			return;
+		}
+	}
+
+	auto GetFrame = [Start, NumUnique](int32 Step)
+	{
+		return (Start + Step) % NumUnique;
+	};
+
+	bool bFoundGround = false;
+	int32 Step = 0;
+	while (Step < NumUnique)
+	{
+		if (!IsStill(GetFrame(Step)))
+		{
+			++Step;
+			continue;
+		}
+
+		const int32 RunStart = Step;
+		while (Step < NumUnique && IsStill(GetFrame(Step)))
+		{
+			++Step;
+		}
+
+		// Cyclic runs always have a moving frame on both sides, open runs may end the clip
+		const bool bHasBefore = bCyclic || RunStart > 0;
+		const bool bHasAfter = bCyclic || Step < NumUnique;
+		const bool bEnteredDescending = !bHasBefore || VerticalSpeeds[GetFrame(RunStart - 1 + NumUnique)] < 0.0f;
+		const bool bLeftAscending = !bHasAfter || VerticalSpeeds[GetFrame(Step)] > 0.0f;
+
+		if (bEnteredDescending && bLeftAscending)
+		{
+			for (int32 RunStep = RunStart; RunStep < Step; ++RunStep)
+			{
+				OutGroundFrames[GetFrame(RunStep)] = true;
+			}
+			bFoundGround = true;
+		}
+	}
+
+	if (!bFoundGround)
+	{
+		OutGroundFrames.Reset();
+		return;
+	}
+
+	if (bCyclic)
+	{
+		OutGroundFrames[NumFrames - 1] = OutGroundFrames[0];
+	}
+}
+
+void FGroundHeightDetector::CalculateVerticalSpeeds(
+	TConstArrayView<float> Heights,
+	TConstArrayView<double> Times,
+	bool bCyclic,
+	TArrayView<float> OutSpeeds)
+{
+	const int32 NumFrames = Heights.Num();
+	check(Times.Num() == NumFrames && OutSpeeds.Num() == NumFrames);
+
+	auto GetSpeed = [](double FromTime, float From, double ToTime, float To)
+	{
+		const double DeltaTime = ToTime - FromTime;
+		return DeltaTime > UE_DOUBLE_KINDA_SMALL_NUMBER ? static_cast<float>((To - From) / DeltaTime) : 0.0f;
+	};
+
+	if (NumFrames < 2)
+	{
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			OutSpeeds[i] = 0.0f;
+		}
+		return;
+	}
+
+	const int32 LastIndex = NumFrames - 1;
+	for (int32 i = 1; i < LastIndex; ++i)
+	{
+		OutSpeeds[i] = GetSpeed(Times[i - 1], Heights[i - 1], Times[i + 1], Heights[i + 1]);
+	}
+
+	if (bCyclic && NumFrames >= 3)
+	{
+		// The frame before the seam, shifted back one cycle
+		const double Period = Times[LastIndex] - Times[0];
+		const float CycleOffset = Heights[LastIndex] - Heights[0];
+		OutSpeeds[0] = GetSpeed(
+			Times[LastIndex - 1] - Period, Heights[LastIndex - 1] - CycleOffset,
+			Times[1], Heights[1]);
+		OutSpeeds[LastIndex] = OutSpeeds[0];
+	}
+	else
+	{
+		OutSpeeds[0] = GetSpeed(Times[0], Heights[0], Times[1], Heights[1]);
+		OutSpeeds[LastIndex] = GetSpeed(Times[LastIndex - 1], Heights[LastIndex - 1], Times[LastIndex], Heights[LastIndex]);
+	}
+}
+
+float FGroundHeightDetector::GetConfidence(float VerticalSpeed) const
+{
+	const float SpeedThreshold = FMath::Max(Config.GroundVerticalSpeedThreshold, KINDA_SMALL_NUMBER);
+	return FMath::Clamp(1.0f - FMath::Abs(VerticalSpeed) / SpeedThreshold, Config.GroundHeightMinConfidence, 1.0f);
+}
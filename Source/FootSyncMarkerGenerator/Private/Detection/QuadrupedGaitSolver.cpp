@@ -0,0 +1,248 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/QuadrupedGaitSolver.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+
+/** Frames kept on each side of a search window so detectors see real neighbors at its edges */
+static constexpr int32 GaitWindowMargin = 2;
+
+FQuadrupedGaitSolver::FQuadrupedGaitSolver(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+{
+}
+
+bool FQuadrupedGaitSolver::Solve(
+	const FFootSyncSamplingContext& Context,
+	const FLocomotionPreset& Preset,
+	FDetectFootFunc DetectFoot,
+	TMap<FName, TArray<FFootContactResult>>& OutResults) const
+{
+	auto FindFoot = [&Preset](EFootLabel Label) -> const FSyncFootDefinition*
+	{
+		const FSyncFootDefinition* Foot = Preset.Feet.FindByPredicate([Label](const FSyncFootDefinition& Candidate)
+		{
+			return Candidate.FootLabel == Label && !Candidate.BoneName.IsNone();
+		});
+		return Foot;
+	};
+
+	// Reference feet (fore and hind of one side) and the contralateral foot predicted from each
+	const FSyncFootDefinition* ReferenceFeet[2] = { FindFoot(EFootLabel::FrontLeft), FindFoot(EFootLabel::BackLeft) };
+	const FSyncFootDefinition* PredictedFeet[2] = { FindFoot(EFootLabel::FrontRight), FindFoot(EFootLabel::BackRight) };
+
+	for (int32 PairIndex = 0; PairIndex < 2; ++PairIndex)
+	{
+		if (!ReferenceFeet[PairIndex] || !PredictedFeet[PairIndex])
+		{
+			return false;
+		}
+	}
+
+	if (!Context.IsValid())
+	{
+		return false;
+	}
+
+	TArray<FFootContactResult> ReferenceResults[2];
+	TArray<FFootContactResult> PredictedResults[2];
+
+	ParallelFor(2, [&](int32 PairIndex)
+	{
+		ReferenceResults[PairIndex] = DetectFoot(Context, *ReferenceFeet[PairIndex]);
+
+		// Left and right alternate half a cycle apart in walk, trot and pace
+		const float Period = EstimatePeriod(ReferenceResults[PairIndex]);
+		bool bPredicted = false;
+
+		if (Period > 0.0f)
+		{
+			const float StartTime = static_cast<float>(Context.Times[0]);
+			const float EndTime = static_cast<float>(Context.Times.Last());
+			const float HalfPeriod = 0.5f * Period;
+
+			TArray<float> PredictedTimes;
+			for (const FFootContactResult& Result : ReferenceResults[PairIndex])
+			{
+				if (!Result.bIsContact || Result.Confidence < Config.MinimumConfidence)
+				{
+					continue;
+				}
+
+				// Also predict the step before the first reference contact
+				if (PredictedTimes.Num() == 0 && Result.Time - HalfPeriod >= StartTime)
+				{
+					PredictedTimes.Add(Result.Time - HalfPeriod);
+				}
+				if (Result.Time + HalfPeriod <= EndTime)
+				{
+					PredictedTimes.Add(Result.Time + HalfPeriod);
+				}
+			}
+
+			bPredicted = DetectPredicted(Context, *PredictedFeet[PairIndex], PredictedTimes,
+				Config.GaitSearchWindow * Period, DetectFoot, PredictedResults[PairIndex]);
+		}
+
+		if (!bPredicted)
+		{
+			UE_LOG(LogAnimation, Verbose,
+				TEXT("QuadrupedGaitSolver: Gait not confirmed for %s, running full detection"),
+				*PredictedFeet[PairIndex]->BoneName.ToString());
+
+			PredictedResults[PairIndex] = DetectFoot(Context, *PredictedFeet[PairIndex]);
+		}
+	}, EParallelForFlags::Unbalanced);
+
+	OutResults.Reset();
+	for (int32 PairIndex = 0; PairIndex < 2; ++PairIndex)
+	{
+		OutResults.Add(ReferenceFeet[PairIndex]->BoneName, MoveTemp(ReferenceResults[PairIndex]));
+		OutResults.Add(PredictedFeet[PairIndex]->BoneName, MoveTemp(PredictedResults[PairIndex]));
+	}
+
+	return true;
+}
+
+float FQuadrupedGaitSolver::EstimatePeriod(const TArray<FFootContactResult>& Results) const
+{
+	// Confident contacts, with near-duplicates collapsed
+	TArray<float> ContactTimes;
+	for (const FFootContactResult& Result : Results)
+	{
+		if (Result.bIsContact && Result.Confidence >= Config.MinimumConfidence
+			&& (ContactTimes.Num() == 0 || Result.Time - ContactTimes.Last() > Config.MinimumMarkerInterval))
+		{
+			ContactTimes.Add(Result.Time);
+		}
+	}
+
+	if (ContactTimes.Num() < 2)
+	{
+		return 0.0f;
+	}
+
+	TArray<float> Intervals;
+	Intervals.Reserve(ContactTimes.Num() - 1);
+	for (int32 i = 1; i < ContactTimes.Num(); ++i)
+	{
+		Intervals.Add(ContactTimes[i] - ContactTimes[i - 1]);
+	}
+	Intervals.Sort();
+
+	const float Median = Intervals[Intervals.Num() / 2];
+	if (Median <= KINDA_SMALL_NUMBER)
+	{
+		return 0.0f;
+	}
+
+	// Irregular stepping (turns, transitions, gallop) does not follow a fixed phase
+	if ((Intervals.Last() - Median) > MaxPeriodDeviation * Median || (Median - Intervals[0]) > MaxPeriodDeviation * Median)
+	{
+		return 0.0f;
+	}
+
+	return Median;
+}
+
+bool FQuadrupedGaitSolver::DetectPredicted(
+	const FFootSyncSamplingContext& Context,
+	const FSyncFootDefinition& Foot,
+	TConstArrayView<float> PredictedTimes,
+	float WindowRadius,
+	FDetectFootFunc DetectFoot,
+	TArray<FFootContactResult>& OutResults) const
+{
+	OutResults.Reset();
+
+	const FFootTrajectory* Trajectory = Context.FindFoot(Foot.BoneName);
+	if (!Trajectory || PredictedTimes.Num() == 0)
+	{
+		return false;
+	}
+
+	const TArray<double>& Times = Context.Times;
+	const int32 NumFrames = Times.Num();
+
+	// Frame ranges of the search windows, overlapping windows merged
+	TArray<FInt32Interval> Windows;
+	for (float PredictedTime : PredictedTimes)
+	{
+		const int32 First = FMath::Max(0,
+			Algo::LowerBound(Times, static_cast<double>(PredictedTime - WindowRadius)) - GaitWindowMargin);
+		const int32 Last = FMath::Min(NumFrames - 1,
+			Algo::UpperBound(Times, static_cast<double>(PredictedTime + WindowRadius)) + GaitWindowMargin - 1);
+
+		if (Windows.Num() > 0 && First <= Windows.Last().Max + 1)
+		{
+			Windows.Last().Max = FMath::Max(Windows.Last().Max, Last);
+		}
+		else
+		{
+			Windows.Add(FInt32Interval(First, Last));
+		}
+	}
+
+	FFootSyncSamplingContext Slice;
+	TArray<FFootContactResult> WindowResults;
+	for (const FInt32Interval& Window : Windows)
+	{
+		MakeSlice(Context, *Trajectory, Window.Min, Window.Max - Window.Min + 1, Slice);
+		WindowResults = DetectFoot(Slice, Foot);
+
+		// Results at the margins are slice-edge artifacts, unless the slice edge is a sequence edge
+		const double MinTime = Window.Min > 0 ? Times[FMath::Min(Window.Min + GaitWindowMargin, Window.Max)] : Times[0];
+		const double MaxTime = Window.Max < NumFrames - 1 ? Times[FMath::Max(Window.Max - GaitWindowMargin, Window.Min)] : Times.Last();
+
+		for (const FFootContactResult& Result : WindowResults)
+		{
+			if (Result.Time >= MinTime && Result.Time <= MaxTime)
+			{
+				OutResults.Add(Result);
+			}
+		}
+	}
+
+	// Confirm the gait: enough predictions must have a confident contact nearby
+	int32 NumHits = 0;
+	for (float PredictedTime : PredictedTimes)
+	{
+		const bool bHit = OutResults.ContainsByPredicate([this, PredictedTime, WindowRadius](const FFootContactResult& Result)
+		{
+			return Result.bIsContact
+				&& Result.Confidence >= Config.MinimumConfidence
+				&& FMath::Abs(Result.Time - PredictedTime) <= WindowRadius;
+		});
+
+		NumHits += bHit ? 1 : 0;
+	}
+
+	return NumHits >= FMath::CeilToInt(Config.GaitMinimumHitRatio * PredictedTimes.Num());
+}
+
+void FQuadrupedGaitSolver::MakeSlice(
+	const FFootSyncSamplingContext& Context,
+	const FFootTrajectory& Foot,
+	int32 FirstFrame,
+	int32 NumFrames,
+	FFootSyncSamplingContext& OutSlice)
+{
+	auto CopyStream = [FirstFrame, NumFrames](const FTrajectoryStream& Source, FTrajectoryStream& Target)
+	{
+		Target.X = TArray<float>(Source.X.GetData() + FirstFrame, NumFrames);
+		Target.Y = TArray<float>(Source.Y.GetData() + FirstFrame, NumFrames);
+		Target.Z = TArray<float>(Source.Z.GetData() + FirstFrame, NumFrames);
+	};
+
+	OutSlice.AnimSequence = Context.AnimSequence;
+	OutSlice.PelvisBoneName = Context.PelvisBoneName;
+	OutSlice.Times = TArray<double>(Context.Times.GetData() + FirstFrame, NumFrames);
+	OutSlice.NumEvaluatedFrames = NumFrames;
+	CopyStream(Context.Pelvis, OutSlice.Pelvis);
+
+	OutSlice.Feet.SetNum(1);
+	OutSlice.Feet[0].BoneName = Foot.BoneName;
+	CopyStream(Foot.Position, OutSlice.Feet[0].Position);
+	CopyStream(Foot.PelvisRelative, OutSlice.Feet[0].PelvisRelative);
+}
@@ -1,85 +1,70 @@
 // Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
 
 #include "Detection/SaliencyDetector.h"
-#include "FootSyncMarkerSettings.h"
-#include "AnimPose.h"
-#include "AnimationBlueprintLibrary.h"
-#include "Animation/AnimSequence.h"
+#include "FootSyncStats.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "Detection/TrajectoryKernels.h"
+
+FSaliencyDetector::FSaliencyDetector()
+	: Config(FFootSyncDetectionConfig::FromProjectSettings())
+{
+}
+
+FSaliencyDetector::FSaliencyDetector(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+{
+}
 
 TArray<FFootContactResult> FSaliencyDetector::DetectContacts(
-	UAnimSequence* AnimSequence,
+	const FFootSyncSamplingContext& Context,
 	const FSyncFootDefinition& Foot,
 	const FLocomotionPreset& Preset)
 {
+	FOOTSYNC_SCOPE(DetectSaliency);
+
 	TArray<FFootContactResult> Results;
 
-	if (!AnimSequence || Foot.BoneName.IsNone())
+	if (!Context.IsValid() || Foot.BoneName.IsNone())
 	{
 		return Results;
 	}
 
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-
-	// Get animation info
-	float SequenceLength;
-	UAnimationBlueprintLibrary::GetSequenceLength(AnimSequence, SequenceLength);
-
-	int32 NumKeys;
-	UAnimationBlueprintLibrary::GetNumKeys(AnimSequence, NumKeys);
-
-	if (NumKeys < 4)  // Need at least 4 frames for curvature analysis
+	if (Context.GetNumFrames() < 4)  // Need at least 4 frames for curvature analysis
 	{
 		return Results;
 	}
 
-	// Build time intervals
-	TArray<float> Times;
-	TArray<double> TimeIntervals;
-	for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
-	{
-		float Time;
-		UAnimationBlueprintLibrary::GetTimeAtFrame(AnimSequence, KeyIndex, Time);
-		Times.Add(Time);
-		TimeIntervals.Add(static_cast<double>(Time));
-	}
-
-	// Evaluate all poses
-	TArray<FAnimPose> Poses;
-	FAnimPoseEvaluationOptions Options;
-	Options.EvaluationType = EAnimDataEvalType::Source;
-
-	UAnimPoseExtensions::GetAnimPoseAtTimeIntervals(AnimSequence, TimeIntervals, Options, Poses);
+	const TArray<double>& Times = Context.Times;
 
-	if (Poses.Num() != Times.Num())
+	const FFootTrajectory* FootTrajectory = Context.FindFoot(Foot.BoneName);
+	if (!FootTrajectory)
 	{
-		UE_LOG(LogAnimation, Warning,
-			TEXT("SaliencyDetector: Pose count mismatch"));
 		return Results;
 	}
 
-	// Get foot positions in world space
-	TArray<FVector> Positions;
-	for (const FAnimPose& Pose : Poses)
+	// Foot positions in animation space
+	const FTrajectoryStream& Positions = FootTrajectory->Position;
+
+	// Curvature shared through the context, calculated here when it was not requested
+	TArray<float> LocalCurvatures;
+	TConstArrayView<float> Curvatures = FootTrajectory->Curvature;
+	if (Curvatures.Num() != Context.GetNumFrames())
 	{
-		FTransform FootTransform = UAnimPoseExtensions::GetBonePose(
-			Pose, Foot.BoneName, EAnimPoseSpaces::World);
-		Positions.Add(FootTransform.GetLocation());
+		LocalCurvatures = CalculateCurvature(Positions, Context.bCyclic);
+		Curvatures = LocalCurvatures;
 	}
 
-	// Calculate curvature at each point
-	TArray<float> Curvatures = CalculateCurvature(Positions, Times);
-
 	if (Curvatures.Num() < 3)
 	{
 		return Results;
 	}
 
 	// Find salient points
-	const float Threshold = bHasThresholdOverride ? SaliencyThresholdOverride : Settings->SaliencyThreshold;
 	TArray<int32> SalientIndices = FindSalientPoints(
 		Curvatures, Times,
-		Settings->SaliencyWindowSize,
-		Threshold);
+		Config.SaliencyWindowSize,
+		Config.SaliencyThreshold,
+		Context.bCyclic);
 
 	// Calculate max curvature for confidence scaling
 	float MaxCurvature = 0.0f;
@@ -93,31 +78,38 @@ TArray<FFootContactResult> FSaliencyDetector::DetectContacts(
 	{
 		if (Index >= 0 && Index < Times.Num() && Index < Curvatures.Num())
 		{
-			float Curvature = Curvatures[Index];
-
-			// Confidence based on curvature prominence
-			float Confidence = MaxCurvature > KINDA_SMALL_NUMBER
-				? FMath::Clamp(Curvature / MaxCurvature, Settings->SaliencyMinConfidence, 1.0f)
-				: Settings->SaliencyDefaultConfidence;
-
-			// Determine if this is a contact or lift-off
-			bool bIsContact = IsFootContact(Positions, Index);
-
-			Results.Add(FFootContactResult(
-				Times[Index],
-				Confidence,
-				bIsContact,
-				EFootContactDetectionMethod::Saliency
-			));
+			Results.Add(MakeSalientResult(Positions, Times, Index, Curvatures[Index], MaxCurvature, Context.bCyclic));
 		}
 	}
 
 	return Results;
 }
 
-TArray<float> FSaliencyDetector::CalculateCurvature(
-	const TArray<FVector>& Positions,
-	const TArray<float>& Times)
+FFootContactResult FSaliencyDetector::MakeSalientResult(
+	const FTrajectoryStream& Positions,
+	TConstArrayView<double> Times,
+	int32 Index,
+	float Curvature,
+	float MaxCurvature,
+	bool bCyclic) const
+{
+	// Confidence based on curvature prominence
+	const float Confidence = MaxCurvature > KINDA_SMALL_NUMBER
+		? FMath::Clamp(Curvature / MaxCurvature, Config.SaliencyMinConfidence, 1.0f)
+		: Config.SaliencyDefaultConfidence;
+
+	// Determine if this is a contact or lift-off
+	const bool bIsContact = IsFootContact(Positions, Index, bCyclic);
+
+	return FFootContactResult(
+		static_cast<float>(Times[Index]),
+		Confidence,
+		bIsContact,
+		EFootContactDetectionMethod::Saliency
+	);
+}
+
+TArray<float> FSaliencyDetector::CalculateCurvature(const FTrajectoryStream& Positions, bool bCyclic)
 {
 	TArray<float> Curvatures;
 
@@ -126,60 +118,18 @@ TArray<float> FSaliencyDetector::CalculateCurvature(
 		return Curvatures;
 	}
 
-	// First point has no curvature (need neighbors)
-	Curvatures.Add(0.0f);
-
-	// Calculate curvature for interior points
-	for (int32 i = 1; i < Positions.Num() - 1; ++i)
-	{
-		float Curvature = CalculatePointCurvature(
-			Positions[i - 1], Positions[i], Positions[i + 1]);
-		Curvatures.Add(Curvature);
-	}
-
-	// Last point has no curvature
-	Curvatures.Add(0.0f);
+	Curvatures.SetNumUninitialized(Positions.Num());
+	FTrajectoryKernels::ComputeCurvature(Positions, Curvatures, bCyclic);
 
 	return Curvatures;
 }
 
-float FSaliencyDetector::CalculatePointCurvature(
-	const FVector& P0, const FVector& P1, const FVector& P2)
-{
-	// Menger curvature formula:
-	// k = 4 * Area(triangle) / (|P0-P1| * |P1-P2| * |P2-P0|)
-	// Area = 0.5 * |cross(P1-P0, P2-P0)|
-
-	FVector V1 = P1 - P0;
-	FVector V2 = P2 - P0;
-	FVector V3 = P2 - P1;
-
-	float A = V1.Size();
-	float B = V3.Size();
-	float C = V2.Size();
-
-	// Cross product for area calculation
-	FVector CrossProduct = FVector::CrossProduct(V1, V2);
-	float TriangleAreaTimesTwo = CrossProduct.Size();
-
-	// Avoid division by zero
-	float Denominator = A * B * C;
-	if (Denominator < KINDA_SMALL_NUMBER)
-	{
-		return 0.0f;
-	}
-
-	// Curvature = 4 * (Area * 2 / 2) / (A * B * C) = 2 * |cross| / (A * B * C)
-	float Curvature = (2.0f * TriangleAreaTimesTwo) / Denominator;
-
-	return Curvature;
-}
-
 TArray<int32> FSaliencyDetector::FindSalientPoints(
-	const TArray<float>& Curvatures,
-	const TArray<float>& Times,
+	TConstArrayView<float> Curvatures,
+	TConstArrayView<double> Times,
 	float WindowSize,
-	float Threshold)
+	float Threshold,
+	bool bCyclic)
 {
 	TArray<int32> SalientIndices;
 
@@ -188,13 +138,28 @@ TArray<int32> FSaliencyDetector::FindSalientPoints(
 		return SalientIndices;
 	}
 
+	// The last frame of a cycle repeats the first, so it is neither counted nor tested
+	const int32 LastIndex = Curvatures.Num() - 1;
+	const int32 NumTested = bCyclic ? LastIndex : Curvatures.Num();
+
 	// Calculate curvature derivative (rate of change)
 	TArray<float> CurvatureDerivatives;
-	CurvatureDerivatives.Add(0.0f);  // First point
+	if (bCyclic)
+	{
+		// The first point continues the step into the last one
+		const float DeltaTime = static_cast<float>(Times[LastIndex] - Times[LastIndex - 1]);
+		CurvatureDerivatives.Add(DeltaTime > KINDA_SMALL_NUMBER
+			? FMath::Abs(Curvatures[0] - Curvatures[LastIndex - 1]) / DeltaTime
+			: 0.0f);
+	}
+	else
+	{
+		CurvatureDerivatives.Add(0.0f);  // First point
+	}
 
 	for (int32 i = 1; i < Curvatures.Num(); ++i)
 	{
-		float DeltaTime = Times[i] - Times[i - 1];
+		float DeltaTime = static_cast<float>(Times[i] - Times[i - 1]);
 		if (DeltaTime > KINDA_SMALL_NUMBER)
 		{
 			float Derivative = FMath::Abs(Curvatures[i] - Curvatures[i - 1]) / DeltaTime;
@@ -209,22 +174,23 @@ TArray<int32> FSaliencyDetector::FindSalientPoints(
 	// Calculate statistics for adaptive thresholding
 	float MeanDerivative = 0.0f;
 	float MaxDerivative = 0.0f;
-	for (float Deriv : CurvatureDerivatives)
+	for (int32 i = 0; i < NumTested; ++i)
 	{
-		MeanDerivative += Deriv;
-		MaxDerivative = FMath::Max(MaxDerivative, Deriv);
+		MeanDerivative += CurvatureDerivatives[i];
+		MaxDerivative = FMath::Max(MaxDerivative, CurvatureDerivatives[i]);
 	}
-	MeanDerivative /= CurvatureDerivatives.Num();
+	MeanDerivative /= NumTested;
 
 	// Adaptive threshold based on the data
 	float AdaptiveThreshold = MeanDerivative + Threshold * (MaxDerivative - MeanDerivative);
 
 	// Find points where curvature derivative exceeds threshold
 	// and are local maxima of curvature
-	for (int32 i = 1; i < Curvatures.Num() - 1; ++i)
+	for (int32 i = bCyclic ? 0 : 1; i < LastIndex; ++i)
 	{
 		// Check if this is a curvature peak
-		bool bIsCurvaturePeak = Curvatures[i] > Curvatures[i - 1] &&
+		const float PrevCurvature = i > 0 ? Curvatures[i - 1] : Curvatures[LastIndex - 1];
+		bool bIsCurvaturePeak = Curvatures[i] > PrevCurvature &&
 								Curvatures[i] > Curvatures[i + 1];
 
 		// Check if curvature derivative is high (rapid change)
@@ -237,16 +203,11 @@ TArray<int32> FSaliencyDetector::FindSalientPoints(
 
 		if (bIsCurvaturePeak || bHighDerivative)
 		{
-			// Check if this is sufficiently far from other salient points
-			bool bTooClose = false;
-			for (int32 ExistingIndex : SalientIndices)
-			{
-				if (FMath::Abs(Times[i] - Times[ExistingIndex]) < WindowSize)
-				{
-					bTooClose = true;
-					break;
-				}
-			}
+			// Check if this is sufficiently far from other salient points.
+			// Candidates are visited in time order, so the last accepted point is always
+			// the closest one and the window test is O(1) per candidate.
+			const bool bTooClose = SalientIndices.Num() > 0 &&
+				static_cast<float>(Times[i] - Times[SalientIndices.Last()]) < WindowSize;
 
 			if (!bTooClose)
 			{
@@ -255,31 +216,49 @@ TArray<int32> FSaliencyDetector::FindSalientPoints(
 		}
 	}
 
+	// The first accepted point of a cycle also follows the last one
+	if (bCyclic && SalientIndices.Num() > 1)
+	{
+		const double Period = Times[LastIndex] - Times[0];
+		if (static_cast<float>(Times[SalientIndices[0]] + Period - Times[SalientIndices.Last()]) < WindowSize)
+		{
+			SalientIndices.Pop();
+		}
+	}
+
 	return SalientIndices;
 }
 
 bool FSaliencyDetector::IsFootContact(
-	const TArray<FVector>& Positions,
-	int32 SalientIndex)
+	const FTrajectoryStream& Positions,
+	int32 SalientIndex,
+	bool bCyclic) const
 {
 	// Look at the height (Z) change around the salient point
 	// If height is decreasing before and increasing after, it's a contact
 	// If height is increasing before and decreasing after, it's a lift-off
 
-	if (SalientIndex <= 0 || SalientIndex >= Positions.Num() - 1)
+	// Cyclic trajectories have neighbors on both sides of every frame
+	const bool bWrap = bCyclic && Positions.Num() >= 3;
+	if (!bWrap && (SalientIndex <= 0 || SalientIndex >= Positions.Num() - 1))
 	{
 		return true;  // Default to contact
 	}
 
+	auto GetHeight = [&Positions, bWrap](int32 Frame)
+	{
+		return bWrap ? static_cast<float>(Positions.GetCyclicPosition(Frame).Z) : Positions.Z[Frame];
+	};
+
 	// Look at a small window around the salient point
-	int32 WindowStart = FMath::Max(0, SalientIndex - 2);
-	int32 WindowEnd = FMath::Min(Positions.Num() - 1, SalientIndex + 2);
+	int32 WindowStart = bWrap ? SalientIndex - 2 : FMath::Max(0, SalientIndex - 2);
+	int32 WindowEnd = bWrap ? SalientIndex + 2 : FMath::Min(Positions.Num() - 1, SalientIndex + 2);
 
 	float HeightBefore = 0.0f;
 	int32 CountBefore = 0;
 	for (int32 i = WindowStart; i < SalientIndex; ++i)
 	{
-		HeightBefore += Positions[i].Z;
+		HeightBefore += GetHeight(i);
 		CountBefore++;
 	}
 	if (CountBefore > 0) HeightBefore /= CountBefore;
@@ -288,12 +267,12 @@ bool FSaliencyDetector::IsFootContact(
 	int32 CountAfter = 0;
 	for (int32 i = SalientIndex + 1; i <= WindowEnd; ++i)
 	{
-		HeightAfter += Positions[i].Z;
+		HeightAfter += GetHeight(i);
 		CountAfter++;
 	}
 	if (CountAfter > 0) HeightAfter /= CountAfter;
 
-	float HeightAtPoint = Positions[SalientIndex].Z;
+	float HeightAtPoint = Positions.Z[SalientIndex];
 
 	// Contact: height was decreasing (above), now at minimum or increasing
 	// Lift-off: height was stable or at minimum, now increasing
@@ -0,0 +1,629 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/StreamingDetectors.h"
+#include "FootSyncStats.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "Detection/TrajectoryKernels.h"
+#include "FootSyncContactMath.h"
+#include "AnimationBlueprintLibrary.h"
+
+// ============== Pelvis Crossing ==============
+
+FStreamingPelvisCrossingDetector::FStreamingPelvisCrossingDetector(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+{
+}
+
+void FStreamingPelvisCrossingDetector::Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset)
+{
+	MoveAxis = Preset.PrimaryMoveAxis.GetSafeNormal();
+	if (MoveAxis.IsNearlyZero())
+	{
+		MoveAxis = FVector::ForwardVector;
+	}
+
+	FirstPosition = 0.0f;
+	LastTime = 0.0;
+	LastPosition = 0.0f;
+	NumFrames = 0;
+	bFinished = false;
+}
+
+void FStreamingPelvisCrossingDetector::ProcessChunk(
+	TConstArrayView<double> Times,
+	const FFootTrajectory& Frames,
+	TArray<FFootContactResult>& OutResults)
+{
+	FOOTSYNC_SCOPE(DetectPelvisCrossing);
+	check(!bFinished && Frames.PelvisRelative.Num() == Times.Num());
+
+	for (int32 i = 0; i < Times.Num(); ++i)
+	{
+		const float CurrPos = static_cast<float>(Frames.PelvisRelative.GetPosition(i) | MoveAxis);
+
+		if (NumFrames == 0)
+		{
+			FirstPosition = CurrPos;
+		}
+		else if (FFootSyncContactMath::IsPelvisCrossing(LastPosition, CurrPos))
+		{
+			// Same crossing test and confidence as the batch detector
+			const float PrevTime = static_cast<float>(LastTime);
+			const float CurrTime = static_cast<float>(Times[i]);
+			const float CrossingTime = FFootSyncContactMath::InterpolateCrossingTime(PrevTime, LastPosition, CurrTime, CurrPos);
+
+			const bool bIsContact = FFootSyncContactMath::IsCrossingContact(LastPosition, CurrPos);
+			const float Confidence = FFootSyncContactMath::GetCrossingConfidence(LastPosition, CurrPos, Config.PelvisConfidenceScale);
+
+			OutResults.Add(FFootContactResult(CrossingTime, Confidence, bIsContact, EFootContactDetectionMethod::PelvisCrossing));
+		}
+
+		LastTime = Times[i];
+		LastPosition = CurrPos;
+		++NumFrames;
+	}
+}
+
+void FStreamingPelvisCrossingDetector::Finish(TArray<FFootContactResult>& OutResults)
+{
+	// Crossing at the loop boundary (for looping animations)
+	if (!bFinished && NumFrames >= 2 && FFootSyncContactMath::IsPelvisCrossing(LastPosition, FirstPosition))
+	{
+		OutResults.Add(FFootContactResult(
+			static_cast<float>(LastTime),
+			Config.LoopBoundaryConfidence,
+			FFootSyncContactMath::IsCrossingContact(LastPosition, FirstPosition),
+			EFootContactDetectionMethod::PelvisCrossing));
+	}
+
+	bFinished = true;
+}
+
+double FStreamingPelvisCrossingDetector::GetFinalizedTime() const
+{
+	if (bFinished)
+	{
+		return TNumericLimits<double>::Max();
+	}
+
+	// The next crossing lies after the newest frame
+	return NumFrames > 0 ? LastTime : TNumericLimits<double>::Lowest();
+}
+
+// ============== Velocity Curve ==============
+
+FStreamingVelocityCurveDetector::FStreamingVelocityCurveDetector(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+{
+}
+
+void FStreamingVelocityCurveDetector::Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset)
+{
+	History.Reset();
+	NumSpeeds = 0;
+	MaxSpeed = 0.0f;
+	bFinished = false;
+}
+
+/** Finite-difference speed between two history frames, matching FTrajectoryKernels::ComputeSpeed */
+static float GetHistorySpeed(const FFootSyncFrameHistory& History, int32 FromAge, int32 ToAge)
+{
+	return FFootSyncContactMath::GetSpeed(
+		History.GetTime(FromAge), History.GetPosition(FromAge),
+		History.GetTime(ToAge), History.GetPosition(ToAge));
+}
+
+void FStreamingVelocityCurveDetector::ProcessChunk(
+	TConstArrayView<double> Times,
+	const FFootTrajectory& Frames,
+	TArray<FFootContactResult>& OutResults)
+{
+	FOOTSYNC_SCOPE(DetectVelocityCurve);
+	check(!bFinished && Frames.Position.Num() == Times.Num());
+
+	for (int32 i = 0; i < Times.Num(); ++i)
+	{
+		History.Push(Times[i], Frames.Position.GetPosition(i), Frames.PelvisRelative.GetPosition(i));
+
+		if (History.GetNumPushed() == 2)
+		{
+			// First frame: forward difference
+			AddSpeed(GetHistorySpeed(History, 1, 0), History.GetTime(1), OutResults);
+		}
+		else if (History.GetNumPushed() > 2)
+		{
+			// Previous frame: central difference
+			AddSpeed(GetHistorySpeed(History, 2, 0), History.GetTime(1), OutResults);
+		}
+	}
+}
+
+void FStreamingVelocityCurveDetector::Finish(TArray<FFootContactResult>& OutResults)
+{
+	// The batch detector needs at least three frames
+	if (!bFinished && History.GetNumPushed() >= 3)
+	{
+		// Last frame: backward difference
+		AddSpeed(GetHistorySpeed(History, 1, 0), History.GetTime(0), OutResults);
+
+		// Last frame edge test
+		if (Speeds[0] < Config.VelocityThreshold && Speeds[0] < Speeds[1])
+		{
+			AddResult(Speeds[0], SpeedTimes[0], OutResults);
+		}
+	}
+
+	bFinished = true;
+}
+
+double FStreamingVelocityCurveDetector::GetFinalizedTime() const
+{
+	if (bFinished)
+	{
+		return TNumericLimits<double>::Max();
+	}
+
+	// The newest speed is the next candidate
+	return NumSpeeds > 0 ? SpeedTimes[0] : TNumericLimits<double>::Lowest();
+}
+
+void FStreamingVelocityCurveDetector::AddSpeed(float Speed, double Time, TArray<FFootContactResult>& OutResults)
+{
+	for (int32 Index = SpeedWindow - 1; Index > 0; --Index)
+	{
+		Speeds[Index] = Speeds[Index - 1];
+		SpeedTimes[Index] = SpeedTimes[Index - 1];
+	}
+	Speeds[0] = Speed;
+	SpeedTimes[0] = Time;
+	++NumSpeeds;
+
+	MaxSpeed = FMath::Max(MaxSpeed, Speed);
+
+	const float Threshold = Config.VelocityThreshold;
+
+	if (NumSpeeds == 2)
+	{
+		// First frame edge test
+		if (Speeds[1] < Threshold && Speeds[1] < Speeds[0])
+		{
+			AddResult(Speeds[1], SpeedTimes[1], OutResults);
+		}
+	}
+	else if (NumSpeeds > 2)
+	{
+		// Local minimum (including plateau minima) of the previous frame
+		if (FFootSyncContactMath::IsVelocityMinimum(Speeds[2], Speeds[1], Speeds[0], Threshold))
+		{
+			AddResult(Speeds[1], SpeedTimes[1], OutResults);
+		}
+	}
+}
+
+void FStreamingVelocityCurveDetector::AddResult(float Speed, double Time, TArray<FFootContactResult>& OutResults) const
+{
+	// Higher confidence for lower velocities
+	const float Confidence = FFootSyncContactMath::GetVelocityConfidence(Speed, MaxSpeed, Config.VelocityDefaultConfidence);
+
+	OutResults.Add(FFootContactResult(static_cast<float>(Time), Confidence, true, EFootContactDetectionMethod::VelocityCurve));
+}
+
+// ============== Saliency ==============
+
+FStreamingSaliencyDetector::FStreamingSaliencyDetector(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+{
+}
+
+void FStreamingSaliencyDetector::Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset)
+{
+	History.Reset();
+	NumCurvatures = 0;
+	DerivativeSum = 0.0;
+	MaxDerivative = 0.0f;
+	MaxCurvature = 0.0f;
+	LastSalientTime = -1.0f;
+	bFinished = false;
+}
+
+void FStreamingSaliencyDetector::ProcessChunk(
+	TConstArrayView<double> Times,
+	const FFootTrajectory& Frames,
+	TArray<FFootContactResult>& OutResults)
+{
+	FOOTSYNC_SCOPE(DetectSaliency);
+	check(!bFinished && Frames.Position.Num() == Times.Num());
+
+	for (int32 i = 0; i < Times.Num(); ++i)
+	{
+		History.Push(Times[i], Frames.Position.GetPosition(i), Frames.PelvisRelative.GetPosition(i));
+
+		if (History.GetNumPushed() == 1)
+		{
+			// First frame has no curvature
+			AddCurvature(0.0f, History.GetTime(0), 1, OutResults);
+		}
+		else if (History.GetNumPushed() > 2)
+		{
+			// Previous frame now has both neighbors; the frame before it is the candidate
+			const float Curvature = FTrajectoryKernels::CalculatePointCurvature(
+				History.GetPosition(2), History.GetPosition(1), History.GetPosition(0));
+			AddCurvature(Curvature, History.GetTime(1), 2, OutResults);
+		}
+	}
+}
+
+void FStreamingSaliencyDetector::Finish(TArray<FFootContactResult>& OutResults)
+{
+	// The batch detector needs at least four frames; the last frame has no curvature
+	if (!bFinished && History.GetNumPushed() >= 4)
+	{
+		AddCurvature(0.0f, History.GetTime(0), 1, OutResults);
+	}
+
+	bFinished = true;
+}
+
+double FStreamingSaliencyDetector::GetFinalizedTime() const
+{
+	if (bFinished)
+	{
+		return TNumericLimits<double>::Max();
+	}
+
+	// The newest curvature is the next candidate
+	return NumCurvatures > 0 ? CurvatureTimes[0] : TNumericLimits<double>::Lowest();
+}
+
+void FStreamingSaliencyDetector::AddCurvature(
+	float Curvature,
+	double Time,
+	int32 CandidateAge,
+	TArray<FFootContactResult>& OutResults)
+{
+	// Curvature derivative (rate of change), zero for the first frame
+	float Derivative = 0.0f;
+	if (NumCurvatures > 0)
+	{
+		const float DeltaTime = static_cast<float>(Time) - static_cast<float>(CurvatureTimes[0]);
+		if (DeltaTime > KINDA_SMALL_NUMBER)
+		{
+			Derivative = FMath::Abs(Curvature - Curvatures[0]) / DeltaTime;
+		}
+	}
+
+	for (int32 Index = CurvatureWindow - 1; Index > 0; --Index)
+	{
+		Curvatures[Index] = Curvatures[Index - 1];
+		CurvatureTimes[Index] = CurvatureTimes[Index - 1];
+	}
+	Curvatures[0] = Curvature;
+	CurvatureTimes[0] = Time;
+	Derivatives[1] = Derivatives[0];
+	Derivatives[0] = Derivative;
+	++NumCurvatures;
+
+	DerivativeSum += Derivative;
+	MaxDerivative = FMath::Max(MaxDerivative, Derivative);
+	MaxCurvature = FMath::Max(MaxCurvature, Curvature);
+
+	if (NumCurvatures < 3)
+	{
+		return;
+	}
+
+	// Adaptive threshold from the derivatives seen so far
+	const float MeanDerivative = static_cast<float>(DerivativeSum / NumCurvatures);
+	const float AdaptiveThreshold = MeanDerivative + Config.SaliencyThreshold * (MaxDerivative - MeanDerivative);
+
+	const bool bIsCurvaturePeak = Curvatures[1] > Curvatures[2] && Curvatures[1] > Curvatures[0];
+	const bool bHighDerivative = Derivatives[1] > AdaptiveThreshold || Derivatives[0] > AdaptiveThreshold;
+
+	if (!bIsCurvaturePeak && !bHighDerivative)
+	{
+		return;
+	}
+
+	// Only the last accepted point can be within the suppression window
+	const float CandidateTime = static_cast<float>(CurvatureTimes[1]);
+	if (LastSalientTime >= 0.0f && (CandidateTime - LastSalientTime) < Config.SaliencyWindowSize)
+	{
+		return;
+	}
+	LastSalientTime = CandidateTime;
+
+	// Confidence based on curvature prominence
+	const float Confidence = MaxCurvature > KINDA_SMALL_NUMBER
+		? FMath::Clamp(Curvatures[1] / MaxCurvature, Config.SaliencyMinConfidence, 1.0f)
+		: Config.SaliencyDefaultConfidence;
+
+	OutResults.Add(FFootContactResult(
+		CandidateTime,
+		Confidence,
+		IsFootContact(CandidateAge),
+		EFootContactDetectionMethod::Saliency));
+}
+
+bool FStreamingSaliencyDetector::IsFootContact(int32 CandidateAge) const
+{
+	// Same two-frame height window as FSaliencyDetector::IsFootContact
+	const int32 OldestAge = FMath::Min(CandidateAge + 2, History.Num() - 1);
+	const int32 NewestAge = FMath::Max(0, CandidateAge - 2);
+
+	float HeightBefore = 0.0f;
+	int32 CountBefore = 0;
+	for (int32 Age = OldestAge; Age > CandidateAge; --Age)
+	{
+		HeightBefore += static_cast<float>(History.GetPosition(Age).Z);
+		CountBefore++;
+	}
+	if (CountBefore > 0) HeightBefore /= CountBefore;
+
+	float HeightAfter = 0.0f;
+	int32 CountAfter = 0;
+	for (int32 Age = CandidateAge - 1; Age >= NewestAge; --Age)
+	{
+		HeightAfter += static_cast<float>(History.GetPosition(Age).Z);
+		CountAfter++;
+	}
+	if (CountAfter > 0) HeightAfter /= CountAfter;
+
+	const float HeightAtPoint = static_cast<float>(History.GetPosition(CandidateAge).Z);
+
+	const bool bWasDecreasing = HeightBefore > HeightAtPoint;
+	const bool bWillIncrease = HeightAfter > HeightAtPoint;
+
+	return bWasDecreasing || !bWillIncrease;
+}
+
+// ============== Composite ==============
+
+FStreamingCompositeDetector::FStreamingCompositeDetector(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+	, Merger(InConfig)
+{
+	// Same order as the batch merge inputs, so ties resolve identically
+	if (Config.CompositeWeights.PelvisCrossingWeight > KINDA_SMALL_NUMBER)
+	{
+		Detectors[0] = MakeUnique<FStreamingPelvisCrossingDetector>(Config);
+	}
+	if (Config.CompositeWeights.VelocityCurveWeight > KINDA_SMALL_NUMBER)
+	{
+		Detectors[1] = MakeUnique<FStreamingVelocityCurveDetector>(Config);
+	}
+	if (Config.CompositeWeights.SaliencyWeight > KINDA_SMALL_NUMBER)
+	{
+		Detectors[2] = MakeUnique<FStreamingSaliencyDetector>(Config);
+	}
+}
+
+void FStreamingCompositeDetector::Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset)
+{
+	for (TUniquePtr<IStreamingFootContactDetector>& Detector : Detectors)
+	{
+		if (Detector)
+		{
+			Detector->Begin(Foot, Preset);
+		}
+	}
+
+	PendingResults.Reset();
+	FinalizedTime = TNumericLimits<double>::Lowest();
+}
+
+void FStreamingCompositeDetector::ProcessChunk(
+	TConstArrayView<double> Times,
+	const FFootTrajectory& Frames,
+	TArray<FFootContactResult>& OutResults)
+{
+	FOOTSYNC_SCOPE(DetectComposite);
+
+	TArray<FFootContactResult> DetectorResults;
+	for (TUniquePtr<IStreamingFootContactDetector>& Detector : Detectors)
+	{
+		if (Detector)
+		{
+			Detector->ProcessChunk(Times, Frames, DetectorResults);
+		}
+	}
+
+	EmitFinalClusters(DetectorResults, OutResults);
+}
+
+void FStreamingCompositeDetector::Finish(TArray<FFootContactResult>& OutResults)
+{
+	TArray<FFootContactResult> DetectorResults;
+	for (TUniquePtr<IStreamingFootContactDetector>& Detector : Detectors)
+	{
+		if (Detector)
+		{
+			Detector->Finish(DetectorResults);
+		}
+	}
+
+	EmitFinalClusters(DetectorResults, OutResults);
+	check(PendingResults.Num() == 0);
+}
+
+double FStreamingCompositeDetector::GetFinalizedTime() const
+{
+	return PendingResults.Num() > 0
+		? FMath::Min(FinalizedTime, static_cast<double>(PendingResults[0].Time))
+		: FinalizedTime;
+}
+
+void FStreamingCompositeDetector::EmitFinalClusters(
+	TArray<FFootContactResult>& DetectorResults,
+	TArray<FFootContactResult>& OutResults)
+{
+	FOOTSYNC_SCOPE(MergeResults);
+
+	// Individual detectors emit in time order, so only the newly appended tail is out of place
+	PendingResults.Append(DetectorResults);
+	PendingResults.StableSort([](const FFootContactResult& A, const FFootContactResult& B)
+	{
+		return A.Time < B.Time;
+	});
+
+	FinalizedTime = TNumericLimits<double>::Max();
+	for (const TUniquePtr<IStreamingFootContactDetector>& Detector : Detectors)
+	{
+		if (Detector)
+		{
+			FinalizedTime = FMath::Min(FinalizedTime, Detector->GetFinalizedTime());
+		}
+	}
+
+	// A cluster is final once no later result can fall within the merge threshold of its start
+	const float MergeThreshold = Config.ResultMergeThreshold;
+	int32 ClusterStart = 0;
+	while (ClusterStart < PendingResults.Num()
+		&& static_cast<double>(PendingResults[ClusterStart].Time) + MergeThreshold < FinalizedTime)
+	{
+		const int32 ClusterEnd = FCompositeDetector::FindClusterEnd(PendingResults, ClusterStart, MergeThreshold);
+
+		OutResults.Add(Merger.CalculateClusterResult(
+			TConstArrayView<FFootContactResult>(PendingResults.GetData() + ClusterStart, ClusterEnd - ClusterStart)));
+
+		ClusterStart = ClusterEnd;
+	}
+
+	PendingResults.RemoveAt(0, ClusterStart, EAllowShrinking::No);
+}
+
+// ============== Chunked Detection ==============
+
+TUniquePtr<IStreamingFootContactDetector> FFootSyncStreamingDetection::CreateDetector(
+	EFootContactDetectionMethod Method,
+	const FFootSyncDetectionConfig& Config)
+{
+	switch (Method)
+	{
+	case EFootContactDetectionMethod::PelvisCrossing:
+		return MakeUnique<FStreamingPelvisCrossingDetector>(Config);
+	case EFootContactDetectionMethod::VelocityCurve:
+		return MakeUnique<FStreamingVelocityCurveDetector>(Config);
+	case EFootContactDetectionMethod::Saliency:
+		return MakeUnique<FStreamingSaliencyDetector>(Config);
+	case EFootContactDetectionMethod::Composite:
+		return MakeUnique<FStreamingCompositeDetector>(Config);
+	default:
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncStreamingDetection: No streaming detector for %s"),
+			*StaticEnum<EFootContactDetectionMethod>()->GetNameStringByValue(static_cast<int64>(Method)));
+		return nullptr;
+	}
+}
+
+bool FFootSyncStreamingDetection::SupportsConfig(const FFootSyncDetectionConfig& Config)
+{
+	switch (Config.DetectionMethod)
+	{
+	case EFootContactDetectionMethod::PelvisCrossing:
+	case EFootContactDetectionMethod::VelocityCurve:
+	case EFootContactDetectionMethod::Saliency:
+		break;
+	case EFootContactDetectionMethod::Composite:
+		// The streaming composite only merges the three streamed detectors, and always merges Saliency
+		if (Config.CompositeWeights.GroundHeightWeight > KINDA_SMALL_NUMBER
+			|| (Config.bTieredComposite && Config.CompositeWeights.SaliencyWeight > KINDA_SMALL_NUMBER))
+		{
+			return false;
+		}
+		break;
+	default:
+		return false;
+	}
+
+	return Config.CustomDetector.IsNone()
+		&& Config.Sampling.Smoothing.Filter == EFootSyncSmoothingFilter::None
+		&& Config.Sampling.CycleMode != EFootSyncCycleMode::Cyclic;
+}
+
+bool FFootSyncStreamingDetection::DetectContacts(
+	const UAnimSequence* AnimSequence,
+	const FLocomotionPreset& Preset,
+	const FFootSyncDetectionConfig& Config,
+	int32 ChunkFrames,
+	TMap<FName, TArray<FFootContactResult>>& OutResults)
+{
+	return DetectContacts(AnimSequence, Preset, Config, ChunkFrames, OutResults, [](const FFootSyncSamplingContext&) {});
+}
+
+bool FFootSyncStreamingDetection::DetectContacts(
+	const UAnimSequence* AnimSequence,
+	const FLocomotionPreset& Preset,
+	const FFootSyncDetectionConfig& Config,
+	int32 ChunkFrames,
+	TMap<FName, TArray<FFootContactResult>>& OutResults,
+	TFunctionRef<void(const FFootSyncSamplingContext& Chunk)> OnChunk)
+{
+	OutResults.Reset();
+
+	if (!AnimSequence || !Preset.IsValid())
+	{
+		return false;
+	}
+
+	if (!SupportsConfig(Config))
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncStreamingDetection: The detection settings of %s need the whole take and cannot be streamed"),
+			*AnimSequence->GetName());
+		return false;
+	}
+
+	int32 NumKeys = 0;
+	UAnimationBlueprintLibrary::GetNumKeys(AnimSequence, NumKeys);
+	ChunkFrames = FMath::Max(1, ChunkFrames);
+
+	// One detector per foot, each keeps its own lookback window across chunks
+	TArray<FName> FootBones;
+	TArray<TUniquePtr<IStreamingFootContactDetector>> Detectors;
+	for (const FSyncFootDefinition& Foot : Preset.Feet)
+	{
+		if (Foot.BoneName.IsNone() || FootBones.Contains(Foot.BoneName))
+		{
+			continue;
+		}
+
+		TUniquePtr<IStreamingFootContactDetector> Detector = CreateDetector(Config.DetectionMethod, Config);
+		if (!Detector)
+		{
+			OutResults.Reset();
+			return false;
+		}
+
+		Detector->Begin(Foot, Preset);
+		Detectors.Add(MoveTemp(Detector));
+		FootBones.Add(Foot.BoneName);
+		OutResults.Add(Foot.BoneName);
+	}
+
+	FFootSyncSamplingContext Chunk;
+	for (int32 FirstFrame = 0; FirstFrame < NumKeys; FirstFrame += ChunkFrames)
+	{
+		if (!Chunk.InitializeFrameRange(AnimSequence, Preset, FirstFrame, FMath::Min(ChunkFrames, NumKeys - FirstFrame)))
+		{
+			OutResults.Reset();
+			return false;
+		}
+
+		for (int32 FootIndex = 0; FootIndex < FootBones.Num(); ++FootIndex)
+		{
+			if (const FFootTrajectory* Trajectory = Chunk.FindFoot(FootBones[FootIndex]))
+			{
+				Detectors[FootIndex]->ProcessChunk(Chunk.Times, *Trajectory, OutResults[FootBones[FootIndex]]);
+			}
+		}
+
+		OnChunk(Chunk);
+	}
+
+	for (int32 FootIndex = 0; FootIndex < FootBones.Num(); ++FootIndex)
+	{
+		Detectors[FootIndex]->Finish(OutResults[FootBones[FootIndex]]);
+	}
+
+	return true;
+}
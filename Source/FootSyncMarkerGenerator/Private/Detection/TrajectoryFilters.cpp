@@ -0,0 +1,165 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/TrajectoryFilters.h"
+#include "Detection/FootSyncSamplingContext.h"
+
+void FTrajectoryFilters::Smooth(
+	FTrajectoryStream& Stream,
+	const FTrajectoryFilterSettings& Settings,
+	double SampleRate,
+	bool bCyclic)
+{
+	for (TArray<float>* Component : { &Stream.X, &Stream.Y, &Stream.Z })
+	{
+		switch (Settings.Filter)
+		{
+		case EFootSyncSmoothingFilter::SavitzkyGolay:
+			SavitzkyGolay(*Component, Settings.HalfWindow, bCyclic);
+			break;
+
+		case EFootSyncSmoothingFilter::Butterworth:
+			Butterworth(*Component, Settings.CutoffFrequency, SampleRate, bCyclic);
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+void FTrajectoryFilters::SavitzkyGolay(TArrayView<float> Values, int32 HalfWindow, bool bCyclic)
+{
+	const int32 NumSamples = Values.Num();
+	if (HalfWindow < 1 || NumSamples < 3)
+	{
+		return;
+	}
+
+	TArray<float> Padded;
+	const int32 First = PadSamples(Values, HalfWindow, bCyclic, Padded);
+
+	// Quadratic fit over 2m+1 samples: y = A * sum(x) - B * sum(k^2 * x)
+	const double M = HalfWindow;
+	const double Denominator = (2.0 * M - 1.0) * (2.0 * M + 1.0) * (2.0 * M + 3.0);
+	const double A = 3.0 * (3.0 * M * M + 3.0 * M - 1.0) / Denominator;
+	const double B = 15.0 / Denominator;
+
+	// Moments of the window around the first sample, slid by one sample per step
+	double S0 = 0.0;
+	double S1 = 0.0;
+	double S2 = 0.0;
+	for (int32 k = -HalfWindow; k <= HalfWindow; ++k)
+	{
+		const double Value = Padded[First + k];
+		S0 += Value;
+		S1 += k * Value;
+		S2 += k * k * Value;
+	}
+
+	const double EnterWeight = M * M;
+	const double LeaveWeight = (M + 1.0) * (M + 1.0);
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		Values[i] = static_cast<float>(A * S0 - B * S2);
+
+		if (i == NumSamples - 1)
+		{
+			break;
+		}
+
+		const double Leaving = Padded[First + i - HalfWindow];
+		const double Entering = Padded[First + i + HalfWindow + 1];
+
+		// Every offset shrinks by one: k^2 -> k^2 - 2k + 1, k -> k - 1
+		S2 = S2 - 2.0 * S1 + S0 - LeaveWeight * Leaving + EnterWeight * Entering;
+		S1 = S1 - S0 + (M + 1.0) * Leaving + M * Entering;
+		S0 = S0 - Leaving + Entering;
+	}
+}
+
+void FTrajectoryFilters::Butterworth(TArrayView<float> Values, float CutoffFrequency, double SampleRate, bool bCyclic)
+{
+	const int32 NumSamples = Values.Num();
+	if (NumSamples < 3 || SampleRate <= 0.0 || CutoffFrequency <= 0.0f)
+	{
+		return;
+	}
+
+	// Bilinear transform of the analog prototype, cutoff kept below Nyquist
+	const double Cutoff = FMath::Min(static_cast<double>(CutoffFrequency), 0.45 * SampleRate);
+	const double K = FMath::Tan(UE_DOUBLE_PI * Cutoff / SampleRate);
+	const double Norm = 1.0 / (1.0 + UE_DOUBLE_SQRT_2 * K + K * K);
+	const double B0 = K * K * Norm;
+	const double B1 = 2.0 * B0;
+	const double B2 = B0;
+	const double A1 = 2.0 * (K * K - 1.0) * Norm;
+	const double A2 = (1.0 - UE_DOUBLE_SQRT_2 * K + K * K) * Norm;
+
+	// Long enough for the start-up transient to decay before the original samples
+	const int32 Padding = FMath::Clamp(FMath::CeilToInt32(3.0 * SampleRate / Cutoff), 3, 4 * NumSamples);
+
+	TArray<float> Padded;
+	const int32 First = PadSamples(Values, Padding, bCyclic, Padded);
+
+	// Direct form I, starting from rest at the first sample
+	auto FilterPass = [B0, B1, B2, A1, A2](TArray<float>& Samples, int32 Start, int32 End, int32 Step)
+	{
+		double X1 = Samples[Start];
+		double X2 = X1;
+		double Y1 = X1;
+		double Y2 = X1;
+		for (int32 i = Start; i != End; i += Step)
+		{
+			const double X0 = Samples[i];
+			const double Y0 = B0 * X0 + B1 * X1 + B2 * X2 - A1 * Y1 - A2 * Y2;
+			X2 = X1;
+			X1 = X0;
+			Y2 = Y1;
+			Y1 = Y0;
+			Samples[i] = static_cast<float>(Y0);
+		}
+	};
+
+	FilterPass(Padded, 0, Padded.Num(), 1);
+	FilterPass(Padded, Padded.Num() - 1, -1, -1);
+
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		Values[i] = Padded[First + i];
+	}
+}
+
+int32 FTrajectoryFilters::PadSamples(TConstArrayView<float> Values, int32 Padding, bool bCyclic, TArray<float>& OutPadded)
+{
+	const int32 NumSamples = Values.Num();
+	const int32 Last = NumSamples - 1;
+
+	OutPadded.SetNumUninitialized(NumSamples + 2 * Padding);
+
+	if (bCyclic)
+	{
+		// The last sample repeats the first one cycle later, offset by the drift over the cycle
+		const float CycleOffset = Values[Last] - Values[0];
+		for (int32 i = -Padding; i < NumSamples + Padding; ++i)
+		{
+			const int32 Cycles = FMath::DivideAndRoundDown(i, Last);
+			OutPadded[Padding + i] = Values[i - Cycles * Last] + CycleOffset * Cycles;
+		}
+	}
+	else
+	{
+		// Odd reflection about the end samples
+		for (int32 k = 1; k <= Padding; ++k)
+		{
+			const int32 Mirror = FMath::Min(k, Last);
+			OutPadded[Padding - k] = 2.0f * Values[0] - Values[Mirror];
+			OutPadded[Padding + Last + k] = 2.0f * Values[Last] - Values[Last - Mirror];
+		}
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			OutPadded[Padding + i] = Values[i];
+		}
+	}
+
+	return Padding;
+}
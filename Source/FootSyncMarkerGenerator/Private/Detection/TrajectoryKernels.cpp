@@ -0,0 +1,402 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Detection/TrajectoryKernels.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarFootSyncScalarKernels(
+	TEXT("FootSync.ScalarKernels"),
+	false,
+	TEXT("Use the scalar reference kernels instead of the vectorized ones (for validation)."));
+
+namespace FootSyncKernels
+{
+	/**
+	 * Vectorized speed and/or curvature in a single pass over the frames
+	 * Both signals read the same three neighboring frames and the chord between the outer
+	 * two, so the fused pass loads each frame once. The single-signal instantiations are
+	 * the standalone kernels. Streams shorter than three frames go to the scalar references.
+	 */
+	template <bool bWithSpeed, bool bWithCurvature>
+	void ComputeSignals(
+		const FTrajectoryStream& Positions,
+		TConstArrayView<double> Times,
+		float* RESTRICT OutSpeeds,
+		float* RESTRICT OutCurvatures,
+		bool bCyclic)
+	{
+		const int32 NumFrames = Positions.Num();
+		const int32 Last = NumFrames - 1;
+
+		const float* RESTRICT X = Positions.X.GetData();
+		const float* RESTRICT Y = Positions.Y.GetData();
+		const float* RESTRICT Z = Positions.Z.GetData();
+
+		// Finite-difference speed between two frames
+		[[maybe_unused]] auto ChordSpeed = [X, Y, Z, &Times](int32 From, int32 To)
+		{
+			const float DeltaTime = static_cast<float>(Times[To] - Times[From]);
+			if (DeltaTime <= KINDA_SMALL_NUMBER)
+			{
+				return 0.0f;
+			}
+
+			const float DX = X[To] - X[From];
+			const float DY = Y[To] - Y[From];
+			const float DZ = Z[To] - Z[From];
+			return FMath::Sqrt(DX * DX + DY * DY + DZ * DZ) / DeltaTime;
+		};
+
+		// Edge frames
+		if (bCyclic)
+		{
+			if constexpr (bWithSpeed)
+			{
+				// Across the seam: the step into the last frame continues with the step out of the first
+				const float DeltaTime = static_cast<float>(Times[1] - Times[0] + Times[Last] - Times[Last - 1]);
+				const float DX = X[1] - X[0] + X[Last] - X[Last - 1];
+				const float DY = Y[1] - Y[0] + Y[Last] - Y[Last - 1];
+				const float DZ = Z[1] - Z[0] + Z[Last] - Z[Last - 1];
+
+				OutSpeeds[0] = DeltaTime > KINDA_SMALL_NUMBER ? FMath::Sqrt(DX * DX + DY * DY + DZ * DZ) / DeltaTime : 0.0f;
+				OutSpeeds[Last] = OutSpeeds[0];
+			}
+			if constexpr (bWithCurvature)
+			{
+				// The seam triangles on both ends are the same up to the cycle offset
+				OutCurvatures[0] = FTrajectoryKernels::CalculatePointCurvature(
+					Positions.GetCyclicPosition(-1), Positions.GetPosition(0), Positions.GetPosition(1));
+				OutCurvatures[Last] = OutCurvatures[0];
+			}
+		}
+		else
+		{
+			if constexpr (bWithSpeed)
+			{
+				// Forward and backward difference
+				OutSpeeds[0] = ChordSpeed(0, 1);
+				OutSpeeds[Last] = ChordSpeed(Last - 1, Last);
+			}
+			if constexpr (bWithCurvature)
+			{
+				// First and last points have no curvature (need neighbors)
+				OutCurvatures[0] = 0.0f;
+				OutCurvatures[Last] = 0.0f;
+			}
+		}
+
+		// Interior frames, four frames per iteration
+		[[maybe_unused]] const VectorRegister4Float MinDeltaTime = VectorSetFloat1(KINDA_SMALL_NUMBER);
+		[[maybe_unused]] const VectorRegister4Float MinDenominator = VectorSetFloat1(KINDA_SMALL_NUMBER);
+		[[maybe_unused]] const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+		const VectorRegister4Float Zero = VectorZeroFloat();
+
+		const int32 LastInterior = NumFrames - 2;
+		int32 i = 1;
+		for (; i + 3 <= LastInterior; i += 4)
+		{
+			const VectorRegister4Float X0 = VectorLoad(X + i - 1);
+			const VectorRegister4Float Y0 = VectorLoad(Y + i - 1);
+			const VectorRegister4Float Z0 = VectorLoad(Z + i - 1);
+			const VectorRegister4Float X2 = VectorLoad(X + i + 1);
+			const VectorRegister4Float Y2 = VectorLoad(Y + i + 1);
+			const VectorRegister4Float Z2 = VectorLoad(Z + i + 1);
+
+			// Chord P2 - P0: the central difference of the speed and the third side of the triangle
+			const VectorRegister4Float V2X = VectorSubtract(X2, X0);
+			const VectorRegister4Float V2Y = VectorSubtract(Y2, Y0);
+			const VectorRegister4Float V2Z = VectorSubtract(Z2, Z0);
+			const VectorRegister4Float C = VectorSqrt(
+				VectorMultiplyAdd(V2X, V2X, VectorMultiplyAdd(V2Y, V2Y, VectorMultiply(V2Z, V2Z))));
+
+			if constexpr (bWithSpeed)
+			{
+				const VectorRegister4Float DeltaTime = MakeVectorRegisterFloat(
+					static_cast<float>(Times[i + 1] - Times[i - 1]),
+					static_cast<float>(Times[i + 2] - Times[i]),
+					static_cast<float>(Times[i + 3] - Times[i + 1]),
+					static_cast<float>(Times[i + 4] - Times[i + 2]));
+
+				const VectorRegister4Float ValidMask = VectorCompareGT(DeltaTime, MinDeltaTime);
+				const VectorRegister4Float Speed = VectorDivide(C, VectorSelect(ValidMask, DeltaTime, VectorOneFloat()));
+
+				VectorStore(VectorSelect(ValidMask, Speed, Zero), OutSpeeds + i);
+			}
+
+			if constexpr (bWithCurvature)
+			{
+				const VectorRegister4Float X1 = VectorLoad(X + i);
+				const VectorRegister4Float Y1 = VectorLoad(Y + i);
+				const VectorRegister4Float Z1 = VectorLoad(Z + i);
+
+				// V1 = P1 - P0, V3 = P2 - P1
+				const VectorRegister4Float V1X = VectorSubtract(X1, X0);
+				const VectorRegister4Float V1Y = VectorSubtract(Y1, Y0);
+				const VectorRegister4Float V1Z = VectorSubtract(Z1, Z0);
+				const VectorRegister4Float V3X = VectorSubtract(X2, X1);
+				const VectorRegister4Float V3Y = VectorSubtract(Y2, Y1);
+				const VectorRegister4Float V3Z = VectorSubtract(Z2, Z1);
+
+				const VectorRegister4Float A = VectorSqrt(
+					VectorMultiplyAdd(V1X, V1X, VectorMultiplyAdd(V1Y, V1Y, VectorMultiply(V1Z, V1Z))));
+				const VectorRegister4Float B = VectorSqrt(
+					VectorMultiplyAdd(V3X, V3X, VectorMultiplyAdd(V3Y, V3Y, VectorMultiply(V3Z, V3Z))));
+
+				// Cross product V1 x V2 for the triangle area
+				const VectorRegister4Float CrossX = VectorSubtract(VectorMultiply(V1Y, V2Z), VectorMultiply(V1Z, V2Y));
+				const VectorRegister4Float CrossY = VectorSubtract(VectorMultiply(V1Z, V2X), VectorMultiply(V1X, V2Z));
+				const VectorRegister4Float CrossZ = VectorSubtract(VectorMultiply(V1X, V2Y), VectorMultiply(V1Y, V2X));
+				const VectorRegister4Float TriangleAreaTimesTwo = VectorSqrt(
+					VectorMultiplyAdd(CrossX, CrossX, VectorMultiplyAdd(CrossY, CrossY, VectorMultiply(CrossZ, CrossZ))));
+
+				// Curvature = 2 * |cross| / (A * B * C), zero for degenerate triangles
+				const VectorRegister4Float Denominator = VectorMultiply(VectorMultiply(A, B), C);
+				const VectorRegister4Float ValidMask = VectorCompareGE(Denominator, MinDenominator);
+				const VectorRegister4Float Curvature = VectorDivide(
+					VectorMultiply(Two, TriangleAreaTimesTwo),
+					VectorSelect(ValidMask, Denominator, VectorOneFloat()));
+
+				VectorStore(VectorSelect(ValidMask, Curvature, Zero), OutCurvatures + i);
+			}
+		}
+
+		// Remaining interior frames
+		for (; i <= LastInterior; ++i)
+		{
+			if constexpr (bWithSpeed)
+			{
+				OutSpeeds[i] = ChordSpeed(i - 1, i + 1);
+			}
+			if constexpr (bWithCurvature)
+			{
+				OutCurvatures[i] = FTrajectoryKernels::CalculatePointCurvature(
+					Positions.GetPosition(i - 1), Positions.GetPosition(i), Positions.GetPosition(i + 1));
+			}
+		}
+	}
+}
+
+void FTrajectoryKernels::ComputeSpeed(
+	const FTrajectoryStream& Positions,
+	TConstArrayView<double> Times,
+	TArrayView<float> OutSpeeds,
+	bool bCyclic)
+{
+	check(Times.Num() == Positions.Num() && OutSpeeds.Num() == Positions.Num());
+
+	if (CVarFootSyncScalarKernels.GetValueOnAnyThread() || Positions.Num() < 3)
+	{
+		ComputeSpeedScalar(Positions, Times, OutSpeeds, bCyclic);
+		return;
+	}
+
+	FootSyncKernels::ComputeSignals<true, false>(Positions, Times, OutSpeeds.GetData(), nullptr, bCyclic);
+}
+
+void FTrajectoryKernels::ComputeSpeedScalar(
+	const FTrajectoryStream& Positions,
+	TConstArrayView<double> Times,
+	TArrayView<float> OutSpeeds,
+	bool bCyclic)
+{
+	const int32 NumFrames = Positions.Num();
+	check(Times.Num() == NumFrames && OutSpeeds.Num() == NumFrames);
+
+	if (NumFrames < 2)
+	{
+		for (float& Speed : OutSpeeds)
+		{
+			Speed = 0.0f;
+		}
+		return;
+	}
+
+	if (bCyclic && NumFrames >= 3)
+	{
+		// Central difference everywhere, neighbors of the edges wrap around the seam
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			const float DeltaTime = static_cast<float>(GetCyclicTime(Times, i + 1) - GetCyclicTime(Times, i - 1));
+			OutSpeeds[i] = DeltaTime > KINDA_SMALL_NUMBER
+				? static_cast<float>((Positions.GetCyclicPosition(i + 1) - Positions.GetCyclicPosition(i - 1)).Size()) / DeltaTime
+				: 0.0f;
+		}
+		return;
+	}
+
+	// Central difference for interior points, forward/backward for edges
+	for (int32 i = 0; i < NumFrames; ++i)
+	{
+		const int32 From = (i == 0) ? 0 : i - 1;
+		const int32 To = (i == NumFrames - 1) ? i : i + 1;
+
+		const float DeltaTime = static_cast<float>(Times[To] - Times[From]);
+		if (DeltaTime > KINDA_SMALL_NUMBER)
+		{
+			OutSpeeds[i] = (Positions.GetPosition(To) - Positions.GetPosition(From)).Size() / DeltaTime;
+		}
+		else
+		{
+			OutSpeeds[i] = 0.0f;
+		}
+	}
+}
+
+void FTrajectoryKernels::ComputeCurvature(
+	const FTrajectoryStream& Positions,
+	TArrayView<float> OutCurvatures,
+	bool bCyclic)
+{
+	check(OutCurvatures.Num() == Positions.Num());
+
+	if (CVarFootSyncScalarKernels.GetValueOnAnyThread() || Positions.Num() < 3)
+	{
+		ComputeCurvatureScalar(Positions, OutCurvatures, bCyclic);
+		return;
+	}
+
+	FootSyncKernels::ComputeSignals<false, true>(Positions, TConstArrayView<double>(), nullptr, OutCurvatures.GetData(), bCyclic);
+}
+
+void FTrajectoryKernels::ComputeSpeedAndCurvature(
+	const FTrajectoryStream& Positions,
+	TConstArrayView<double> Times,
+	TArrayView<float> OutSpeeds,
+	TArrayView<float> OutCurvatures,
+	bool bCyclic)
+{
+	check(Times.Num() == Positions.Num() && OutSpeeds.Num() == Positions.Num() && OutCurvatures.Num() == Positions.Num());
+
+	if (CVarFootSyncScalarKernels.GetValueOnAnyThread() || Positions.Num() < 3)
+	{
+		ComputeSpeedScalar(Positions, Times, OutSpeeds, bCyclic);
+		ComputeCurvatureScalar(Positions, OutCurvatures, bCyclic);
+		return;
+	}
+
+	FootSyncKernels::ComputeSignals<true, true>(Positions, Times, OutSpeeds.GetData(), OutCurvatures.GetData(), bCyclic);
+}
+
+void FTrajectoryKernels::ComputeCurvatureScalar(
+	const FTrajectoryStream& Positions,
+	TArrayView<float> OutCurvatures,
+	bool bCyclic)
+{
+	const int32 NumFrames = Positions.Num();
+	check(OutCurvatures.Num() == NumFrames);
+
+	if (bCyclic && NumFrames >= 3)
+	{
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			OutCurvatures[i] = CalculatePointCurvature(
+				Positions.GetCyclicPosition(i - 1), Positions.GetPosition(i), Positions.GetCyclicPosition(i + 1));
+		}
+		return;
+	}
+
+	for (int32 i = 0; i < NumFrames; ++i)
+	{
+		OutCurvatures[i] = (i > 0 && i < NumFrames - 1)
+			? CalculatePointCurvature(Positions.GetPosition(i - 1), Positions.GetPosition(i), Positions.GetPosition(i + 1))
+			: 0.0f;
+	}
+}
+
+FVector FTrajectoryKernels::FindDominantHorizontalAxis(const FTrajectoryStream& Positions)
+{
+	if (Positions.Num() < 2)
+	{
+		return FVector::ForwardVector;
+	}
+
+	// Find min/max for X and Y axes
+	float MinX = TNumericLimits<float>::Max();
+	float MaxX = TNumericLimits<float>::Lowest();
+	float MinY = TNumericLimits<float>::Max();
+	float MaxY = TNumericLimits<float>::Lowest();
+
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		MinX = FMath::Min(MinX, Positions.X[i]);
+		MaxX = FMath::Max(MaxX, Positions.X[i]);
+		MinY = FMath::Min(MinY, Positions.Y[i]);
+		MaxY = FMath::Max(MaxY, Positions.Y[i]);
+	}
+
+	// Y-axis dominant (strafing), otherwise X-axis dominant (forward/backward)
+	return (MaxY - MinY) > (MaxX - MinX) ? FVector::RightVector : FVector::ForwardVector;
+}
+
+FVector FTrajectoryKernels::FindDominantHorizontalAxis(const FTrajectoryStream& Positions, TConstArrayView<int32> Frames)
+{
+	if (Frames.Num() < 2)
+	{
+		return FVector::ForwardVector;
+	}
+
+	float MinX = TNumericLimits<float>::Max();
+	float MaxX = TNumericLimits<float>::Lowest();
+	float MinY = TNumericLimits<float>::Max();
+	float MaxY = TNumericLimits<float>::Lowest();
+
+	for (int32 Frame : Frames)
+	{
+		MinX = FMath::Min(MinX, Positions.X[Frame]);
+		MaxX = FMath::Max(MaxX, Positions.X[Frame]);
+		MinY = FMath::Min(MinY, Positions.Y[Frame]);
+		MaxY = FMath::Max(MaxY, Positions.Y[Frame]);
+	}
+
+	// Same choice as over every frame
+	return (MaxY - MinY) > (MaxX - MinX) ? FVector::RightVector : FVector::ForwardVector;
+}
+
+void FTrajectoryKernels::ProjectOnAxis(
+	const FTrajectoryStream& Positions,
+	const FVector& Axis,
+	TArrayView<float> OutProjections)
+{
+	check(OutProjections.Num() == Positions.Num());
+
+	const float AxisX = static_cast<float>(Axis.X);
+	const float AxisY = static_cast<float>(Axis.Y);
+	const float AxisZ = static_cast<float>(Axis.Z);
+
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		OutProjections[i] = Positions.X[i] * AxisX + Positions.Y[i] * AxisY + Positions.Z[i] * AxisZ;
+	}
+}
+
+float FTrajectoryKernels::CalculatePointCurvature(
+	const FVector& P0, const FVector& P1, const FVector& P2)
+{
+	// Menger curvature formula:
+	// k = 4 * Area(triangle) / (|P0-P1| * |P1-P2| * |P2-P0|)
+	// Area = 0.5 * |cross(P1-P0, P2-P0)|
+
+	FVector V1 = P1 - P0;
+	FVector V2 = P2 - P0;
+	FVector V3 = P2 - P1;
+
+	float A = V1.Size();
+	float B = V3.Size();
+	float C = V2.Size();
+
+	// Cross product for area calculation
+	FVector CrossProduct = FVector::CrossProduct(V1, V2);
+	float TriangleAreaTimesTwo = CrossProduct.Size();
+
+	// Avoid division by zero
+	float Denominator = A * B * C;
+	if (Denominator < KINDA_SMALL_NUMBER)
+	{
+		return 0.0f;
+	}
+
+	// Curvature = 4 * (Area * 2 / 2) / (A * B * C) = 2 * |cross| / (A * B * C)
+	float Curvature = (2.0f * TriangleAreaTimesTwo) / Denominator;
+
+	return Curvature;
+}
@@ -1,73 +1,62 @@
 // Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
 
 #include "Detection/VelocityCurveDetector.h"
-#include "FootSyncMarkerSettings.h"
-#include "AnimPose.h"
-#include "AnimationBlueprintLibrary.h"
-#include "Animation/AnimSequence.h"
+#include "FootSyncStats.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "Detection/TrajectoryKernels.h"
+#include "FootSyncContactMath.h"
+
+FVelocityCurveDetector::FVelocityCurveDetector()
+	: Config(FFootSyncDetectionConfig::FromProjectSettings())
+{
+}
+
+FVelocityCurveDetector::FVelocityCurveDetector(const FFootSyncDetectionConfig& InConfig)
+	: Config(InConfig)
+{
+}
 
 TArray<FFootContactResult> FVelocityCurveDetector::DetectContacts(
-	UAnimSequence* AnimSequence,
+	const FFootSyncSamplingContext& Context,
 	const FSyncFootDefinition& Foot,
 	const FLocomotionPreset& Preset)
 {
+	FOOTSYNC_SCOPE(DetectVelocityCurve);
+
 	TArray<FFootContactResult> Results;
 
-	if (!AnimSequence || Foot.BoneName.IsNone())
+	if (!Context.IsValid() || Foot.BoneName.IsNone())
 	{
 		return Results;
 	}
 
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-
-	// Get animation info
-	float SequenceLength;
-	UAnimationBlueprintLibrary::GetSequenceLength(AnimSequence, SequenceLength);
-
-	int32 NumKeys;
-	UAnimationBlueprintLibrary::GetNumKeys(AnimSequence, NumKeys);
-
-	if (NumKeys < 3)  // Need at least 3 frames to find minima
+	if (Context.GetNumFrames() < 3)  // Need at least 3 frames to find minima
 	{
 		return Results;
 	}
 
-	// Build time intervals
-	TArray<float> Times;
-	TArray<double> TimeIntervals;
-	for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
+	const FFootTrajectory* FootTrajectory = Context.FindFoot(Foot.BoneName);
+	if (!FootTrajectory)
 	{
-		float Time;
-		UAnimationBlueprintLibrary::GetTimeAtFrame(AnimSequence, KeyIndex, Time);
-		Times.Add(Time);
-		TimeIntervals.Add(static_cast<double>(Time));
+		return Results;
 	}
 
-	// Evaluate all poses
-	TArray<FAnimPose> Poses;
-	FAnimPoseEvaluationOptions Options;
-	Options.EvaluationType = EAnimDataEvalType::Source;
-
-	UAnimPoseExtensions::GetAnimPoseAtTimeIntervals(AnimSequence, TimeIntervals, Options, Poses);
-
-	if (Poses.Num() != Times.Num())
+	// Velocities shared through the context, calculated here when they were not requested
+	TArray<float> LocalVelocities;
+	TConstArrayView<float> Velocities = FootTrajectory->Speed;
+	if (Velocities.Num() != Context.GetNumFrames())
 	{
-		UE_LOG(LogAnimation, Warning,
-			TEXT("VelocityCurveDetector: Pose count mismatch"));
-		return Results;
+		LocalVelocities = CalculateVelocities(FootTrajectory->Position, Context.Times, Context.bCyclic);
+		Velocities = LocalVelocities;
 	}
 
-	// Calculate velocities
-	TArray<float> Velocities = CalculateVelocities(Poses, Times, Foot.BoneName);
-
 	if (Velocities.Num() < 3)
 	{
 		return Results;
 	}
 
 	// Find local minima
-	const float Threshold = bHasThresholdOverride ? VelocityThresholdOverride : Settings->VelocityMinimumThreshold;
-	TArray<int32> MinimaIndices = FindLocalMinima(Velocities, Threshold);
+	TArray<int32> MinimaIndices = FindLocalMinima(Velocities, Config.VelocityThreshold, Context.bCyclic);
 
 	// Calculate max velocity for confidence scaling
 	float MaxVelocity = 0.0f;
@@ -79,105 +68,51 @@ TArray<FFootContactResult> FVelocityCurveDetector::DetectContacts(
 	// Convert minima to results
 	for (int32 Index : MinimaIndices)
 	{
-		if (Index >= 0 && Index < Times.Num())
+		if (Index >= 0 && Index < Context.Times.Num())
 		{
-			float Velocity = Velocities[Index];
-
-			// Higher confidence for lower velocities
-			float Confidence = MaxVelocity > KINDA_SMALL_NUMBER
-				? 1.0f - FMath::Clamp(Velocity / MaxVelocity, 0.0f, 0.9f)
-				: Settings->VelocityDefaultConfidence;
-
-			Results.Add(FFootContactResult(
-				Times[Index],
-				Confidence,
-				true,  // Velocity minima indicate foot contact
-				EFootContactDetectionMethod::VelocityCurve
-			));
+			Results.Add(MakeMinimumResult(Context.Times[Index], Velocities[Index], MaxVelocity));
 		}
 	}
 
 	return Results;
 }
 
+FFootContactResult FVelocityCurveDetector::MakeMinimumResult(
+	double Time,
+	float Velocity,
+	float MaxVelocity) const
+{
+	// Higher confidence for lower velocities
+	return FFootContactResult(
+		static_cast<float>(Time),
+		FFootSyncContactMath::GetVelocityConfidence(Velocity, MaxVelocity, Config.VelocityDefaultConfidence),
+		true,  // Velocity minima indicate foot contact
+		EFootContactDetectionMethod::VelocityCurve
+	);
+}
+
 TArray<float> FVelocityCurveDetector::CalculateVelocities(
-	const TArray<FAnimPose>& Poses,
-	const TArray<float>& Times,
-	FName FootBone)
+	const FTrajectoryStream& Positions,
+	TConstArrayView<double> Times,
+	bool bCyclic)
 {
 	TArray<float> Velocities;
 
-	if (Poses.Num() < 2)
+	if (Positions.Num() < 2)
 	{
 		return Velocities;
 	}
 
-	// Get positions in world space
-	TArray<FVector> Positions;
-	for (const FAnimPose& Pose : Poses)
-	{
-		FTransform FootTransform = UAnimPoseExtensions::GetBonePose(
-			Pose, FootBone, EAnimPoseSpaces::World);
-		Positions.Add(FootTransform.GetLocation());
-	}
-
-	// Calculate velocities (central difference for interior points, forward/backward for edges)
-	for (int32 i = 0; i < Positions.Num(); ++i)
-	{
-		float Velocity;
-
-		if (i == 0)
-		{
-			// Forward difference
-			float DeltaTime = Times[1] - Times[0];
-			if (DeltaTime > KINDA_SMALL_NUMBER)
-			{
-				Velocity = (Positions[1] - Positions[0]).Size() / DeltaTime;
-			}
-			else
-			{
-				Velocity = 0.0f;
-			}
-		}
-		else if (i == Positions.Num() - 1)
-		{
-			// Backward difference
-			float DeltaTime = Times[i] - Times[i - 1];
-			if (DeltaTime > KINDA_SMALL_NUMBER)
-			{
-				Velocity = (Positions[i] - Positions[i - 1]).Size() / DeltaTime;
-			}
-			else
-			{
-				Velocity = 0.0f;
-			}
-		}
-		else
-		{
-			// Central difference (average of forward and backward)
-			float DeltaTime1 = Times[i] - Times[i - 1];
-			float DeltaTime2 = Times[i + 1] - Times[i];
-			float TotalDeltaTime = DeltaTime1 + DeltaTime2;
-
-			if (TotalDeltaTime > KINDA_SMALL_NUMBER)
-			{
-				Velocity = (Positions[i + 1] - Positions[i - 1]).Size() / TotalDeltaTime;
-			}
-			else
-			{
-				Velocity = 0.0f;
-			}
-		}
-
-		Velocities.Add(Velocity);
-	}
+	Velocities.SetNumUninitialized(Positions.Num());
+	FTrajectoryKernels::ComputeSpeed(Positions, Times, Velocities, bCyclic);
 
 	return Velocities;
 }
 
 TArray<int32> FVelocityCurveDetector::FindLocalMinima(
-	const TArray<float>& Velocities,
-	float Threshold)
+	TConstArrayView<float> Velocities,
+	float Threshold,
+	bool bCyclic)
 {
 	TArray<int32> MinimaIndices;
 
@@ -188,28 +123,25 @@ TArray<int32> FVelocityCurveDetector::FindLocalMinima(
 
 	for (int32 i = 1; i < Velocities.Num() - 1; ++i)
 	{
-		float Prev = Velocities[i - 1];
-		float Curr = Velocities[i];
-		float Next = Velocities[i + 1];
-
-		// Check if current is a local minimum
-		if (Curr < Prev && Curr < Next)
-		{
-			// Only add if below threshold (to filter out noise during foot movement)
-			if (Curr < Threshold)
-			{
-				MinimaIndices.Add(i);
-			}
-		}
-		// Also check for flat regions (plateau minima)
-		else if (Curr <= Prev && Curr < Next && Curr < Threshold)
+		// Local minima, including flat regions (plateau minima), below the threshold
+		// (to filter out noise during foot movement)
+		if (FFootSyncContactMath::IsVelocityMinimum(Velocities[i - 1], Velocities[i], Velocities[i + 1], Threshold))
 		{
 			MinimaIndices.Add(i);
 		}
-		else if (Curr < Prev && Curr <= Next && Curr < Threshold)
+	}
+
+	const int32 LastIndex = Velocities.Num() - 1;
+
+	// The first frame of a cycle is an interior frame, its previous neighbor is the one
+	// before the last frame (which repeats the first and is not tested again)
+	if (bCyclic)
+	{
+		if (FFootSyncContactMath::IsVelocityMinimum(Velocities[LastIndex - 1], Velocities[0], Velocities[1], Threshold))
 		{
-			MinimaIndices.Add(i);
+			MinimaIndices.Insert(0, 0);
 		}
+		return MinimaIndices;
 	}
 
 	// Check edges if they're very low velocity
@@ -218,7 +150,6 @@ TArray<int32> FVelocityCurveDetector::FindLocalMinima(
 		MinimaIndices.Insert(0, 0);
 	}
 
-	int32 LastIndex = Velocities.Num() - 1;
 	if (Velocities[LastIndex] < Threshold && Velocities[LastIndex] < Velocities[LastIndex - 1])
 	{
 		MinimaIndices.Add(LastIndex);
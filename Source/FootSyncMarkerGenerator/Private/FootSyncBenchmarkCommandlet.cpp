@@ -0,0 +1,422 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncBenchmarkCommandlet.h"
+#include "FootSyncMarkerSettings.h"
+#include "Detection/FootSyncTrajectoryFixture.h"
+#include "Detection/FootSyncDetectorRegistry.h"
+#include "Detection/CompositeDetector.h"
+#include "Detection/FootSyncAnalysisExport.h"
+#include "Animation/AnimSequence.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+static const EFootContactDetectionMethod BenchmarkDetectorMethods[] =
+{
+	EFootContactDetectionMethod::PelvisCrossing,
+	EFootContactDetectionMethod::VelocityCurve,
+	EFootContactDetectionMethod::Saliency,
+	EFootContactDetectionMethod::Composite,
+	EFootContactDetectionMethod::GroundHeight
+};
+
+static TUniquePtr<IFootContactDetector> CreateBenchmarkDetector(
+	EFootContactDetectionMethod Method, const FFootSyncDetectionConfig& Config)
+{
+	FFootSyncDetectionConfig MethodConfig = Config;
+	MethodConfig.DetectionMethod = Method;
+	MethodConfig.CustomDetector = NAME_None;
+	return FFootSyncDetectorRegistry::Get().CreateDetector(MethodConfig);
+}
+
+/** Accumulated timings of one measured operation */
+struct FFootSyncBenchmarkTiming
+{
+	double TotalSeconds = 0.0;
+	double MinSeconds = TNumericLimits<double>::Max();
+	int32 NumSamples = 0;
+
+	void Add(double Seconds)
+	{
+		TotalSeconds += Seconds;
+		MinSeconds = FMath::Min(MinSeconds, Seconds);
+		++NumSamples;
+	}
+
+	double GetMeanMs() const { return NumSamples > 0 ? TotalSeconds * 1000.0 / NumSamples : 0.0; }
+	double GetMinMs() const { return NumSamples > 0 ? MinSeconds * 1000.0 : 0.0; }
+};
+
+UFootSyncBenchmarkCommandlet::UFootSyncBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UFootSyncBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString AnalysisFilename;
+	if (FParse::Value(*Params, TEXT("Analysis="), AnalysisFilename))
+	{
+		return RunAnalysis(Params, AnalysisFilename);
+	}
+
+	FString FixtureDir;
+	if (!FParse::Value(*Params, TEXT("Fixtures="), FixtureDir))
+	{
+		UE_LOG(LogAnimation, Error, TEXT("FootSyncBenchmark: Missing -Fixtures=<Dir>"));
+		return 1;
+	}
+
+	if (FParse::Param(*Params, TEXT("Record")))
+	{
+		return RecordFixtures(Params, FixtureDir);
+	}
+
+	return RunFixtures(Params, FixtureDir);
+}
+
+int32 UFootSyncBenchmarkCommandlet::RecordFixtures(const FString& Params, const FString& FixtureDir) const
+{
+	FString PathsParam = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Paths="), PathsParam);
+
+	TArray<FString> PackagePaths;
+	PathsParam.ParseIntoArray(PackagePaths, TEXT("+"), true);
+
+	ELocomotionType LocomotionType = ELocomotionType::Bipedal;
+	FString LocomotionParam;
+	if (FParse::Value(*Params, TEXT("Locomotion="), LocomotionParam))
+	{
+		const int64 Value = StaticEnum<ELocomotionType>()->GetValueByNameString(LocomotionParam);
+		if (Value == INDEX_NONE || Value == static_cast<int64>(ELocomotionType::Custom))
+		{
+			UE_LOG(LogAnimation, Error, TEXT("FootSyncBenchmark: Unsupported locomotion type '%s'"), *LocomotionParam);
+			return 1;
+		}
+		LocomotionType = static_cast<ELocomotionType>(Value);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
+		TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Add(FName(*PackagePath));
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	IFileManager::Get().MakeDirectory(*FixtureDir, true);
+
+	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
+	int32 NumRecorded = 0;
+
+	for (const FAssetData& AssetData : Assets)
+	{
+		UAnimSequence* AnimSequence = Cast<UAnimSequence>(AssetData.GetAsset());
+		if (!AnimSequence)
+		{
+			continue;
+		}
+
+		FFootSyncTrajectoryFixture Fixture;
+		Fixture.Name = AnimSequence->GetName();
+		Fixture.Preset = Settings->CreatePresetForSkeleton(AnimSequence->GetSkeleton(), LocomotionType);
+
+		if (!Fixture.Preset.IsValid() || !Fixture.Context.Initialize(AnimSequence, Fixture.Preset))
+		{
+			UE_LOG(LogAnimation, Warning,
+				TEXT("FootSyncBenchmark: Skipping %s, no valid preset or samples"), *Fixture.Name);
+			continue;
+		}
+
+		// Fixtures outlive the asset, do not keep a reference to it
+		Fixture.Context.AnimSequence = nullptr;
+
+		ComputeGoldenResults(Fixture);
+
+		const FString Filename = FPaths::Combine(FixtureDir, Fixture.Name + FFootSyncTrajectoryFixture::FileExtension);
+		if (!Fixture.SaveToFile(Filename))
+		{
+			UE_LOG(LogAnimation, Error, TEXT("FootSyncBenchmark: Failed to write %s"), *Filename);
+			return 1;
+		}
+
+		UE_LOG(LogAnimation, Display,
+			TEXT("FootSyncBenchmark: Recorded %s (%d frames, %d feet)"),
+			*Filename, Fixture.Context.GetNumFrames(), Fixture.Feet.Num());
+		++NumRecorded;
+	}
+
+	UE_LOG(LogAnimation, Display, TEXT("FootSyncBenchmark: Recorded %d fixtures"), NumRecorded);
+	return 0;
+}
+
+int32 UFootSyncBenchmarkCommandlet::RunFixtures(const FString& Params, const FString& FixtureDir) const
+{
+	int32 Iterations = DefaultIterations;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(1, Iterations);
+
+	float TimeTolerance = 1.0e-4f;
+	FParse::Value(*Params, TEXT("TimeTolerance="), TimeTolerance);
+
+	float ConfidenceTolerance = 1.0e-3f;
+	FParse::Value(*Params, TEXT("ConfidenceTolerance="), ConfidenceTolerance);
+
+	TArray<FString> FixtureFiles;
+	IFileManager::Get().FindFiles(FixtureFiles,
+		*FPaths::Combine(FixtureDir, FString(TEXT("*")) + FFootSyncTrajectoryFixture::FileExtension), true, false);
+	FixtureFiles.Sort();
+
+	if (FixtureFiles.Num() == 0)
+	{
+		UE_LOG(LogAnimation, Error, TEXT("FootSyncBenchmark: No fixtures found in %s"), *FixtureDir);
+		return 1;
+	}
+
+	const FFootSyncDetectionConfig Config = FFootSyncDetectionConfig::FromProjectSettings();
+	int32 NumFailures = 0;
+
+	for (const FString& FixtureFile : FixtureFiles)
+	{
+		FFootSyncTrajectoryFixture Fixture;
+		if (!Fixture.LoadFromFile(FPaths::Combine(FixtureDir, FixtureFile)))
+		{
+			UE_LOG(LogAnimation, Error, TEXT("FootSyncBenchmark: Failed to load %s"), *FixtureFile);
+			++NumFailures;
+			continue;
+		}
+
+		FFootSyncBenchmarkTiming DetectorTimings[UE_ARRAY_COUNT(BenchmarkDetectorMethods)];
+		FFootSyncBenchmarkTiming MergeTiming;
+		bool bFixturePassed = true;
+
+		for (const FFootSyncFixtureFootResults& GoldenFoot : Fixture.Feet)
+		{
+			const FSyncFootDefinition* Foot = Fixture.Preset.Feet.FindByPredicate(
+				[&GoldenFoot](const FSyncFootDefinition& Definition)
+				{
+					return Definition.BoneName == GoldenFoot.BoneName;
+				});
+
+			if (!Foot)
+			{
+				continue;
+			}
+
+			for (int32 MethodIndex = 0; MethodIndex < UE_ARRAY_COUNT(BenchmarkDetectorMethods); ++MethodIndex)
+			{
+				const EFootContactDetectionMethod Method = BenchmarkDetectorMethods[MethodIndex];
+				TUniquePtr<IFootContactDetector> Detector = CreateBenchmarkDetector(Method, Config);
+
+				TArray<FFootContactResult> Results;
+				for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+				{
+					const double StartTime = FPlatformTime::Seconds();
+					Results = Detector->DetectContacts(Fixture.Context, *Foot, Fixture.Preset);
+					DetectorTimings[MethodIndex].Add(FPlatformTime::Seconds() - StartTime);
+				}
+
+				if (!CompareResults(GoldenFoot.GetResults(Method), Results, TimeTolerance, ConfidenceTolerance))
+				{
+					UE_LOG(LogAnimation, Error,
+						TEXT("FootSyncBenchmark: %s %s %s mismatch (expected %d results, got %d)"),
+						*Fixture.Name, *GoldenFoot.BoneName.ToString(), *Detector->GetDetectorName(),
+						GoldenFoot.GetResults(Method).Num(), Results.Num());
+					bFixturePassed = false;
+				}
+			}
+
+			// Merge in isolation, fed with the golden per-detector results
+			FCompositeDetector Composite(Config);
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				TArray<FFootContactResult> Merged = Composite.MergeResults(
+					GoldenFoot.PelvisCrossing, GoldenFoot.VelocityCurve, GoldenFoot.Saliency, GoldenFoot.GroundHeight);
+				MergeTiming.Add(FPlatformTime::Seconds() - StartTime);
+			}
+		}
+
+		UE_LOG(LogAnimation, Display,
+			TEXT("FootSyncBenchmark: %-32s %6d frames  Pelvis %.3f/%.3f ms  Velocity %.3f/%.3f ms  Saliency %.3f/%.3f ms  Composite %.3f/%.3f ms  GroundHeight %.3f/%.3f ms  Merge %.4f/%.4f ms  %s"),
+			*Fixture.Name, Fixture.Context.GetNumFrames(),
+			DetectorTimings[0].GetMinMs(), DetectorTimings[0].GetMeanMs(),
+			DetectorTimings[1].GetMinMs(), DetectorTimings[1].GetMeanMs(),
+			DetectorTimings[2].GetMinMs(), DetectorTimings[2].GetMeanMs(),
+			DetectorTimings[3].GetMinMs(), DetectorTimings[3].GetMeanMs(),
+			DetectorTimings[4].GetMinMs(), DetectorTimings[4].GetMeanMs(),
+			MergeTiming.GetMinMs(), MergeTiming.GetMeanMs(),
+			bFixturePassed ? TEXT("OK") : TEXT("MISMATCH"));
+
+		if (!bFixturePassed)
+		{
+			++NumFailures;
+		}
+	}
+
+	UE_LOG(LogAnimation, Display,
+		TEXT("FootSyncBenchmark: %d fixtures, %d failed (timings are min/mean over %d iterations)"),
+		FixtureFiles.Num(), NumFailures, Iterations);
+
+	return NumFailures > 0 ? 1 : 0;
+}
+
+int32 UFootSyncBenchmarkCommandlet::RunAnalysis(const FString& Params, const FString& Filename) const
+{
+	int32 Iterations = DefaultIterations;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(1, Iterations);
+
+	float TimeTolerance = 1.0e-4f;
+	FParse::Value(*Params, TEXT("TimeTolerance="), TimeTolerance);
+
+	float ConfidenceTolerance = 1.0e-3f;
+	FParse::Value(*Params, TEXT("ConfidenceTolerance="), ConfidenceTolerance);
+
+	FFootSyncAnalysisFile AnalysisFile;
+	if (!AnalysisFile.Open(Filename))
+	{
+		return 1;
+	}
+
+	const FFootSyncDetectionConfig Config = FFootSyncDetectionConfig::FromProjectSettings();
+	int32 NumFailures = 0;
+
+	for (int32 ClipIndex = 0; ClipIndex < AnalysisFile.GetNumClips(); ++ClipIndex)
+	{
+		const FFootSyncAnalysisClipView Clip = AnalysisFile.GetClip(ClipIndex);
+		const FString ClipName(Clip.Name);
+
+		FFootSyncSamplingContext Context;
+		if (!AnalysisFile.MakeSamplingContext(ClipIndex, Context))
+		{
+			UE_LOG(LogAnimation, Warning, TEXT("FootSyncBenchmark: Skipping %s, no samples"), *ClipName);
+			continue;
+		}
+
+		// Detectors only read the pelvis and foot bone names of the preset
+		FLocomotionPreset Preset;
+		Preset.PelvisBoneName = Context.PelvisBoneName;
+		for (const FFootTrajectory& Trajectory : Context.Feet)
+		{
+			Preset.Feet.Add(FSyncFootDefinition(Trajectory.BoneName, NAME_None, EFootLabel::Custom));
+		}
+
+		// Gait-solved results depend on every foot at once, so they are timed but not compared
+		const bool bCompare = !EnumHasAnyFlags(Clip.Flags, EFootSyncAnalysisClipFlags::GaitSolver);
+
+		TUniquePtr<IFootContactDetector> Detector = CreateBenchmarkDetector(Clip.DetectionMethod, Config);
+		FFootSyncBenchmarkTiming Timing;
+		bool bClipPassed = true;
+
+		for (int32 FootIndex = 0; FootIndex < Clip.NumFeet; ++FootIndex)
+		{
+			const FSyncFootDefinition& Foot = Preset.Feet[FootIndex];
+
+			TArray<FFootContactResult> Results;
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				Results = Detector->DetectContacts(Context, Foot, Preset);
+				Timing.Add(FPlatformTime::Seconds() - StartTime);
+			}
+
+			if (!bCompare)
+			{
+				continue;
+			}
+
+			TArray<FFootContactResult> Expected;
+			for (const FFootSyncAnalysisResult& Result : AnalysisFile.GetFoot(ClipIndex, FootIndex).Results)
+			{
+				Expected.Add(Result.ToResult());
+			}
+
+			if (!CompareResults(Expected, Results, TimeTolerance, ConfidenceTolerance))
+			{
+				UE_LOG(LogAnimation, Error,
+					TEXT("FootSyncBenchmark: %s %s %s mismatch (expected %d results, got %d)"),
+					*ClipName, *Foot.BoneName.ToString(), *Detector->GetDetectorName(),
+					Expected.Num(), Results.Num());
+				bClipPassed = false;
+			}
+		}
+
+		UE_LOG(LogAnimation, Display,
+			TEXT("FootSyncBenchmark: %-48s %6d frames  %s %.3f/%.3f ms  %s"),
+			*ClipName, Context.GetNumFrames(), *Detector->GetDetectorName(),
+			Timing.GetMinMs(), Timing.GetMeanMs(),
+			!bCompare ? TEXT("GAIT") : bClipPassed ? TEXT("OK") : TEXT("MISMATCH"));
+
+		if (!bClipPassed)
+		{
+			++NumFailures;
+		}
+	}
+
+	UE_LOG(LogAnimation, Display,
+		TEXT("FootSyncBenchmark: %d exported clips, %d failed (timings are min/mean over %d iterations)"),
+		AnalysisFile.GetNumClips(), NumFailures, Iterations);
+
+	return NumFailures > 0 ? 1 : 0;
+}
+
+void UFootSyncBenchmarkCommandlet::ComputeGoldenResults(FFootSyncTrajectoryFixture& Fixture) const
+{
+	const FFootSyncDetectionConfig Config = FFootSyncDetectionConfig::FromProjectSettings();
+	Fixture.Feet.Reset();
+
+	for (const FSyncFootDefinition& Foot : Fixture.Preset.Feet)
+	{
+		if (!Fixture.Context.FindFoot(Foot.BoneName))
+		{
+			continue;
+		}
+
+		FFootSyncFixtureFootResults& FootResults = Fixture.Feet.AddDefaulted_GetRef();
+		FootResults.BoneName = Foot.BoneName;
+
+		for (EFootContactDetectionMethod Method : BenchmarkDetectorMethods)
+		{
+			FootResults.GetResults(Method) = CreateBenchmarkDetector(Method, Config)->DetectContacts(
+				Fixture.Context, Foot, Fixture.Preset);
+		}
+	}
+}
+
+bool UFootSyncBenchmarkCommandlet::CompareResults(
+	const TArray<FFootContactResult>& Expected,
+	const TArray<FFootContactResult>& Actual,
+	float TimeTolerance,
+	float ConfidenceTolerance) const
+{
+	if (Expected.Num() != Actual.Num())
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < Expected.Num(); ++i)
+	{
+		if (!FMath::IsNearlyEqual(Expected[i].Time, Actual[i].Time, TimeTolerance)
+			|| !FMath::IsNearlyEqual(Expected[i].Confidence, Actual[i].Confidence, ConfidenceTolerance)
+			|| Expected[i].bIsContact != Actual[i].bIsContact
+			|| Expected[i].Source != Actual[i].Source)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,84 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncCurveReduction.h"
+
+void FFootSyncCurveReduction::ReduceKeys(
+	TConstArrayView<double> Times,
+	TConstArrayView<float> Values,
+	float MaxError,
+	TArray<FRichCurveKey>& OutKeys)
+{
+	check(Times.Num() == Values.Num());
+
+	const int32 NumFrames = Times.Num();
+	OutKeys.Reset();
+
+	if (MaxError <= 0.0f || NumFrames <= 2)
+	{
+		OutKeys.Reserve(NumFrames);
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			OutKeys.Emplace(static_cast<float>(Times[i]), Values[i]);
+		}
+		return;
+	}
+
+	// Rounding moves each value by at most half a step
+	const float QuantizationStep = MaxError;
+	const float Tolerance = MaxError * 0.5f;
+
+	TArray<float> Quantized;
+	Quantized.SetNumUninitialized(NumFrames);
+	for (int32 i = 0; i < NumFrames; ++i)
+	{
+		Quantized[i] = Quantize(Values[i], QuantizationStep);
+	}
+
+	// Iterative Douglas-Peucker on the value axis: split each span at its worst frame
+	// until the line between the span ends reproduces every frame within tolerance
+	TBitArray<> bKeep(false, NumFrames);
+	bKeep[0] = true;
+	bKeep[NumFrames - 1] = true;
+
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Spans;
+	Spans.Emplace(0, NumFrames - 1);
+
+	while (Spans.Num() > 0)
+	{
+		const TPair<int32, int32> Span = Spans.Pop(EAllowShrinking::No);
+		const int32 First = Span.Key;
+		const int32 Last = Span.Value;
+
+		const double SpanTime = Times[Last] - Times[First];
+		const float FirstValue = Quantized[First];
+		const float LastValue = Quantized[Last];
+
+		float WorstError = 0.0f;
+		int32 WorstFrame = INDEX_NONE;
+		for (int32 i = First + 1; i < Last; ++i)
+		{
+			const float Alpha = SpanTime > UE_DOUBLE_KINDA_SMALL_NUMBER
+				? static_cast<float>((Times[i] - Times[First]) / SpanTime)
+				: 0.0f;
+			const float Error = FMath::Abs(FMath::Lerp(FirstValue, LastValue, Alpha) - Quantized[i]);
+			if (Error > WorstError)
+			{
+				WorstError = Error;
+				WorstFrame = i;
+			}
+		}
+
+		if (WorstFrame != INDEX_NONE && WorstError > Tolerance)
+		{
+			bKeep[WorstFrame] = true;
+			Spans.Emplace(First, WorstFrame);
+			Spans.Emplace(WorstFrame, Last);
+		}
+	}
+
+	for (TConstSetBitIterator<> It(bKeep); It; ++It)
+	{
+		FRichCurveKey& Key = OutKeys.Emplace_GetRef(static_cast<float>(Times[It.GetIndex()]), Quantized[It.GetIndex()]);
+		Key.InterpMode = RCIM_Linear;
+	}
+}
@@ -0,0 +1,86 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncDetectionCache.h"
+#include "DerivedDataCacheInterface.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Change whenever the detectors or the serialized format change, to invalidate all cached results.
+// Last changed for: ground height stance frames and coarse refinement on the dominant axis.
+#define FOOTSYNC_DETECTION_DDC_VERSION TEXT("51AAE2F72BE349AEB8ACCC80DB1E56EF")
+
+static constexpr uint32 DetectionCacheMagic = 0x46534443; // 'FSDC'
+static constexpr int32 DetectionCacheFormatVersion = 1;
+
+bool FFootSyncDetectionCache::Get(const FString& KeySuffix, TArray<FFootContactResult>& OutResults)
+{
+	TArray<uint8> Data;
+	if (!GetDerivedDataCacheRef().GetSynchronous(*BuildCacheKey(KeySuffix), Data, TEXT("FootSyncDetection")))
+	{
+		return false;
+	}
+
+	TArray<FFootContactResult> Results;
+	FMemoryReader Reader(Data);
+	if (!Serialize(Reader, Results) || Reader.IsError())
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncDetectionCache: Discarding incompatible cache entry %s"), *KeySuffix);
+		return false;
+	}
+
+	OutResults = MoveTemp(Results);
+	return true;
+}
+
+void FFootSyncDetectionCache::Put(const FString& KeySuffix, const TArray<FFootContactResult>& Results)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	Serialize(Writer, const_cast<TArray<FFootContactResult>&>(Results));
+
+	GetDerivedDataCacheRef().Put(*BuildCacheKey(KeySuffix), Data, TEXT("FootSyncDetection"));
+}
+
+bool FFootSyncDetectionCache::Serialize(FArchive& Ar, TArray<FFootContactResult>& Results)
+{
+	uint32 Magic = DetectionCacheMagic;
+	int32 FormatVersion = DetectionCacheFormatVersion;
+	Ar << Magic;
+	Ar << FormatVersion;
+
+	if (Magic != DetectionCacheMagic || FormatVersion != DetectionCacheFormatVersion)
+	{
+		return false;
+	}
+
+	int32 NumResults = Results.Num();
+	Ar << NumResults;
+
+	if (Ar.IsLoading())
+	{
+		if (NumResults < 0)
+		{
+			return false;
+		}
+		Results.SetNum(NumResults);
+	}
+
+	for (FFootContactResult& Result : Results)
+	{
+		uint8 Source = static_cast<uint8>(Result.Source);
+		Ar << Result.Time;
+		Ar << Result.Confidence;
+		Ar << Result.bIsContact;
+		Ar << Source;
+		Result.Source = static_cast<EFootContactDetectionMethod>(Source);
+	}
+
+	return true;
+}
+
+FString FFootSyncDetectionCache::BuildCacheKey(const FString& KeySuffix)
+{
+	return FDerivedDataCacheInterface::BuildCacheKey(
+		TEXT("FOOTSYNC_DETECT"), FOOTSYNC_DETECTION_DDC_VERSION, *KeySuffix);
+}
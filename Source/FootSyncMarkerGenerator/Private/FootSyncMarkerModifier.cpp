@@ -2,18 +2,36 @@
 
 #include "FootSyncMarkerModifier.h"
 #include "FootSyncMarkerSettings.h"
-#include "Detection/IFootContactDetector.h"
-#include "Detection/PelvisCrossingDetector.h"
-#include "Detection/VelocityCurveDetector.h"
-#include "Detection/SaliencyDetector.h"
-#include "Detection/CompositeDetector.h"
+#include "Detection/FootSyncDetectorRegistry.h"
+#include "Detection/QuadrupedGaitSolver.h"
+#include "Detection/StreamingDetectors.h"
+#include "Detection/FootSyncAnalysisExport.h"
+#include "FootSyncMarkerAssetUserData.h"
+#include "FootSyncDetectionCache.h"
+#include "FootSyncStats.h"
+#include "FootSyncCurveReduction.h"
 #include "AnimationBlueprintLibrary.h"
-#include "AnimPose.h"
 #include "Animation/AnimSequence.h"
+#include "Animation/AnimData/IAnimationDataModel.h"
+#include "Animation/AnimData/IAnimationDataController.h"
+#include "Animation/AnimData/CurveIdentifier.h"
+#include "Animation/Skeleton.h"
+#include "Async/ParallelFor.h"
+#include "Misc/SecureHash.h"
+#include "Misc/PackageName.h"
+#include "Framework/Application/SlateApplication.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Styling/CoreStyle.h"
 
+/** Name of the per-clip trace scope, so outlier assets can be identified in Insights */
+static FString GetClipTraceName(const FFootSyncClipStats& Stats)
+{
+	return FString::Printf(TEXT("FootSync %s (%d frames, %d feet, %s)"),
+		*FPackageName::ObjectPathToObjectName(Stats.SequencePath), Stats.NumFrames, Stats.NumFeet,
+		*StaticEnum<EFootContactDetectionMethod>()->GetNameStringByValue(static_cast<int64>(Stats.DetectionMethod)));
+}
+
 UFootSyncMarkerModifier::UFootSyncMarkerModifier()
 {
 }
@@ -38,11 +56,17 @@ void UFootSyncMarkerModifier::OnApply_Implementation(UAnimSequence* AnimationSeq
 		return;
 	}
 
+	const FFootSyncDetectionConfig Config = ResolveDetectionConfig();
+
+	// No fingerprint skip here: the framework reverts the previous application before applying,
+	// which removes the markers and the fingerprint. Only ApplyToSequences skips unchanged sequences.
+	const FString Fingerprint = ComputeFingerprint(AnimationSequence, Preset, Config);
+
 	UE_LOG(LogAnimation, Log,
 		TEXT("FootSyncMarkerModifier: Processing %s with %d feet"),
 		*AnimationSequence->GetName(), Preset.Feet.Num());
 
-	ProcessAnimation(AnimationSequence, Preset);
+	ProcessAnimation(AnimationSequence, Preset, Config, Fingerprint);
 }
 
 void UFootSyncMarkerModifier::OnRevert_Implementation(UAnimSequence* AnimationSequence)
@@ -55,25 +79,331 @@ void UFootSyncMarkerModifier::OnRevert_Implementation(UAnimSequence* AnimationSe
 	FLocomotionPreset Preset = GetEffectivePreset(AnimationSequence);
 	RemoveGeneratedData(AnimationSequence, Preset);
 
+	// Generated data is gone, the next apply must run detection again
+	AnimationSequence->RemoveUserDataOfClass(UFootSyncMarkerAssetUserData::StaticClass());
+
 	UE_LOG(LogAnimation, Log,
 		TEXT("FootSyncMarkerModifier: Reverted %s"),
 		*AnimationSequence->GetName());
 }
 
+void UFootSyncMarkerModifier::ApplyToSequences(const TArray<UAnimSequence*>& AnimSequences)
+{
+	check(IsInGameThread());
+
+	// Settings are resolved once, detection only reads this snapshot
+	const FFootSyncDetectionConfig Config = ResolveDetectionConfig();
+
+	TArray<FFootSyncSequenceJob> Jobs;
+	int32 NumSkipped = 0;
+	LastBatchStats.Reset();
+
+	GatherJobs(AnimSequences, Config, true, true, Jobs, NumSkipped);
+
+	UE_LOG(LogAnimation, Log,
+		TEXT("FootSyncMarkerModifier: Batch processing %d of %d sequences (%d unchanged)"),
+		Jobs.Num(), AnimSequences.Num(), NumSkipped);
+
+	DetectJobs(Jobs, Config);
+
+	// Commit: marker and curve writes stay serialized on the game thread
+	LastBatchStats.Reserve(Jobs.Num());
+	for (FFootSyncSequenceJob& Job : Jobs)
+	{
+		CommitSequenceJob(Job);
+		LastBatchStats.Add(Job.Stats);
+	}
+	LastBatchNumSkipped = NumSkipped;
+
+	if (Jobs.Num() > 0)
+	{
+		FFootSyncBatchReport::LogSummary(LastBatchStats, NumSkipped, BatchSummaryOutliers);
+	}
+}
+
+void UFootSyncMarkerModifier::ExportSequences(const TArray<UAnimSequence*>& AnimSequences, FFootSyncAnalysisWriter& Writer)
+{
+	check(IsInGameThread());
+
+	if (!Writer.IsOpen())
+	{
+		return;
+	}
+
+	const FFootSyncDetectionConfig Config = ResolveDetectionConfig();
+
+	// Exports cover every sequence, whether or not its fingerprint changed
+	TArray<FFootSyncSequenceJob> Jobs;
+	int32 NumSkipped = 0;
+	LastBatchStats.Reset();
+	LastBatchNumSkipped = 0;
+
+	GatherJobs(AnimSequences, Config, false, false, Jobs, NumSkipped);
+
+	UE_LOG(LogAnimation, Log,
+		TEXT("FootSyncMarkerModifier: Exporting %d of %d sequences"),
+		Jobs.Num(), AnimSequences.Num());
+
+	DetectJobs(Jobs, Config);
+
+	// Nothing is committed, the sequences are left untouched
+	LastBatchStats.Reserve(Jobs.Num());
+	for (FFootSyncSequenceJob& Job : Jobs)
+	{
+		// Exports carry every signal, whichever the detector read
+		Job.Context.ComputeSignals(EFootSyncTrajectorySignals::All);
+
+		TMap<FName, TArray<FFootContactResult>> Results;
+		for (const FFootSyncFootMarkers& Markers : Job.Feet)
+		{
+			Results.Add(Markers.Foot.BoneName, Markers.Results);
+		}
+
+		Writer.AddClip(Job.AnimSequence->GetPathName(), Job.Context, Job.Config.DetectionMethod, Job.bGaitSolved, Results);
+		LastBatchStats.Add(Job.Stats);
+	}
+}
+
+void UFootSyncMarkerModifier::GatherJobs(
+	const TArray<UAnimSequence*>& AnimSequences,
+	const FFootSyncDetectionConfig& Config,
+	bool bSkipUpToDate,
+	bool bAllowStreaming,
+	TArray<FFootSyncSequenceJob>& OutJobs,
+	int32& OutNumSkipped) const
+{
+	// Sample trajectories on the game thread (pose evaluation touches UObjects)
+	OutJobs.Reserve(OutJobs.Num() + AnimSequences.Num());
+
+	for (UAnimSequence* AnimSequence : AnimSequences)
+	{
+		if (!AnimSequence)
+		{
+			continue;
+		}
+
+		FLocomotionPreset Preset = GetEffectivePreset(AnimSequence);
+		if (!Preset.IsValid())
+		{
+			UE_LOG(LogAnimation, Warning,
+				TEXT("FootSyncMarkerModifier: Could not create valid preset for %s. "
+					 "Check bone patterns in settings or use Custom preset."),
+				*AnimSequence->GetName());
+			continue;
+		}
+
+		const FString Fingerprint = ComputeFingerprint(AnimSequence, Preset, Config);
+		if (bSkipUpToDate && IsUpToDate(AnimSequence, Fingerprint))
+		{
+			++OutNumSkipped;
+			continue;
+		}
+
+		FFootSyncSequenceJob Job;
+		if (PrepareSequenceJob(AnimSequence, Preset, Config, Job, bAllowStreaming))
+		{
+			Job.Fingerprint = Fingerprint;
+			OutJobs.Add(MoveTemp(Job));
+		}
+	}
+}
+
+void UFootSyncMarkerModifier::DetectJobs(TArray<FFootSyncSequenceJob>& Jobs, const FFootSyncDetectionConfig& Config) const
+{
+	if (Jobs.Num() == 0)
+	{
+		return;
+	}
+
+	// Optionally find the candidate frames of the whole batch on the GPU
+	if (Config.bUseGpuTrajectoryAnalysis)
+	{
+		AnalyzeJobsOnGpu(Jobs);
+	}
+
+	// Pure computation on sampled trajectories, one task per sequence
+	ParallelFor(Jobs.Num(), [this, &Jobs](int32 JobIndex)
+	{
+		RunDetection(Jobs[JobIndex]);
+	});
+}
+
+void UFootSyncMarkerModifier::AnalyzeJobsOnGpu(TArray<FFootSyncSequenceJob>& Jobs) const
+{
+	if (!FFootSyncGpuDetection::IsAvailable())
+	{
+		UE_LOG(LogAnimation, Log,
+			TEXT("FootSyncMarkerModifier: GPU trajectory analysis unavailable, detecting on the CPU"));
+		return;
+	}
+
+	// Gait-solved quadrupeds detect on trajectory slices, the kernels do not wrap cyclic
+	// sequences and registered detectors, ground height and the tiered composite have no GPU
+	// counterpart, all stay on the CPU. Streamed takes are already detected.
+	TArray<const FFootSyncSamplingContext*> Contexts;
+	Contexts.Reserve(Jobs.Num());
+	for (const FFootSyncSequenceJob& Job : Jobs)
+	{
+		const bool bGaitSolver = Job.Config.bUseQuadrupedGaitSolver && Job.Preset.Type == ELocomotionType::Quadruped;
+		const bool bCustomDetector = !Job.Config.CustomDetector.IsNone();
+		const bool bGroundHeight = Job.Config.DetectionMethod == EFootContactDetectionMethod::GroundHeight
+			|| (Job.Config.DetectionMethod == EFootContactDetectionMethod::Composite
+				&& Job.Config.CompositeWeights.GroundHeightWeight > KINDA_SMALL_NUMBER);
+		const bool bTieredComposite = Job.Config.DetectionMethod == EFootContactDetectionMethod::Composite
+			&& Job.Config.bTieredComposite && Job.Config.CompositeWeights.SaliencyWeight > KINDA_SMALL_NUMBER;
+		Contexts.Add(bGaitSolver || bCustomDetector || bGroundHeight || bTieredComposite || Job.Context.bCyclic || Job.bStreamed
+			? nullptr : &Job.Context);
+	}
+
+	TArray<FFootSyncGpuSignals> Signals;
+	if (!FFootSyncGpuDetection::Analyze(Contexts, Jobs[0].Config, Signals))
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncMarkerModifier: GPU trajectory analysis failed, detecting on the CPU"));
+		return;
+	}
+
+	for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+	{
+		Jobs[JobIndex].GpuSignals = MoveTemp(Signals[JobIndex]);
+	}
+}
+
 void UFootSyncMarkerModifier::ProcessAnimation(
-	UAnimSequence* AnimSequence, const FLocomotionPreset& Preset)
+	UAnimSequence* AnimSequence,
+	const FLocomotionPreset& Preset,
+	const FFootSyncDetectionConfig& Config,
+	const FString& Fingerprint)
 {
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
+	FFootSyncSequenceJob Job;
+	if (!PrepareSequenceJob(AnimSequence, Preset, Config, Job))
+	{
+		return;
+	}
+	Job.Fingerprint = Fingerprint;
 
-	// Ensure the sync marker track exists
-	if (!UAnimationBlueprintLibrary::IsValidAnimNotifyTrackName(AnimSequence, Settings->SyncMarkerTrackName))
+	RunDetection(Job);
+	CommitSequenceJob(Job);
+
+	UE_LOG(LogAnimation, Log,
+		TEXT("FootSyncMarkerModifier: %s took %.1f ms (sample %.1f, detect %.1f, commit %.1f)"),
+		*AnimSequence->GetName(), Job.Stats.GetTotalSeconds() * 1000.0, Job.Stats.SampleSeconds * 1000.0,
+		Job.Stats.DetectSeconds * 1000.0, Job.Stats.CommitSeconds * 1000.0);
+}
+
+bool UFootSyncMarkerModifier::PrepareSequenceJob(
+	UAnimSequence* AnimSequence,
+	const FLocomotionPreset& Preset,
+	const FFootSyncDetectionConfig& Config,
+	FFootSyncSequenceJob& OutJob,
+	bool bAllowStreaming) const
+{
+	OutJob.AnimSequence = AnimSequence;
+	OutJob.Preset = Preset;
+	OutJob.Config = Config;
+	OutJob.Feet.Reset();
+	OutJob.bStreamed = false;
+	OutJob.StreamedTimes.Reset();
+	OutJob.StreamedCurves.Reset();
+
+	OutJob.Stats = FFootSyncClipStats();
+	OutJob.Stats.SequencePath = AnimSequence->GetPathName();
+	OutJob.Stats.LocomotionType = Preset.Type;
+	OutJob.Stats.DetectionMethod = Config.DetectionMethod;
+	OutJob.Stats.NumFeet = Preset.Feet.Num();
+
+	// Detection results only depend on the source tracks and the detector configuration
+	const FString SourceDataHash = ComputeSourceDataHash(AnimSequence, Preset);
+	OutJob.DetectionCacheKey = SourceDataHash.IsEmpty()
+		? FString()
+		: SourceDataHash + TEXT("_") + ComputeDetectionConfigHash(Preset, Config);
+
+	// Long takes are detected chunk by chunk instead of being sampled whole
+	int32 NumKeys = 0;
+	UAnimationBlueprintLibrary::GetNumKeys(AnimSequence, NumKeys);
+	if (bAllowStreaming && ShouldStream(OutJob, NumKeys))
 	{
-		UAnimationBlueprintLibrary::AddAnimationNotifyTrack(
-			AnimSequence, Settings->SyncMarkerTrackName, FLinearColor::Green);
+		return StreamSequenceJob(OutJob);
 	}
 
-	// Process each foot
-	for (const FSyncFootDefinition& Foot : Preset.Feet)
+	// Sample the sequence once, shared by all feet, detectors and curve passes
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bSampled = OutJob.Context.Initialize(AnimSequence, Preset, Config.Sampling);
+	OutJob.Stats.SampleSeconds = FPlatformTime::Seconds() - StartTime;
+
+	if (!bSampled)
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncMarkerModifier: Failed to sample %s"),
+			*AnimSequence->GetName());
+		return false;
+	}
+
+	OutJob.Stats.NumFrames = OutJob.Context.GetNumFrames();
+	OutJob.Stats.NumEvaluatedFrames = OutJob.Context.NumEvaluatedFrames;
+
+	return true;
+}
+
+bool UFootSyncMarkerModifier::ShouldStream(const FFootSyncSequenceJob& Job, int32 NumKeys) const
+{
+	const FFootSyncDetectionConfig& Config = Job.Config;
+	if (Config.StreamingMinFrames <= 0 || NumKeys < Config.StreamingMinFrames)
+	{
+		return false;
+	}
+
+	// The gait solver and the settings FFootSyncStreamingDetection cannot stream need the whole take
+	const bool bGaitSolver = Config.bUseQuadrupedGaitSolver && Job.Preset.Type == ELocomotionType::Quadruped;
+	if (bGaitSolver || !FFootSyncStreamingDetection::SupportsConfig(Config))
+	{
+		UE_LOG(LogAnimation, Log,
+			TEXT("FootSyncMarkerModifier: %s has %d keys but its detection settings need the whole take, sampling it at once"),
+			*Job.AnimSequence->GetName(), NumKeys);
+		return false;
+	}
+
+	return true;
+}
+
+bool UFootSyncMarkerModifier::StreamSequenceJob(FFootSyncSequenceJob& Job) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const bool bGenerateCurves = bGenerateDistanceCurves || bGenerateVelocityCurves;
+	if (bGenerateCurves)
+	{
+		for (const FSyncFootDefinition& Foot : Job.Preset.Feet)
+		{
+			Job.StreamedCurves.AddDefaulted_GetRef().BoneName = Foot.BoneName;
+		}
+	}
+
+	// Chunks are discarded once detected, only the curve values are kept
+	TMap<FName, TArray<FFootContactResult>> Results;
+	const bool bDetected = FFootSyncStreamingDetection::DetectContacts(
+		Job.AnimSequence, Job.Preset, Job.Config, Job.Config.StreamingChunkFrames, Results,
+		[this, &Job, bGenerateCurves](const FFootSyncSamplingContext& Chunk)
+		{
+			if (bGenerateCurves)
+			{
+				Job.StreamedTimes.Append(Chunk.Times);
+				for (FFootSyncCurveValues& Values : Job.StreamedCurves)
+				{
+					AppendCurveValues(Chunk, Job.Preset, Values);
+				}
+			}
+		});
+
+	if (!bDetected)
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncMarkerModifier: Failed to stream %s"),
+			*Job.AnimSequence->GetName());
+		return false;
+	}
+
+	for (const FSyncFootDefinition& Foot : Job.Preset.Feet)
 	{
 		if (Foot.BoneName.IsNone())
 		{
@@ -82,119 +412,381 @@ void UFootSyncMarkerModifier::ProcessAnimation(
 			continue;
 		}
 
-		// Detect foot contacts
-		TArray<FFootContactResult> Results = DetectFootContacts(AnimSequence, Foot, Preset);
+		FFootSyncFootMarkers& Markers = Job.Feet.AddDefaulted_GetRef();
+		Markers.Foot = Foot;
+		if (TArray<FFootContactResult>* FootResults = Results.Find(Foot.BoneName))
+		{
+			SelectMarkers(*FootResults, Job.Config, Markers);
+			Markers.Results = MoveTemp(*FootResults);
+		}
+	}
+
+	int32 NumKeys = 0;
+	UAnimationBlueprintLibrary::GetNumKeys(Job.AnimSequence, NumKeys);
+
+	Job.bStreamed = true;
+	Job.Stats.NumFeet = Job.Feet.Num();
+	Job.Stats.NumFrames = NumKeys;
+	Job.Stats.NumEvaluatedFrames = NumKeys;
+	Job.Stats.DetectSeconds = FPlatformTime::Seconds() - StartTime;
+
+	return true;
+}
+
+void UFootSyncMarkerModifier::RunDetection(FFootSyncSequenceJob& Job) const
+{
+	// Streamed takes were detected while they were sampled
+	if (Job.bStreamed)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*GetClipTraceName(Job.Stats), FootSyncChannel);
+	const double StartTime = FPlatformTime::Seconds();
 
-		// Filter contact points only
-		TArray<FFootContactResult> ContactResults;
-		for (const FFootContactResult& Result : Results)
+	TArray<const FSyncFootDefinition*> ValidFeet;
+	ValidFeet.Reserve(Job.Preset.Feet.Num());
+
+	for (const FSyncFootDefinition& Foot : Job.Preset.Feet)
+	{
+		if (Foot.BoneName.IsNone())
 		{
-			if (Result.bIsContact)
-			{
-				ContactResults.Add(Result);
-			}
+			UE_LOG(LogAnimation, Warning,
+				TEXT("FootSyncMarkerModifier: Skipping foot with empty bone name"));
+			continue;
 		}
 
-		// Sort by confidence (descending)
-		ContactResults.Sort([](const FFootContactResult& A, const FFootContactResult& B)
+		ValidFeet.Add(&Foot);
+	}
+
+	Job.Feet.Reset();
+	Job.Feet.SetNum(ValidFeet.Num());
+
+	// One detector serves every foot, and the signals it reads are computed once for all feet
+	const FFootSyncDetectorRegistration Registration = FFootSyncDetectorRegistry::Get().Resolve(Job.Config);
+	Job.Detector = Registration.Factory ? Registration.Factory(Job.Config) : nullptr;
+	if (!Job.Detector)
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncMarkerModifier: Failed to create detector %s"),
+			*Registration.Name.ToString());
+	}
+	else if (!Job.GpuSignals.IsValid())
+	{
+		Job.Context.ComputeSignals(Registration.Signals);
+	}
+
+	// Quadrupeds share work across the feet through the gait cycle
+	Job.bGaitSolved = Job.Config.bUseQuadrupedGaitSolver
+		&& Job.Preset.Type == ELocomotionType::Quadruped
+		&& DetectGaitMarkers(Job, ValidFeet);
+
+	if (!Job.bGaitSolved)
+	{
+		// Feet are independent, detect them concurrently
+		ParallelFor(ValidFeet.Num(), [this, &Job, &ValidFeet](int32 FootIndex)
 		{
-			return A.Confidence > B.Confidence;
+			Job.Feet[FootIndex] = DetectFootMarkers(Job, *ValidFeet[FootIndex]);
 		});
+	}
+
+	Job.Stats.NumFeet = Job.Feet.Num();
+	Job.Stats.NumCacheHits = 0;
+	for (const FFootSyncFootMarkers& Markers : Job.Feet)
+	{
+		Job.Stats.NumCacheHits += Markers.bFromCache ? 1 : 0;
+	}
+	if (Job.Detector)
+	{
+		Job.Detector->AddClipStats(Job.Stats);
+	}
+	Job.Stats.DetectSeconds = FPlatformTime::Seconds() - StartTime;
+}
 
-		// Select top N by confidence (if MaxMarkersPerFoot > 0)
-		const int32 MaxMarkers = GetEffectiveMaxMarkersPerFoot();
-		if (MaxMarkers > 0 && ContactResults.Num() > MaxMarkers)
+FFootSyncFootMarkers UFootSyncMarkerModifier::DetectFootMarkers(
+	const FFootSyncSequenceJob& Job,
+	const FSyncFootDefinition& Foot) const
+{
+	const FFootSyncDetectionConfig& Config = Job.Config;
+
+	FFootSyncFootMarkers Markers;
+	Markers.Foot = Foot;
+
+	// Detect foot contacts, reusing results from the shared Derived Data Cache when available
+	TArray<FFootContactResult> Results;
+	const bool bUseCache = Config.bUseDerivedDataCache && !Job.DetectionCacheKey.IsEmpty();
+	const FString CacheKey = bUseCache
+		? Job.DetectionCacheKey + TEXT("_") + Foot.BoneName.ToString()
+		: FString();
+
+	Markers.bFromCache = bUseCache && FFootSyncDetectionCache::Get(CacheKey, Results);
+	if (!Markers.bFromCache)
+	{
+		const bool bFromGpu = Job.GpuSignals.IsValid()
+			&& FFootSyncGpuDetection::DetectContacts(Job.GpuSignals, Job.Context, Foot, Job.Preset, Config, Results);
+
+		if (!bFromGpu)
 		{
-			ContactResults.SetNum(MaxMarkers);
+			Results = DetectFootContacts(Job, Job.Context, Foot);
 		}
 
-		// Filter by confidence threshold
-		const float MinConfidence = GetEffectiveMinimumConfidence();
-		TArray<FFootContactResult> ConfidentResults;
-		for (const FFootContactResult& Result : ContactResults)
+		// The cache only holds CPU reference results
+		if (bUseCache && !bFromGpu)
 		{
-			if (Result.Confidence > MinConfidence)
+			FFootSyncDetectionCache::Put(CacheKey, Results);
+		}
+	}
+
+	SelectMarkers(Results, Config, Markers);
+	Markers.Results = MoveTemp(Results);
+
+	return Markers;
+}
+
+bool UFootSyncMarkerModifier::DetectGaitMarkers(
+	FFootSyncSequenceJob& Job,
+	TConstArrayView<const FSyncFootDefinition*> Feet) const
+{
+	const FFootSyncDetectionConfig& Config = Job.Config;
+	const bool bUseCache = Config.bUseDerivedDataCache && !Job.DetectionCacheKey.IsEmpty();
+
+	auto GetCacheKey = [&Job](const FSyncFootDefinition& Foot)
+	{
+		return Job.DetectionCacheKey + TEXT("_") + Foot.BoneName.ToString();
+	};
+
+	// Feet depend on each other, so the cache is only used when every foot hits
+	TMap<FName, TArray<FFootContactResult>> Results;
+	bool bFromCache = bUseCache;
+	for (int32 FootIndex = 0; bFromCache && FootIndex < Feet.Num(); ++FootIndex)
+	{
+		bFromCache = FFootSyncDetectionCache::Get(GetCacheKey(*Feet[FootIndex]), Results.FindOrAdd(Feet[FootIndex]->BoneName));
+	}
+
+	if (!bFromCache)
+	{
+		const FQuadrupedGaitSolver Solver(Config);
+		const bool bSolved = Solver.Solve(Job.Context, Job.Preset,
+			[this, &Job](const FFootSyncSamplingContext& Context, const FSyncFootDefinition& Foot)
 			{
-				ConfidentResults.Add(Result);
+				return DetectFootContacts(Job, Context, Foot);
+			},
+			Results);
+
+		if (!bSolved)
+		{
+			return false;
+		}
+
+		if (bUseCache)
+		{
+			for (const FSyncFootDefinition* Foot : Feet)
+			{
+				if (const TArray<FFootContactResult>* FootResults = Results.Find(Foot->BoneName))
+				{
+					FFootSyncDetectionCache::Put(GetCacheKey(*Foot), *FootResults);
+				}
 			}
 		}
+	}
+
+	for (int32 FootIndex = 0; FootIndex < Feet.Num(); ++FootIndex)
+	{
+		FFootSyncFootMarkers& Markers = Job.Feet[FootIndex];
+		Markers.Foot = *Feet[FootIndex];
+		Markers.bFromCache = bFromCache;
+
+		if (const TArray<FFootContactResult>* FootResults = Results.Find(Feet[FootIndex]->BoneName))
+		{
+			SelectMarkers(*FootResults, Config, Markers);
+			Markers.Results = *FootResults;
+		}
+		else
+		{
+			// Feet beyond the four gait feet are detected independently
+			Markers = DetectFootMarkers(Job, *Feet[FootIndex]);
+		}
+	}
+
+	return true;
+}
+
+void UFootSyncMarkerModifier::SelectMarkers(
+	const TArray<FFootContactResult>& Results,
+	const FFootSyncDetectionConfig& Config,
+	FFootSyncFootMarkers& Markers) const
+{
+	// Filter contact points only
+	TArray<FFootContactResult> ContactResults;
+	for (const FFootContactResult& Result : Results)
+	{
+		if (Result.bIsContact)
+		{
+			ContactResults.Add(Result);
+		}
+	}
+
+	// Sort by confidence (descending)
+	ContactResults.Sort([](const FFootContactResult& A, const FFootContactResult& B)
+	{
+		return A.Confidence > B.Confidence;
+	});
+
+	// Select top N by confidence (if MaxMarkersPerFoot > 0)
+	const int32 MaxMarkers = Config.MaxMarkersPerFoot;
+	if (MaxMarkers > 0 && ContactResults.Num() > MaxMarkers)
+	{
+		ContactResults.SetNum(MaxMarkers);
+	}
+
+	// Filter by confidence threshold
+	const float MinConfidence = Config.MinimumConfidence;
+	TArray<FFootContactResult> ConfidentResults;
+	for (const FFootContactResult& Result : ContactResults)
+	{
+		if (Result.Confidence > MinConfidence)
+		{
+			ConfidentResults.Add(Result);
+		}
+	}
+
+	// Guarantee minimum one if enabled
+	if (ConfidentResults.Num() == 0 && Config.bGuaranteeMinimumOne && ContactResults.Num() > 0)
+	{
+		ConfidentResults.Add(ContactResults[0]);  // Best confidence one
+		Markers.FallbackConfidence = ContactResults[0].Confidence;
+	}
+
+	// Sort by time for interval filtering
+	ConfidentResults.Sort([](const FFootContactResult& A, const FFootContactResult& B)
+	{
+		return A.Time < B.Time;
+	});
+
+	// Remove duplicates within minimum interval
+	for (const FFootContactResult& Result : ConfidentResults)
+	{
+		if (Markers.MarkerTimes.Num() == 0 ||
+			(Result.Time - Markers.MarkerTimes.Last()) > Config.MinimumMarkerInterval)
+		{
+			Markers.MarkerTimes.Add(Result.Time);
+		}
+	}
+
+	Markers.NumContacts = ContactResults.Num();
+	Markers.NumConfident = ConfidentResults.Num();
+}
+
+void UFootSyncMarkerModifier::CommitSequenceJob(FFootSyncSequenceJob& Job)
+{
+	check(IsInGameThread());
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*GetClipTraceName(Job.Stats), FootSyncChannel);
+	const double StartTime = FPlatformTime::Seconds();
+
+	UAnimSequence* AnimSequence = Job.AnimSequence;
+	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
+
+	// Ensure the sync marker track exists
+	if (!UAnimationBlueprintLibrary::IsValidAnimNotifyTrackName(AnimSequence, Settings->SyncMarkerTrackName))
+	{
+		UAnimationBlueprintLibrary::AddAnimationNotifyTrack(
+			AnimSequence, Settings->SyncMarkerTrackName, FLinearColor::Green);
+	}
 
-		// Guarantee minimum one if enabled
-		if (ConfidentResults.Num() == 0 && GetEffectiveGuaranteeMinimumOne() && ContactResults.Num() > 0)
+	// One controller bracket for all curve writes, so listeners are notified once per sequence
+	IAnimationDataController& Controller = AnimSequence->GetController();
+	IAnimationDataController::FScopedBracket Bracket(Controller,
+		NSLOCTEXT("FootSyncMarker", "CommitFootSyncData", "Generate Foot Sync Markers"));
+
+	AnimSequence->Modify();
+
+	// Batch applies have no revert before them, so clear the markers of the previous application.
+	// Curves are rewritten in place, only those no longer generated are removed.
+	UAnimationBlueprintLibrary::RemoveAnimationSyncMarkersByTrack(AnimSequence, Settings->SyncMarkerTrackName);
+
+	TArray<FName> GeneratedCurves;
+	for (const FFootSyncFootMarkers& Markers : Job.Feet)
+	{
+		FName DistanceCurveName;
+		FName VelocityCurveName;
+		GetCurveNames(Markers.Foot, DistanceCurveName, VelocityCurveName);
+		if (bGenerateDistanceCurves)
 		{
-			ConfidentResults.Add(ContactResults[0]);  // Best confidence one
+			GeneratedCurves.AddUnique(DistanceCurveName);
+		}
+		if (bGenerateVelocityCurves)
+		{
+			GeneratedCurves.AddUnique(VelocityCurveName);
+		}
+	}
+	RemoveStaleCurves(AnimSequence, GeneratedCurves);
 
+	for (const FFootSyncFootMarkers& Markers : Job.Feet)
+	{
+		const FSyncFootDefinition& Foot = Markers.Foot;
+
+		if (Markers.FallbackConfidence >= 0.0f && ShouldShowNotifications())
+		{
 			// Show notification instead of blocking dialog
 			FNotificationInfo Info(FText::Format(
 				NSLOCTEXT("FootSyncMarker", "LowConfidenceWarning",
 					"Foot {0}: No contacts above threshold, using best confidence ({1})"),
 				FText::FromName(Foot.BoneName),
-				FText::AsNumber(ContactResults[0].Confidence)));
+				FText::AsNumber(Markers.FallbackConfidence)));
 			Info.ExpireDuration = 3.0f;
 			Info.bUseSuccessFailIcons = true;
 			Info.Image = FCoreStyle::Get().GetBrush(TEXT("Icons.WarningWithColor"));
 			FSlateNotificationManager::Get().AddNotification(Info);
 		}
 
-		// Sort by time for interval filtering
-		ConfidentResults.Sort([](const FFootContactResult& A, const FFootContactResult& B)
-		{
-			return A.Time < B.Time;
-		});
-
-		// Remove duplicates within minimum interval
-		TArray<float> FilteredTimes;
-		for (const FFootContactResult& Result : ConfidentResults)
-		{
-			if (FilteredTimes.Num() == 0 ||
-				(Result.Time - FilteredTimes.Last()) > Settings->MinimumMarkerInterval)
-			{
-				FilteredTimes.Add(Result.Time);
-			}
-		}
-
 		UE_LOG(LogAnimation, Log,
 			TEXT("  Foot %s: detected %d contacts, confident %d, filtered to %d markers"),
-			*Foot.BoneName.ToString(), ContactResults.Num(), ConfidentResults.Num(), FilteredTimes.Num());
+			*Foot.BoneName.ToString(), Markers.NumContacts, Markers.NumConfident, Markers.MarkerTimes.Num());
 
 		// Add sync markers
-		AddSyncMarkers(AnimSequence, Foot, FilteredTimes);
+		AddSyncMarkers(AnimSequence, Foot, Markers.MarkerTimes);
 
 		// Generate curves if enabled
 		if (bGenerateDistanceCurves || bGenerateVelocityCurves)
 		{
-			GenerateCurves(AnimSequence, Foot, Preset);
+			if (!Job.bStreamed)
+			{
+				GenerateCurves(AnimSequence, Job.Context, Foot, Job.Preset);
+			}
+			else if (const FFootSyncCurveValues* Values = Job.StreamedCurves.FindByPredicate(
+				[&Foot](const FFootSyncCurveValues& Curve) { return Curve.BoneName == Foot.BoneName; }))
+			{
+				WriteCurves(AnimSequence, Job.StreamedTimes, Foot, *Values);
+			}
 		}
 	}
+
+	// Rebuild the sync marker and notify data once for all feet
+	AnimSequence->RefreshSyncMarkerDataFromAuthored();
+	AnimSequence->RefreshCacheData();
+	AnimSequence->MarkPackageDirty();
+
+	StoreFingerprint(AnimSequence, Job.Fingerprint, GeneratedCurves);
+
+	Job.Stats.NumMarkers = 0;
+	for (const FFootSyncFootMarkers& Markers : Job.Feet)
+	{
+		Job.Stats.NumMarkers += Markers.MarkerTimes.Num();
+	}
+	Job.Stats.CommitSeconds = FPlatformTime::Seconds() - StartTime;
+	INC_DWORD_STAT(STAT_FootSync_ClipsProcessed);
 }
 
 TArray<FFootContactResult> UFootSyncMarkerModifier::DetectFootContacts(
-	UAnimSequence* AnimSequence,
-	const FSyncFootDefinition& Foot,
-	const FLocomotionPreset& Preset)
+	const FFootSyncSequenceJob& Job,
+	const FFootSyncSamplingContext& Context,
+	const FSyncFootDefinition& Foot) const
 {
-	EFootContactDetectionMethod Method = GetEffectiveDetectionMethod();
-
-	TUniquePtr<IFootContactDetector> Detector = CreateDetector(Method);
-	if (Detector)
+	if (Job.Detector)
 	{
-		// Apply per-animation threshold overrides
-		if (bOverrideVelocityThreshold)
-		{
-			Detector->SetVelocityThreshold(VelocityThresholdOverride);
-		}
-		if (bOverrideSaliencyThreshold)
-		{
-			Detector->SetSaliencyThreshold(SaliencyThresholdOverride);
-		}
-
-		return Detector->DetectContacts(AnimSequence, Foot, Preset);
+		return Job.Detector->DetectContacts(Context, Foot, Job.Preset);
 	}
 
-	UE_LOG(LogAnimation, Warning,
-		TEXT("FootSyncMarkerModifier: Failed to create detector for method %d"),
-		static_cast<int32>(Method));
-
 	return TArray<FFootContactResult>();
 }
 
@@ -203,149 +795,163 @@ void UFootSyncMarkerModifier::AddSyncMarkers(
 	const FSyncFootDefinition& Foot,
 	const TArray<float>& ContactTimes)
 {
+	FOOTSYNC_SCOPE(AddSyncMarkers);
+
 	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
 
+	const int32 TrackIndex = AnimSequence->AnimNotifyTracks.IndexOfByPredicate(
+		[&Settings](const FAnimNotifyTrack& Track)
+		{
+			return Track.TrackName == Settings->SyncMarkerTrackName;
+		});
+
+	if (TrackIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Append directly, the caller refreshes the marker data once per sequence
+	AnimSequence->AuthoredSyncMarkers.Reserve(AnimSequence->AuthoredSyncMarkers.Num() + ContactTimes.Num());
+	const float PlayLength = AnimSequence->GetPlayLength();
 	for (float Time : ContactTimes)
 	{
-		UAnimationBlueprintLibrary::AddAnimationSyncMarker(
-			AnimSequence,
-			Foot.MarkerName,
-			Time,
-			Settings->SyncMarkerTrackName
-		);
+		if (Time < 0.0f || Time > PlayLength)
+		{
+			continue;
+		}
+
+		FAnimSyncMarker& SyncMarker = AnimSequence->AuthoredSyncMarkers.AddDefaulted_GetRef();
+		SyncMarker.MarkerName = Foot.MarkerName;
+		SyncMarker.Time = Time;
+#if WITH_EDITORONLY_DATA
+		SyncMarker.TrackIndex = TrackIndex;
+		SyncMarker.Guid = FGuid::NewGuid();
+#endif
 	}
 }
 
 void UFootSyncMarkerModifier::GenerateCurves(
 	UAnimSequence* AnimSequence,
+	const FFootSyncSamplingContext& Context,
 	const FSyncFootDefinition& Foot,
 	const FLocomotionPreset& Preset)
 {
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-
-	// Get animation length and frame count
-	float SequenceLength;
-	UAnimationBlueprintLibrary::GetSequenceLength(AnimSequence, SequenceLength);
+	FOOTSYNC_SCOPE(GenerateCurves);
 
-	int32 NumKeys;
-	UAnimationBlueprintLibrary::GetNumKeys(AnimSequence, NumKeys);
-
-	if (NumKeys <= 1)
+	if (!Context.IsValid() || Context.GetNumFrames() <= 1 || !Context.FindFoot(Foot.BoneName))
 	{
 		return;
 	}
 
-	// Evaluate poses at each frame
-	TArray<double> TimeIntervals;
-	for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
+	FFootSyncCurveValues Values;
+	Values.BoneName = Foot.BoneName;
+	AppendCurveValues(Context, Preset, Values);
+
+	// The first frame of a cycle is reached by the step into the last frame
+	if (Context.bCyclic && Values.Velocities.Num() >= 3)
 	{
-		float Time;
-		UAnimationBlueprintLibrary::GetTimeAtFrame(AnimSequence, KeyIndex, Time);
-		TimeIntervals.Add(static_cast<double>(Time));
+		Values.Velocities[0] = Values.Velocities.Last();
 	}
 
-	TArray<FAnimPose> Poses;
-	FAnimPoseEvaluationOptions Options;
-	Options.EvaluationType = EAnimDataEvalType::Source;
-
-	UAnimPoseExtensions::GetAnimPoseAtTimeIntervals(AnimSequence, TimeIntervals, Options, Poses);
+	WriteCurves(AnimSequence, Context.Times, Foot, Values);
+}
 
-	// Calculate distances and velocities
-	TArray<float> Times;
-	TArray<float> Distances;
-	TArray<float> Velocities;
+void UFootSyncMarkerModifier::AppendCurveValues(
+	const FFootSyncSamplingContext& Context,
+	const FLocomotionPreset& Preset,
+	FFootSyncCurveValues& Values) const
+{
+	const FFootTrajectory* FootTrajectory = Context.FindFoot(Values.BoneName);
+	if (!FootTrajectory)
+	{
+		return;
+	}
 
-	FVector PrevPosition = FVector::ZeroVector;
-	float PrevTime = 0.0f;
+	const TArray<double>& TimeIntervals = Context.Times;
+	Values.Distances.Reserve(Values.Distances.Num() + TimeIntervals.Num());
+	Values.Velocities.Reserve(Values.Velocities.Num() + TimeIntervals.Num());
 
-	for (int32 i = 0; i < Poses.Num(); ++i)
+	for (int32 i = 0; i < TimeIntervals.Num(); ++i)
 	{
 		float CurrentTime = static_cast<float>(TimeIntervals[i]);
-		Times.Add(CurrentTime);
 
-		// Get relative transform from pelvis to foot
-		FTransform RelativeTransform = UAnimPoseExtensions::GetRelativeTransform(
-			Poses[i], Preset.PelvisBoneName, Foot.BoneName, EAnimPoseSpaces::World);
-
-		FVector CurrentPosition = RelativeTransform.GetLocation();
+		// Foot position relative to pelvis
+		FVector CurrentPosition = FootTrajectory->PelvisRelative.GetPosition(i);
 
 		// Distance from pelvis
 		float Distance = CurrentPosition | Preset.PrimaryMoveAxis;
-		Distances.Add(Distance);
 
-		// Velocity (from frame 1 onward)
-		if (i > 0)
+		// Velocity (from the second frame onward, continuing across chunks)
+		float Velocity = 0.0f;
+		if (Values.Distances.Num() > 0)
 		{
-			float DeltaTime = CurrentTime - PrevTime;
+			float DeltaTime = CurrentTime - Values.LastTime;
 			if (DeltaTime > KINDA_SMALL_NUMBER)
 			{
-				float Velocity = (CurrentPosition - PrevPosition).Size() / DeltaTime;
-				Velocities.Add(Velocity);
-			}
-			else
-			{
-				Velocities.Add(0.0f);
+				Velocity = (CurrentPosition - Values.LastPosition).Size() / DeltaTime;
 			}
 		}
-		else
-		{
-			Velocities.Add(0.0f);
-		}
 
-		PrevPosition = CurrentPosition;
-		PrevTime = CurrentTime;
+		Values.Distances.Add(Distance);
+		Values.Velocities.Add(Velocity);
+
+		Values.LastPosition = CurrentPosition;
+		Values.LastTime = CurrentTime;
 	}
+}
 
-	// Get foot label string for curve naming
-	FString FootLabel;
-	switch (Foot.FootLabel)
+void UFootSyncMarkerModifier::WriteCurves(
+	UAnimSequence* AnimSequence,
+	TConstArrayView<double> Times,
+	const FSyncFootDefinition& Foot,
+	const FFootSyncCurveValues& Values)
+{
+	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
+
+	if (Times.Num() <= 1 || Values.Distances.Num() != Times.Num())
 	{
-	case EFootLabel::Left:			FootLabel = TEXT("Left"); break;
-	case EFootLabel::Right:			FootLabel = TEXT("Right"); break;
-	case EFootLabel::FrontLeft:		FootLabel = TEXT("FrontLeft"); break;
-	case EFootLabel::FrontRight:	FootLabel = TEXT("FrontRight"); break;
-	case EFootLabel::BackLeft:		FootLabel = TEXT("BackLeft"); break;
-	case EFootLabel::BackRight:		FootLabel = TEXT("BackRight"); break;
-	case EFootLabel::Custom:		FootLabel = Foot.CustomLabel; break;
+		return;
 	}
 
+	FName DistanceCurveName;
+	FName VelocityCurveName;
+	GetCurveNames(Foot, DistanceCurveName, VelocityCurveName);
+
 	// Generate distance curve
 	if (bGenerateDistanceCurves)
 	{
-		FName DistanceCurveName = FName(*(FootLabel + Settings->DistanceCurveSuffix));
-
-		// Remove existing curve if present
-		if (UAnimationBlueprintLibrary::DoesCurveExist(
-				AnimSequence, DistanceCurveName, ERawCurveTrackTypes::RCT_Float))
-		{
-			UAnimationBlueprintLibrary::RemoveCurve(AnimSequence, DistanceCurveName, false);
-		}
-
-		// Add new curve
-		UAnimationBlueprintLibrary::AddCurve(
-			AnimSequence, DistanceCurveName, ERawCurveTrackTypes::RCT_Float, false);
-		UAnimationBlueprintLibrary::AddFloatCurveKeys(
-			AnimSequence, DistanceCurveName, Times, Distances);
+		WriteFloatCurve(AnimSequence, DistanceCurveName, Times, Values.Distances,
+			Settings->bReduceCurveKeys ? Settings->DistanceCurveMaxError : 0.0f);
 	}
 
 	// Generate velocity curve
 	if (bGenerateVelocityCurves)
 	{
-		FName VelocityCurveName = FName(*(FootLabel + Settings->VelocityCurveSuffix));
+		WriteFloatCurve(AnimSequence, VelocityCurveName, Times, Values.Velocities,
+			Settings->bReduceCurveKeys ? Settings->VelocityCurveMaxError : 0.0f);
+	}
+}
 
-		// Remove existing curve if present
-		if (UAnimationBlueprintLibrary::DoesCurveExist(
-				AnimSequence, VelocityCurveName, ERawCurveTrackTypes::RCT_Float))
-		{
-			UAnimationBlueprintLibrary::RemoveCurve(AnimSequence, VelocityCurveName, false);
-		}
+void UFootSyncMarkerModifier::WriteFloatCurve(
+	UAnimSequence* AnimSequence,
+	FName CurveName,
+	TConstArrayView<double> Times,
+	const TArray<float>& Values,
+	float MaxError)
+{
+	IAnimationDataController& Controller = AnimSequence->GetController();
+	const FAnimationCurveIdentifier CurveId(CurveName, ERawCurveTrackTypes::RCT_Float);
 
-		// Add new curve
-		UAnimationBlueprintLibrary::AddCurve(
-			AnimSequence, VelocityCurveName, ERawCurveTrackTypes::RCT_Float, false);
-		UAnimationBlueprintLibrary::AddFloatCurveKeys(
-			AnimSequence, VelocityCurveName, Times, Velocities);
+	// Keep an existing curve and swap its keys, instead of removing and re-adding it
+	if (!AnimSequence->GetDataModel()->FindFloatCurve(CurveId))
+	{
+		Controller.AddCurve(CurveId, AACF_Editable, false);
 	}
+
+	TArray<FRichCurveKey> Keys;
+	FFootSyncCurveReduction::ReduceKeys(Times, Values, MaxError, Keys);
+
+	Controller.SetCurveKeys(CurveId, Keys, false);
 }
 
 void UFootSyncMarkerModifier::RemoveGeneratedData(
@@ -357,139 +963,433 @@ void UFootSyncMarkerModifier::RemoveGeneratedData(
 	UAnimationBlueprintLibrary::RemoveAnimationSyncMarkersByTrack(
 		AnimSequence, Settings->SyncMarkerTrackName);
 
-	// Remove curves for each foot
+	// Remove curves recorded by the last application, which may include feet the preset no longer has
+	RemoveStaleCurves(AnimSequence, TConstArrayView<FName>());
+
+	// Remove curves for each foot, also covering sequences applied before curves were recorded
 	for (const FSyncFootDefinition& Foot : Preset.Feet)
 	{
-		FString FootLabel;
-		switch (Foot.FootLabel)
-		{
-		case EFootLabel::Left:			FootLabel = TEXT("Left"); break;
-		case EFootLabel::Right:			FootLabel = TEXT("Right"); break;
-		case EFootLabel::FrontLeft:		FootLabel = TEXT("FrontLeft"); break;
-		case EFootLabel::FrontRight:	FootLabel = TEXT("FrontRight"); break;
-		case EFootLabel::BackLeft:		FootLabel = TEXT("BackLeft"); break;
-		case EFootLabel::BackRight:		FootLabel = TEXT("BackRight"); break;
-		case EFootLabel::Custom:		FootLabel = Foot.CustomLabel; break;
-		}
+		FName DistanceCurveName;
+		FName VelocityCurveName;
+		GetCurveNames(Foot, DistanceCurveName, VelocityCurveName);
 
-		// Remove distance curve
-		FName DistanceCurveName = FName(*(FootLabel + Settings->DistanceCurveSuffix));
-		if (UAnimationBlueprintLibrary::DoesCurveExist(
-				AnimSequence, DistanceCurveName, ERawCurveTrackTypes::RCT_Float))
+		for (const FName CurveName : { DistanceCurveName, VelocityCurveName })
 		{
-			UAnimationBlueprintLibrary::RemoveCurve(AnimSequence, DistanceCurveName, false);
+			if (UAnimationBlueprintLibrary::DoesCurveExist(AnimSequence, CurveName, ERawCurveTrackTypes::RCT_Float))
+			{
+				UAnimationBlueprintLibrary::RemoveCurve(AnimSequence, CurveName, false);
+			}
 		}
+	}
+}
+
+void UFootSyncMarkerModifier::RemoveStaleCurves(
+	UAnimSequence* AnimSequence, TConstArrayView<FName> GeneratedCurves) const
+{
+	const UFootSyncMarkerAssetUserData* UserData = AnimSequence->GetAssetUserData<UFootSyncMarkerAssetUserData>();
+	if (!UserData)
+	{
+		return;
+	}
 
-		// Remove velocity curve
-		FName VelocityCurveName = FName(*(FootLabel + Settings->VelocityCurveSuffix));
-		if (UAnimationBlueprintLibrary::DoesCurveExist(
-				AnimSequence, VelocityCurveName, ERawCurveTrackTypes::RCT_Float))
+	for (const FName CurveName : UserData->GeneratedCurves)
+	{
+		if (!GeneratedCurves.Contains(CurveName)
+			&& UAnimationBlueprintLibrary::DoesCurveExist(AnimSequence, CurveName, ERawCurveTrackTypes::RCT_Float))
 		{
-			UAnimationBlueprintLibrary::RemoveCurve(AnimSequence, VelocityCurveName, false);
+			UAnimationBlueprintLibrary::RemoveCurve(AnimSequence, CurveName, false);
 		}
 	}
 }
 
-TUniquePtr<IFootContactDetector> UFootSyncMarkerModifier::CreateDetector(
-	EFootContactDetectionMethod Method)
+void UFootSyncMarkerModifier::GetCurveNames(
+	const FSyncFootDefinition& Foot, FName& OutDistanceCurve, FName& OutVelocityCurve) const
 {
-	switch (Method)
+	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
+
+	FString FootLabel;
+	switch (Foot.FootLabel)
 	{
-	case EFootContactDetectionMethod::PelvisCrossing:
-		return MakeUnique<FPelvisCrossingDetector>();
+	case EFootLabel::Left:			FootLabel = TEXT("Left"); break;
+	case EFootLabel::Right:			FootLabel = TEXT("Right"); break;
+	case EFootLabel::FrontLeft:		FootLabel = TEXT("FrontLeft"); break;
+	case EFootLabel::FrontRight:	FootLabel = TEXT("FrontRight"); break;
+	case EFootLabel::BackLeft:		FootLabel = TEXT("BackLeft"); break;
+	case EFootLabel::BackRight:		FootLabel = TEXT("BackRight"); break;
+	case EFootLabel::Custom:		FootLabel = Foot.CustomLabel; break;
+	}
 
-	case EFootContactDetectionMethod::VelocityCurve:
-		return MakeUnique<FVelocityCurveDetector>();
+	OutDistanceCurve = FName(*(FootLabel + Settings->DistanceCurveSuffix));
+	OutVelocityCurve = FName(*(FootLabel + Settings->VelocityCurveSuffix));
+}
 
-	case EFootContactDetectionMethod::Saliency:
-		return MakeUnique<FSaliencyDetector>();
+/** Incrementally hashes values into a fingerprint */
+struct FFootSyncFingerprintBuilder
+{
+	FSHA1 Sha;
 
-	case EFootContactDetectionMethod::Composite:
-		return MakeUnique<FCompositeDetector>();
+	template <typename T>
+	void Add(const T& Value)
+	{
+		static_assert(TIsArithmetic<T>::Value || TIsEnum<T>::Value, "Use the typed overloads");
+		Sha.Update(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
 
-	default:
-		UE_LOG(LogAnimation, Warning,
-			TEXT("FootSyncMarkerModifier: Unknown detection method %d, using Composite"),
-			static_cast<int32>(Method));
-		return MakeUnique<FCompositeDetector>();
+	void Add(const FString& Value)
+	{
+		const int32 Length = Value.Len();
+		Add(Length);
+		Sha.Update(reinterpret_cast<const uint8*>(*Value), Length * sizeof(TCHAR));
 	}
-}
 
-FLocomotionPreset UFootSyncMarkerModifier::GetEffectivePreset(UAnimSequence* AnimSequence) const
-{
-	if (LocomotionType == ELocomotionType::Custom)
+	void Add(FName Value)
 	{
-		return CustomPreset;
+		Add(Value.ToString());
 	}
 
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
+	void Add(const FVector& Value)
+	{
+		Add(Value.X);
+		Add(Value.Y);
+		Add(Value.Z);
+	}
+
+	void Add(const FTransform& Value)
+	{
+		const FQuat Rotation = Value.GetRotation();
+		Add(Value.GetTranslation());
+		Add(Rotation.X);
+		Add(Rotation.Y);
+		Add(Rotation.Z);
+		Add(Rotation.W);
+		Add(Value.GetScale3D());
+	}
+
+	FString Finish()
+	{
+		FSHAHash Hash;
+		Sha.Final();
+		Sha.GetHash(Hash.Hash);
+		return Hash.ToString();
+	}
+};
+
+FString UFootSyncMarkerModifier::ComputeSourceDataHash(
+	const UAnimSequence* AnimSequence, const FLocomotionPreset& Preset) const
+{
+	const IAnimationDataModel* DataModel = AnimSequence->GetDataModel();
 	const USkeleton* Skeleton = AnimSequence->GetSkeleton();
+	if (!DataModel || !Skeleton)
+	{
+		return FString();
+	}
 
-	return Settings->CreatePresetForSkeleton(Skeleton, LocomotionType);
+	FFootSyncFingerprintBuilder Builder;
+	Builder.Add(DataModel->GetNumberOfKeys());
+	Builder.Add(DataModel->GetFrameRate().Numerator);
+	Builder.Add(DataModel->GetFrameRate().Denominator);
+
+	// Source bone tracks of the preset bones and their parent chains
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	TArray<int32> BoneIndices;
+
+	auto AddBoneChain = [&RefSkeleton, &BoneIndices](FName BoneName)
+	{
+		for (int32 BoneIndex = RefSkeleton.FindBoneIndex(BoneName);
+			BoneIndex != INDEX_NONE;
+			BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+		{
+			BoneIndices.AddUnique(BoneIndex);
+		}
+	};
+
+	AddBoneChain(Preset.PelvisBoneName);
+	for (const FSyncFootDefinition& Foot : Preset.Feet)
+	{
+		AddBoneChain(Foot.BoneName);
+	}
+	BoneIndices.Sort();
+
+	TArray<FTransform> TrackTransforms;
+	for (int32 BoneIndex : BoneIndices)
+	{
+		const FName BoneName = RefSkeleton.GetBoneName(BoneIndex);
+		Builder.Add(BoneName);
+
+		if (DataModel->IsValidBoneTrackName(BoneName))
+		{
+			TrackTransforms.Reset();
+			DataModel->GetBoneTrackTransforms(BoneName, TrackTransforms);
+			for (const FTransform& Transform : TrackTransforms)
+			{
+				Builder.Add(Transform);
+			}
+		}
+		else
+		{
+			// Untracked bones use the reference pose
+			Builder.Add(RefSkeleton.GetRefBonePose()[BoneIndex]);
+		}
+	}
+
+	return Builder.Finish();
 }
 
-EFootContactDetectionMethod UFootSyncMarkerModifier::GetEffectiveDetectionMethod() const
+// Every feature switch changes the hash, but the settings it gates are only hashed while they
+// can change the results, so tuning an unused feature does not re-apply the modifier. Changes to
+// the detection code itself bump FingerprintVersion and the detection DDC version instead.
+FString UFootSyncMarkerModifier::ComputeDetectionConfigHash(
+	const FLocomotionPreset& Preset, const FFootSyncDetectionConfig& Config) const
 {
-	if (bOverrideDetectionMethod)
+	FFootSyncFingerprintBuilder Builder;
+
+	// Bones the trajectories are measured from
+	Builder.Add(Preset.PelvisBoneName);
+
+	// Effective detection method and thresholds
+	Builder.Add(Config.DetectionMethod);
+	if (!Config.CustomDetector.IsNone())
+	{
+		// Registered detectors are identified by name and version
+		Builder.Add(Config.CustomDetector);
+		Builder.Add(FFootSyncDetectorRegistry::Get().Resolve(Config).Version);
+	}
+	Builder.Add(Config.VelocityThreshold);
+	Builder.Add(Config.SaliencyThreshold);
+
+	// Detector tuning
+	Builder.Add(Config.CompositeWeights.PelvisCrossingWeight);
+	Builder.Add(Config.CompositeWeights.VelocityCurveWeight);
+	Builder.Add(Config.CompositeWeights.SaliencyWeight);
+	Builder.Add(Config.CrossingThreshold);
+	Builder.Add(Config.PelvisConfidenceScale);
+	Builder.Add(Config.LoopBoundaryConfidence);
+	Builder.Add(Config.VelocityDefaultConfidence);
+	Builder.Add(Config.SaliencyWindowSize);
+	Builder.Add(Config.SaliencyDefaultConfidence);
+	Builder.Add(Config.SaliencyMinConfidence);
+
+	// Ground height, alone or weighted into Composite
+	if (Config.DetectionMethod == EFootContactDetectionMethod::GroundHeight
+		|| Config.CompositeWeights.GroundHeightWeight > KINDA_SMALL_NUMBER)
 	{
-		return DetectionMethodOverride;
+		Builder.Add(Config.CompositeWeights.GroundHeightWeight);
+		Builder.Add(Config.GroundPercentile);
+		Builder.Add(Config.GroundWindowSize);
+		Builder.Add(Config.GroundContactHeight);
+		Builder.Add(Config.GroundVerticalSpeedThreshold);
+		Builder.Add(Config.GroundHeightMinConfidence);
 	}
 
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-	return Settings->DetectionMethod;
+	// Tiered Composite settles clusters without Saliency
+	if (Config.bTieredComposite)
+	{
+		Builder.Add(Config.bTieredComposite);
+		Builder.Add(Config.MinimumConfidence);
+	}
+
+	// Result merging
+	Builder.Add(Config.ResultMergeThreshold);
+	Builder.Add(Config.DetectorAgreementBonus);
+
+	// The gait solver narrows the search for two of the feet
+	const bool bGaitSolver = Config.bUseQuadrupedGaitSolver && Preset.Type == ELocomotionType::Quadruped;
+	Builder.Add(bGaitSolver);
+	if (bGaitSolver)
+	{
+		Builder.Add(Config.GaitSearchWindow);
+		Builder.Add(Config.GaitMinimumHitRatio);
+		Builder.Add(Config.MinimumConfidence);
+	}
+
+	// Coarse-to-fine sampling interpolates part of the trajectories
+	Builder.Add(Config.Sampling.CoarseStride);
+	if (Config.Sampling.CoarseStride > 1)
+	{
+		Builder.Add(Config.Sampling.CoarseMinFrames);
+		Builder.Add(Config.Sampling.RefinementRadius);
+	}
+
+	// Streamed takes see their statistics so far instead of the whole take
+	if (Config.StreamingMinFrames > 0)
+	{
+		Builder.Add(Config.StreamingMinFrames);
+		Builder.Add(Config.StreamingChunkFrames);
+
+		// Streamed pelvis crossings project onto the preset axis instead of the dominant one
+		Builder.Add(Preset.PrimaryMoveAxis);
+	}
+
+	// Cyclic sequences wrap at the ends
+	Builder.Add(Config.Sampling.CycleMode);
+	if (Config.Sampling.CycleMode == EFootSyncCycleMode::Auto)
+	{
+		Builder.Add(Config.Sampling.CyclicPoseTolerance);
+	}
+
+	// Smoothing changes every trajectory
+	const FTrajectoryFilterSettings& Smoothing = Config.Sampling.Smoothing;
+	Builder.Add(Smoothing.Filter);
+	if (Smoothing.Filter == EFootSyncSmoothingFilter::SavitzkyGolay)
+	{
+		Builder.Add(Smoothing.HalfWindow);
+	}
+	else if (Smoothing.Filter == EFootSyncSmoothingFilter::Butterworth)
+	{
+		Builder.Add(Smoothing.CutoffFrequency);
+	}
+
+	return Builder.Finish();
 }
 
-float UFootSyncMarkerModifier::GetEffectiveMinimumConfidence() const
+FString UFootSyncMarkerModifier::ComputeFingerprint(
+	const UAnimSequence* AnimSequence,
+	const FLocomotionPreset& Preset,
+	const FFootSyncDetectionConfig& Config) const
 {
-	if (bOverrideMinimumConfidence)
+	// Bump when detection or output changes in a way that invalidates stored results
+	// 2: Missing chain bones fail sampling instead of reading the reference pose
+	// 3: Cyclic clips wrap signals around the seam
+	// 4: Plain sequences read key-aligned bone tracks instead of evaluating poses
+	// 5: Detectors share the fused speed and curvature signals
+	// 6: Ground height estimates the ground from stance frames only
+	// 7: Coarse-to-fine refinement finds pelvis crossings on the dominant axis
+	// 8: Tiered composite takes are never streamed or detected on the GPU
+	static constexpr int32 FingerprintVersion = 8;
+
+	const FString SourceDataHash = ComputeSourceDataHash(AnimSequence, Preset);
+	if (SourceDataHash.IsEmpty())
 	{
-		return MinimumConfidenceOverride;
+		return FString();
 	}
 
 	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-	return Settings->MinimumConfidence;
+
+	FFootSyncFingerprintBuilder Builder;
+	Builder.Add(FingerprintVersion);
+	Builder.Add(SourceDataHash);
+	Builder.Add(ComputeDetectionConfigHash(Preset, Config));
+
+	// Effective preset
+	Builder.Add(Preset.Type);
+	Builder.Add(Preset.PrimaryMoveAxis);
+	for (const FSyncFootDefinition& Foot : Preset.Feet)
+	{
+		Builder.Add(Foot.BoneName);
+		Builder.Add(Foot.MarkerName);
+		Builder.Add(Foot.FootLabel);
+		Builder.Add(Foot.CustomLabel);
+	}
+
+	// Marker selection
+	Builder.Add(Config.MinimumConfidence);
+	Builder.Add(Config.MaxMarkersPerFoot);
+	Builder.Add(Config.bGuaranteeMinimumOne);
+	Builder.Add(Config.MinimumMarkerInterval);
+
+	// Output
+	Builder.Add(Settings->SyncMarkerTrackName);
+	Builder.Add(Settings->DistanceCurveSuffix);
+	Builder.Add(Settings->VelocityCurveSuffix);
+	Builder.Add(bGenerateDistanceCurves);
+	Builder.Add(bGenerateVelocityCurves);
+	Builder.Add(Settings->bReduceCurveKeys);
+	Builder.Add(Settings->DistanceCurveMaxError);
+	Builder.Add(Settings->VelocityCurveMaxError);
+
+	return Builder.Finish();
 }
 
-float UFootSyncMarkerModifier::GetEffectiveVelocityThreshold() const
+bool UFootSyncMarkerModifier::IsUpToDate(const UAnimSequence* AnimSequence, const FString& Fingerprint) const
 {
-	if (bOverrideVelocityThreshold)
+	if (bForceReapply || !bSkipUnchanged || Fingerprint.IsEmpty())
 	{
-		return VelocityThresholdOverride;
+		return false;
 	}
 
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-	return Settings->VelocityMinimumThreshold;
+	const UFootSyncMarkerAssetUserData* UserData =
+		const_cast<UAnimSequence*>(AnimSequence)->GetAssetUserData<UFootSyncMarkerAssetUserData>();
+
+	return UserData && UserData->Fingerprint == Fingerprint;
 }
 
-float UFootSyncMarkerModifier::GetEffectiveSaliencyThreshold() const
+void UFootSyncMarkerModifier::StoreFingerprint(
+	UAnimSequence* AnimSequence, const FString& Fingerprint, const TArray<FName>& GeneratedCurves) const
 {
-	if (bOverrideSaliencyThreshold)
+	UFootSyncMarkerAssetUserData* UserData = AnimSequence->GetAssetUserData<UFootSyncMarkerAssetUserData>();
+	if (!UserData)
 	{
-		return SaliencyThresholdOverride;
+		if (Fingerprint.IsEmpty() && GeneratedCurves.Num() == 0)
+		{
+			return;
+		}
+
+		UserData = NewObject<UFootSyncMarkerAssetUserData>(AnimSequence, NAME_None, RF_Transactional);
+		AnimSequence->AddAssetUserData(UserData);
 	}
 
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-	return Settings->SaliencyThreshold;
+	if (UserData->Fingerprint != Fingerprint || UserData->GeneratedCurves != GeneratedCurves)
+	{
+		UserData->Modify();
+		UserData->Fingerprint = Fingerprint;
+		UserData->GeneratedCurves = GeneratedCurves;
+		AnimSequence->MarkPackageDirty();
+	}
 }
 
-int32 UFootSyncMarkerModifier::GetEffectiveMaxMarkersPerFoot() const
+FLocomotionPreset UFootSyncMarkerModifier::GetEffectivePreset(UAnimSequence* AnimSequence) const
 {
-	if (bOverrideMaxMarkersPerFoot)
+	if (LocomotionType == ELocomotionType::Custom)
 	{
-		return MaxMarkersPerFootOverride;
+		return CustomPreset;
 	}
 
 	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-	return Settings->MaxMarkersPerFoot;
+	const USkeleton* Skeleton = AnimSequence->GetSkeleton();
+
+	return Settings->CreatePresetForSkeleton(Skeleton, LocomotionType);
 }
 
-bool UFootSyncMarkerModifier::GetEffectiveGuaranteeMinimumOne() const
+FFootSyncDetectionConfig UFootSyncMarkerModifier::ResolveDetectionConfig() const
 {
+	FFootSyncDetectionConfig Config = FFootSyncDetectionConfig::FromProjectSettings();
+
+	// Fold in the per-animation overrides
+	if (bOverrideDetectionMethod)
+	{
+		// An explicit method also takes precedence over a registered custom detector
+		Config.DetectionMethod = DetectionMethodOverride;
+		Config.CustomDetector = NAME_None;
+	}
+	if (bOverrideMinimumConfidence)
+	{
+		Config.MinimumConfidence = MinimumConfidenceOverride;
+	}
+	if (bOverrideVelocityThreshold)
+	{
+		Config.VelocityThreshold = VelocityThresholdOverride;
+	}
+	if (bOverrideSaliencyThreshold)
+	{
+		Config.SaliencyThreshold = SaliencyThresholdOverride;
+	}
+	if (bOverrideMaxMarkersPerFoot)
+	{
+		Config.MaxMarkersPerFoot = MaxMarkersPerFootOverride;
+	}
 	if (bOverrideGuaranteeMinimumOne)
 	{
-		return bGuaranteeMinimumOneOverride;
+		Config.bGuaranteeMinimumOne = bGuaranteeMinimumOneOverride;
+	}
+	if (bOverrideCycleMode)
+	{
+		Config.Sampling.CycleMode = CycleModeOverride;
 	}
 
-	const UFootSyncMarkerSettings* Settings = UFootSyncMarkerSettings::Get();
-	return Settings->bGuaranteeMinimumOne;
+	return Config;
+}
+
+bool UFootSyncMarkerModifier::ShouldShowNotifications() const
+{
+	return bShowNotifications && !IsRunningCommandlet() && FSlateApplication::IsInitialized();
 }
@@ -1,6 +1,7 @@
 // Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
 
 #include "FootSyncMarkerSettings.h"
+#include "Detection/FootSyncDetectorRegistry.h"
 #include "Animation/Skeleton.h"
 
 UFootSyncMarkerSettings::UFootSyncMarkerSettings()
@@ -66,9 +67,34 @@ void UFootSyncMarkerSettings::InitializeDefaultPatterns()
 void UFootSyncMarkerSettings::ResetToDefaultPatterns()
 {
 	InitializeDefaultPatterns();
+	InvalidatePresetCache();
 	SaveConfig();
 }
 
+TArray<FName> UFootSyncMarkerSettings::GetCustomDetectorOptions() const
+{
+	TArray<FName> Options = FFootSyncDetectorRegistry::Get().GetDetectorNames();
+	Options.Insert(NAME_None, 0);
+	return Options;
+}
+
+#if WITH_EDITOR
+void UFootSyncMarkerSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Patterns, marker names and the flying axis all end up in resolved presets
+	InvalidatePresetCache();
+}
+#endif
+
+void UFootSyncMarkerSettings::InvalidatePresetCache()
+{
+	FScopeLock Lock(&PresetCacheLock);
+	++PresetSettingsVersion;
+	PresetCache.Reset();
+}
+
 FName UFootSyncMarkerSettings::FindPelvisBone(const USkeleton* Skeleton) const
 {
 	if (!Skeleton)
@@ -121,6 +147,39 @@ FName UFootSyncMarkerSettings::FindFootBone(const USkeleton* Skeleton, const TAr
 
 FLocomotionPreset UFootSyncMarkerSettings::CreatePresetForSkeleton(
 	const USkeleton* Skeleton, ELocomotionType Type) const
+{
+	if (!Skeleton || Type == ELocomotionType::Custom)
+	{
+		return BuildPresetForSkeleton(Skeleton, Type);
+	}
+
+	FPresetCacheKey Key;
+	Key.SkeletonGuid = Skeleton->GetGuid();
+	Key.Type = Type;
+
+	{
+		FScopeLock Lock(&PresetCacheLock);
+		Key.SettingsVersion = PresetSettingsVersion;
+		if (const FLocomotionPreset* CachedPreset = PresetCache.Find(Key))
+		{
+			return *CachedPreset;
+		}
+	}
+
+	// Resolve outside the lock, concurrent misses for the same key produce the same preset
+	FLocomotionPreset Preset = BuildPresetForSkeleton(Skeleton, Type);
+
+	FScopeLock Lock(&PresetCacheLock);
+	if (Key.SettingsVersion == PresetSettingsVersion)
+	{
+		PresetCache.Add(Key, Preset);
+	}
+
+	return Preset;
+}
+
+FLocomotionPreset UFootSyncMarkerSettings::BuildPresetForSkeleton(
+	const USkeleton* Skeleton, ELocomotionType Type) const
 {
 	FLocomotionPreset Preset;
 	Preset.Type = Type;
@@ -0,0 +1,246 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncMarkersCommandlet.h"
+#include "FootSyncMarkerModifier.h"
+#include "FootSyncStats.h"
+#include "Detection/FootSyncAnalysisExport.h"
+#include "Animation/AnimSequence.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+#include "UObject/StrongObjectPtr.h"
+
+UFootSyncMarkersCommandlet::UFootSyncMarkersCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UFootSyncMarkersCommandlet::Main(const FString& Params)
+{
+	// Parse arguments
+	FString PathsParam = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Paths="), PathsParam);
+
+	TArray<FString> PackagePaths;
+	PathsParam.ParseIntoArray(PackagePaths, TEXT("+"), true);
+
+	FString SkeletonFilter;
+	FParse::Value(*Params, TEXT("Skeleton="), SkeletonFilter);
+
+	int32 BatchSize = DefaultBatchSize;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(1, BatchSize);
+
+	const bool bNoSave = FParse::Param(*Params, TEXT("NoSave"));
+
+	FString ReportFilename;
+	FParse::Value(*Params, TEXT("Report="), ReportFilename);
+
+	FString ExportFilename;
+	FParse::Value(*Params, TEXT("Export="), ExportFilename);
+
+	// Configure a transient modifier; everything not given on the command line uses project settings
+	TStrongObjectPtr<UFootSyncMarkerModifier> Modifier(NewObject<UFootSyncMarkerModifier>());
+	Modifier->bShowNotifications = false;
+
+	FString LocomotionParam;
+	if (FParse::Value(*Params, TEXT("Locomotion="), LocomotionParam))
+	{
+		const int64 Value = StaticEnum<ELocomotionType>()->GetValueByNameString(LocomotionParam);
+		if (Value == INDEX_NONE || Value == static_cast<int64>(ELocomotionType::Custom))
+		{
+			UE_LOG(LogAnimation, Error, TEXT("FootSyncMarkers: Unsupported locomotion type '%s'"), *LocomotionParam);
+			return 1;
+		}
+		Modifier->LocomotionType = static_cast<ELocomotionType>(Value);
+	}
+
+	FString MethodParam;
+	if (FParse::Value(*Params, TEXT("Method="), MethodParam))
+	{
+		const int64 Value = StaticEnum<EFootContactDetectionMethod>()->GetValueByNameString(MethodParam);
+		if (Value == INDEX_NONE)
+		{
+			UE_LOG(LogAnimation, Error, TEXT("FootSyncMarkers: Unknown detection method '%s'"), *MethodParam);
+			return 1;
+		}
+		Modifier->bOverrideDetectionMethod = true;
+		Modifier->DetectionMethodOverride = static_cast<EFootContactDetectionMethod>(Value);
+	}
+
+	// Exports only read the sequences, nothing is committed or saved
+	FFootSyncAnalysisWriter AnalysisWriter;
+	const bool bExport = !ExportFilename.IsEmpty();
+	if (bExport && !AnalysisWriter.Open(ExportFilename))
+	{
+		return 1;
+	}
+
+	const TArray<FAssetData> SequenceAssets = FindSequences(PackagePaths, SkeletonFilter);
+
+	UE_LOG(LogAnimation, Display,
+		TEXT("FootSyncMarkers: Found %d sequences under %s (batch size %d)"),
+		SequenceAssets.Num(), *PathsParam, BatchSize);
+
+	int32 NumProcessed = 0;
+	int32 NumSaveFailures = 0;
+	int32 NumSkipped = 0;
+	TArray<FFootSyncClipStats> RunStats;
+
+	// Stream assets in bounded batches so only BatchSize sequences are loaded at once
+	for (int32 BatchStart = 0; BatchStart < SequenceAssets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, SequenceAssets.Num());
+
+		TArray<UAnimSequence*> Batch;
+		Batch.Reserve(BatchEnd - BatchStart);
+
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; ++AssetIndex)
+		{
+			if (UAnimSequence* AnimSequence = Cast<UAnimSequence>(SequenceAssets[AssetIndex].GetAsset()))
+			{
+				Batch.Add(AnimSequence);
+			}
+			else
+			{
+				UE_LOG(LogAnimation, Warning,
+					TEXT("FootSyncMarkers: Failed to load %s"),
+					*SequenceAssets[AssetIndex].GetObjectPathString());
+			}
+		}
+
+		if (bExport)
+		{
+			Modifier->ExportSequences(Batch, AnalysisWriter);
+		}
+		else
+		{
+			Modifier->ApplyToSequences(Batch);
+		}
+		NumProcessed += Batch.Num();
+		RunStats.Append(Modifier->GetLastBatchStats());
+		NumSkipped += Modifier->GetLastBatchNumSkipped();
+
+		if (!bNoSave && !bExport)
+		{
+			NumSaveFailures += SaveModifiedPackages(Batch);
+		}
+
+		UE_LOG(LogAnimation, Display,
+			TEXT("FootSyncMarkers: Processed %d / %d sequences"),
+			NumProcessed, SequenceAssets.Num());
+
+		// Release the batch before loading the next one. Loaded assets are RF_Standalone,
+		// which GARBAGE_COLLECTION_KEEPFLAGS keeps in the editor, so detach their loaders
+		// and collect without keep flags as the engine resave commandlets do.
+		for (UAnimSequence* AnimSequence : Batch)
+		{
+			ResetLoaders(AnimSequence->GetPackage());
+		}
+		Batch.Reset();
+		CollectGarbage(RF_NoFlags);
+	}
+
+	UE_LOG(LogAnimation, Display,
+		TEXT("FootSyncMarkers: Done, %d sequences processed, %d save failures"),
+		NumProcessed, NumSaveFailures);
+
+	// Run summary across all batches
+	FFootSyncBatchReport::LogSummary(RunStats, NumSkipped);
+
+	if (!ReportFilename.IsEmpty())
+	{
+		if (FFootSyncBatchReport::WriteCsv(RunStats, ReportFilename))
+		{
+			UE_LOG(LogAnimation, Display, TEXT("FootSyncMarkers: Wrote per-clip report to %s"), *ReportFilename);
+		}
+		else
+		{
+			UE_LOG(LogAnimation, Error, TEXT("FootSyncMarkers: Failed to write report %s"), *ReportFilename);
+		}
+	}
+
+	bool bExportFailed = false;
+	if (AnalysisWriter.IsOpen())
+	{
+		const int32 NumExported = AnalysisWriter.GetNumClips();
+		bExportFailed = !AnalysisWriter.Close();
+		if (!bExportFailed)
+		{
+			UE_LOG(LogAnimation, Display, TEXT("FootSyncMarkers: Exported %d sequences to %s"), NumExported, *ExportFilename);
+		}
+	}
+
+	return NumSaveFailures > 0 || bExportFailed ? 1 : 0;
+}
+
+TArray<FAssetData> UFootSyncMarkersCommandlet::FindSequences(
+	const TArray<FString>& PackagePaths, const FString& SkeletonFilter) const
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
+		TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Add(FName(*PackagePath));
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	if (!SkeletonFilter.IsEmpty())
+	{
+		// Filter by the skeleton tag so non-matching sequences are never loaded
+		Assets.RemoveAll([&SkeletonFilter](const FAssetData& AssetData)
+		{
+			const FString SkeletonPath = AssetData.GetTagValueRef<FString>(TEXT("Skeleton"));
+			return !SkeletonPath.Contains(SkeletonFilter, ESearchCase::IgnoreCase);
+		});
+	}
+
+	// Deterministic processing order
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	return Assets;
+}
+
+int32 UFootSyncMarkersCommandlet::SaveModifiedPackages(const TArray<UAnimSequence*>& AnimSequences) const
+{
+	int32 NumFailures = 0;
+
+	for (UAnimSequence* AnimSequence : AnimSequences)
+	{
+		UPackage* Package = AnimSequence->GetPackage();
+		if (!Package || !Package->IsDirty())
+		{
+			continue;
+		}
+
+		const FString Filename = FPackageName::LongPackageNameToFilename(
+			Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+
+		if (!UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs))
+		{
+			UE_LOG(LogAnimation, Error, TEXT("FootSyncMarkers: Failed to save %s"), *Filename);
+			++NumFailures;
+		}
+	}
+
+	return NumFailures;
+}
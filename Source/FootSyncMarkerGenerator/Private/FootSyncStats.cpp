@@ -0,0 +1,105 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncStats.h"
+#include "Misc/FileHelper.h"
+
+DEFINE_STAT(STAT_FootSync_SamplePoses);
+DEFINE_STAT(STAT_FootSync_SmoothTrajectories);
+DEFINE_STAT(STAT_FootSync_ComputeSignals);
+DEFINE_STAT(STAT_FootSync_DetectPelvisCrossing);
+DEFINE_STAT(STAT_FootSync_DetectVelocityCurve);
+DEFINE_STAT(STAT_FootSync_DetectSaliency);
+DEFINE_STAT(STAT_FootSync_DetectGroundHeight);
+DEFINE_STAT(STAT_FootSync_DetectComposite);
+DEFINE_STAT(STAT_FootSync_MergeResults);
+DEFINE_STAT(STAT_FootSync_GpuTrajectoryAnalysis);
+DEFINE_STAT(STAT_FootSync_AddSyncMarkers);
+DEFINE_STAT(STAT_FootSync_GenerateCurves);
+DEFINE_STAT(STAT_FootSync_PosesEvaluated);
+DEFINE_STAT(STAT_FootSync_TrackFramesRead);
+DEFINE_STAT(STAT_FootSync_ClipsProcessed);
+
+UE_TRACE_CHANNEL_DEFINE(FootSyncChannel);
+
+FString FFootSyncClipStats::GetCsvHeader()
+{
+	return TEXT("Sequence,Locomotion,Method,Frames,EvaluatedFrames,Feet,Markers,CacheHits,TieredFeet,SaliencySkips,SampleMs,DetectMs,CommitMs,TotalMs");
+}
+
+FString FFootSyncClipStats::ToCsvRow() const
+{
+	return FString::Printf(TEXT("%s,%s,%s,%d,%d,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f"),
+		*SequencePath,
+		*StaticEnum<ELocomotionType>()->GetNameStringByValue(static_cast<int64>(LocomotionType)),
+		*StaticEnum<EFootContactDetectionMethod>()->GetNameStringByValue(static_cast<int64>(DetectionMethod)),
+		NumFrames, NumEvaluatedFrames, NumFeet, NumMarkers, NumCacheHits, NumTieredFeet, NumSaliencySkips,
+		SampleSeconds * 1000.0, DetectSeconds * 1000.0, CommitSeconds * 1000.0, GetTotalSeconds() * 1000.0);
+}
+
+void FFootSyncBatchReport::LogSummary(const TArray<FFootSyncClipStats>& Clips, int32 NumSkipped, int32 NumOutliers)
+{
+	FFootSyncClipStats Totals;
+	for (const FFootSyncClipStats& Clip : Clips)
+	{
+		Totals.NumFrames += Clip.NumFrames;
+		Totals.NumEvaluatedFrames += Clip.NumEvaluatedFrames;
+		Totals.NumFeet += Clip.NumFeet;
+		Totals.NumMarkers += Clip.NumMarkers;
+		Totals.NumCacheHits += Clip.NumCacheHits;
+		Totals.NumTieredFeet += Clip.NumTieredFeet;
+		Totals.NumSaliencySkips += Clip.NumSaliencySkips;
+		Totals.SampleSeconds += Clip.SampleSeconds;
+		Totals.DetectSeconds += Clip.DetectSeconds;
+		Totals.CommitSeconds += Clip.CommitSeconds;
+	}
+
+	UE_LOG(LogAnimation, Display,
+		TEXT("FootSync: %d clips processed, %d unchanged, %d frames (%d evaluated), %d feet (%d cached), %d markers"),
+		Clips.Num(), NumSkipped, Totals.NumFrames, Totals.NumEvaluatedFrames,
+		Totals.NumFeet, Totals.NumCacheHits, Totals.NumMarkers);
+	UE_LOG(LogAnimation, Display,
+		TEXT("FootSync: Sample %.1f ms, Detect %.1f ms, Commit %.1f ms"),
+		Totals.SampleSeconds * 1000.0, Totals.DetectSeconds * 1000.0, Totals.CommitSeconds * 1000.0);
+
+	if (Totals.NumTieredFeet > 0)
+	{
+		UE_LOG(LogAnimation, Display,
+			TEXT("FootSync: Tiered composite skipped Saliency on %d of %d feet (%.0f%%)"),
+			Totals.NumSaliencySkips, Totals.NumTieredFeet,
+			100.0 * Totals.NumSaliencySkips / Totals.NumTieredFeet);
+	}
+
+	// Slowest clips first, so outlier assets stand out
+	TArray<const FFootSyncClipStats*> Sorted;
+	Sorted.Reserve(Clips.Num());
+	for (const FFootSyncClipStats& Clip : Clips)
+	{
+		Sorted.Add(&Clip);
+	}
+	Sorted.Sort([](const FFootSyncClipStats& A, const FFootSyncClipStats& B)
+	{
+		return A.GetTotalSeconds() > B.GetTotalSeconds();
+	});
+
+	for (int32 i = 0; i < FMath::Min(NumOutliers, Sorted.Num()); ++i)
+	{
+		const FFootSyncClipStats& Clip = *Sorted[i];
+		UE_LOG(LogAnimation, Display,
+			TEXT("FootSync:   %8.1f ms  %s (%d frames, %d feet, sample %.1f / detect %.1f / commit %.1f ms)"),
+			Clip.GetTotalSeconds() * 1000.0, *Clip.SequencePath, Clip.NumFrames, Clip.NumFeet,
+			Clip.SampleSeconds * 1000.0, Clip.DetectSeconds * 1000.0, Clip.CommitSeconds * 1000.0);
+	}
+}
+
+bool FFootSyncBatchReport::WriteCsv(const TArray<FFootSyncClipStats>& Clips, const FString& Filename)
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Clips.Num() + 1);
+	Lines.Add(FFootSyncClipStats::GetCsvHeader());
+	for (const FFootSyncClipStats& Clip : Clips)
+	{
+		Lines.Add(Clip.ToCsvRow());
+	}
+
+	return FFileHelper::SaveStringArrayToFile(Lines, *Filename);
+}
@@ -3,67 +3,113 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+#include <atomic>
 #include "IFootContactDetector.h"
 #include "PelvisCrossingDetector.h"
 #include "VelocityCurveDetector.h"
 #include "SaliencyDetector.h"
+#include "GroundHeightDetector.h"
 
 /**
  * Combines multiple detection methods using weighted voting
- * Results from each detector are clustered by time and merged
+ * Results from each detector are clustered by time and merged. The individual
+ * detectors read the speed, curvature and pelvis projection signals shared
+ * through the sampling context.
+ *
+ * In tiered mode the cheap detectors run first and Saliency only decides the
+ * contact clusters they leave open: clusters found by a single detector, with
+ * mixed contact/lift-off votes, or with a confidence at or below MinimumConfidence.
+ * Feet without open clusters skip Saliency (and its curvature) altogether.
  */
 class FOOTSYNCMARKERGENERATOR_API FCompositeDetector : public IFootContactDetector
 {
 public:
+	/** Detector configured from the current project settings (game thread) */
 	FCompositeDetector();
-	explicit FCompositeDetector(const struct FCompositeDetectionWeights& Weights);
+	explicit FCompositeDetector(const FFootSyncDetectionConfig& InConfig);
 	virtual ~FCompositeDetector() = default;
 
 	// IFootContactDetector interface
 	virtual TArray<FFootContactResult> DetectContacts(
-		UAnimSequence* AnimSequence,
+		const FFootSyncSamplingContext& Context,
 		const FSyncFootDefinition& Foot,
 		const FLocomotionPreset& Preset) override;
 
 	virtual FString GetDetectorName() const override { return TEXT("Composite"); }
 
-	virtual void SetVelocityThreshold(float Threshold) override;
-	virtual void SetSaliencyThreshold(float Threshold) override;
+	virtual void AddClipStats(FFootSyncClipStats& OutStats) const override;
 
-private:
 	/**
 	 * Merge results from multiple detectors using time-based clustering
 	 */
 	TArray<FFootContactResult> MergeResults(
 		const TArray<FFootContactResult>& PelvisResults,
 		const TArray<FFootContactResult>& VelocityResults,
-		const TArray<FFootContactResult>& SaliencyResults);
+		const TArray<FFootContactResult>& SaliencyResults,
+		const TArray<FFootContactResult>& GroundHeightResults);
+
+private:
+	/** The streaming composite buffers results and reuses the cluster merge */
+	friend class FStreamingCompositeDetector;
+
+	/** Configuration snapshot, shared with the individual detectors */
+	const FFootSyncDetectionConfig Config;
+
+	/**
+	 * View the results in time order
+	 * Returns the input itself when already sorted, otherwise a sorted copy in Scratch
+	 */
+	static TConstArrayView<FFootContactResult> GetTimeSorted(
+		const TArray<FFootContactResult>& Results,
+		TArray<FFootContactResult, TMemStackAllocator<>>& Scratch);
+
+	/**
+	 * Merge the results of up to four detectors into one time-ordered array
+	 * Ties keep the order of the inputs
+	 */
+	static void MergeInputs(
+		TConstArrayView<const TArray<FFootContactResult>*> Results,
+		TArray<FFootContactResult, TMemStackAllocator<>>& OutMerged);
+
+	/**
+	 * Time windows of the contact clusters the cheap detectors leave open
+	 * Lift-off clusters never become markers and stay as found. Everything is open
+	 * when the cheap detectors found no contact at all.
+	 * @return Sorted, disjoint windows padded by the merge threshold
+	 */
+	TArray<TInterval<float>> FindOpenWindows(
+		const TArray<FFootContactResult>& PelvisResults,
+		const TArray<FFootContactResult>& VelocityResults,
+		const TArray<FFootContactResult>& GroundHeightResults);
 
 	/**
-	 * Cluster results by time proximity
-	 * Results within MergeThreshold are grouped together
+	 * Find the end of the cluster starting at the given index
+	 * Results within MergeThreshold of the first result are grouped together
+	 * @return Index one past the last result of the cluster
 	 */
-	TArray<TArray<FFootContactResult>> ClusterResultsByTime(
-		const TArray<FFootContactResult>& AllResults,
+	static int32 FindClusterEnd(
+		TConstArrayView<FFootContactResult> SortedResults,
+		int32 ClusterStart,
 		float MergeThreshold);
 
 	/**
 	 * Calculate final result from a cluster of nearby detections
 	 */
-	FFootContactResult CalculateClusterResult(const TArray<FFootContactResult>& Cluster);
+	FFootContactResult CalculateClusterResult(TConstArrayView<FFootContactResult> Cluster);
 
 	/**
 	 * Get the weight for a detection method
 	 */
 	float GetWeightForMethod(EFootContactDetectionMethod Method) const;
 
-	// Individual detectors
-	TUniquePtr<FPelvisCrossingDetector> PelvisDetector;
-	TUniquePtr<FVelocityCurveDetector> VelocityDetector;
-	TUniquePtr<FSaliencyDetector> SaliencyDetector;
+	// Individual detectors, held by value so creating a composite allocates nothing more
+	FPelvisCrossingDetector PelvisDetector;
+	FVelocityCurveDetector VelocityDetector;
+	FSaliencyDetector SaliencyDetector;
+	FGroundHeightDetector GroundHeightDetector;
 
-	// Weights for each method
-	float PelvisCrossingWeight;
-	float VelocityCurveWeight;
-	float SaliencyWeight;
+	/** Feet detected in tiered mode, and those of them that skipped Saliency */
+	std::atomic<int32> NumTieredFeet { 0 };
+	std::atomic<int32> NumSaliencySkips { 0 };
 };
@@ -0,0 +1,304 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+
+struct FFootSyncSamplingContext;
+class FArchive;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * On-disk layout of an analysis export (.fsanalysis)
+ *
+ * Little-endian, all offsets are absolute file offsets and every column starts 16-byte aligned:
+ *
+ *   FFootSyncAnalysisHeader     48 bytes
+ *   Columns                     Per clip: Times (double), Pelvis X/Y/Z planes (float)
+ *                               Per foot: Position, PelvisRelative X/Y/Z planes, Speed, Curvature,
+ *                               PelvisProjection (float per frame), Results (FFootSyncAnalysisResult)
+ *   Clip table                  FFootSyncAnalysisClipRecord[NumClips], 56 bytes each
+ *   Foot table                  FFootSyncAnalysisFootRecord[NumFeet], 64 bytes each, feet of a clip are contiguous
+ *   String table                UTF-8 names, not null-terminated
+ *
+ * Results are FFootSyncAnalysisResult, 12 bytes each.
+ * The records are plain structs so external tools can read the tables and columns in place.
+ */
+namespace FootSyncAnalysis
+{
+	/** 'FSAX' */
+	static constexpr uint32 Magic = 0x58415346;
+	static constexpr uint32 Version = 1;
+
+	/** Alignment of every column and table */
+	static constexpr uint64 Alignment = 16;
+
+	static const TCHAR* const FileExtension = TEXT(".fsanalysis");
+}
+
+/** Per-clip flags of an analysis export */
+enum class EFootSyncAnalysisClipFlags : uint8
+{
+	None		= 0,
+
+	/** The last frame repeats the first one cycle later */
+	Cyclic		= 1 << 0,
+
+	/** Contacts were detected by the quadruped gait solver instead of per foot */
+	GaitSolver	= 1 << 1
+};
+ENUM_CLASS_FLAGS(EFootSyncAnalysisClipFlags);
+
+struct FFootSyncAnalysisHeader
+{
+	uint32 Magic = FootSyncAnalysis::Magic;
+	uint32 Version = FootSyncAnalysis::Version;
+	uint32 NumClips = 0;
+	uint32 NumFeet = 0;
+	uint64 ClipTableOffset = 0;
+	uint64 FootTableOffset = 0;
+	uint64 StringTableOffset = 0;
+	uint64 StringTableSize = 0;
+};
+static_assert(sizeof(FFootSyncAnalysisHeader) == 48, "Analysis header layout changed");
+
+struct FFootSyncAnalysisClipRecord
+{
+	/** Sequence object path */
+	uint64 NameOffset = 0;
+	uint32 NameLength = 0;
+
+	uint32 NumFrames = 0;
+
+	/** Pelvis bone name */
+	uint64 PelvisNameOffset = 0;
+	uint32 PelvisNameLength = 0;
+
+	/** Feet of the clip in the foot table */
+	uint32 FirstFoot = 0;
+	uint32 NumFeet = 0;
+
+	/** EFootContactDetectionMethod the results were detected with */
+	uint8 DetectionMethod = 0;
+
+	/** EFootSyncAnalysisClipFlags */
+	uint8 Flags = 0;
+
+	uint8 Padding[2] = {};
+
+	/** double[NumFrames] */
+	uint64 TimesOffset = 0;
+
+	/** float[3][NumFrames], X, Y and Z planes */
+	uint64 PelvisOffset = 0;
+};
+static_assert(sizeof(FFootSyncAnalysisClipRecord) == 56, "Analysis clip record layout changed");
+
+struct FFootSyncAnalysisFootRecord
+{
+	/** Foot bone name */
+	uint64 BoneNameOffset = 0;
+	uint32 BoneNameLength = 0;
+
+	uint32 NumResults = 0;
+
+	/** float[3][NumFrames], X, Y and Z planes */
+	uint64 PositionOffset = 0;
+	uint64 PelvisRelativeOffset = 0;
+
+	/** float[NumFrames], 0 when the signal was not computed (the only columns that may be absent) */
+	uint64 SpeedOffset = 0;
+	uint64 CurvatureOffset = 0;
+	uint64 PelvisProjectionOffset = 0;
+
+	/** FFootSyncAnalysisResult[NumResults] */
+	uint64 ResultsOffset = 0;
+};
+static_assert(sizeof(FFootSyncAnalysisFootRecord) == 64, "Analysis foot record layout changed");
+
+/** Packed FFootContactResult */
+struct FFootSyncAnalysisResult
+{
+	float Time = 0.0f;
+	float Confidence = 0.0f;
+	uint8 bIsContact = 0;
+
+	/** EFootContactDetectionMethod */
+	uint8 Source = 0;
+
+	uint8 Padding[2] = {};
+
+	FFootContactResult ToResult() const
+	{
+		return FFootContactResult(Time, Confidence, bIsContact != 0, static_cast<EFootContactDetectionMethod>(Source));
+	}
+};
+static_assert(sizeof(FFootSyncAnalysisResult) == 12, "Analysis result layout changed");
+
+/**
+ * Streams sampled trajectories, their signals and the detected contacts of many clips to one file
+ * Columns are written as clips are added, the tables and header when the writer is closed,
+ * so memory stays bounded by the tables however large the library is.
+ */
+class FOOTSYNCMARKERGENERATOR_API FFootSyncAnalysisWriter
+{
+public:
+	FFootSyncAnalysisWriter();
+	~FFootSyncAnalysisWriter();
+
+	FFootSyncAnalysisWriter(const FFootSyncAnalysisWriter&) = delete;
+	FFootSyncAnalysisWriter& operator=(const FFootSyncAnalysisWriter&) = delete;
+
+	/** Create the file, replacing any existing one */
+	bool Open(const FString& Filename);
+
+	/**
+	 * Append a clip
+	 * @param Name Name the clip is listed under (sequence object path)
+	 * @param Context Sampled trajectories, with any computed signals
+	 * @param DetectionMethod Method the results were detected with
+	 * @param bGaitSolver Whether the quadruped gait solver produced the results
+	 * @param Results Contact results of each foot, by bone name
+	 */
+	void AddClip(
+		const FString& Name,
+		const FFootSyncSamplingContext& Context,
+		EFootContactDetectionMethod DetectionMethod,
+		bool bGaitSolver,
+		const TMap<FName, TArray<FFootContactResult>>& Results);
+
+	/**
+	 * Write the tables and header and close the file
+	 * @return True if everything was written
+	 */
+	bool Close();
+
+	bool IsOpen() const { return Archive.IsValid(); }
+
+	int32 GetNumClips() const { return Clips.Num(); }
+
+private:
+	/** Write a column at the next aligned offset, 0 for empty columns */
+	uint64 WriteColumn(const void* Data, int64 NumBytes);
+
+	/** Write the X, Y and Z planes of a stream as one column */
+	uint64 WriteStream(const struct FTrajectoryStream& Stream);
+
+	/** Append a name to the string table */
+	void AddString(const FString& String, uint64& OutOffset, uint32& OutLength);
+
+	/** Pad the file to the column alignment */
+	void PadToAlignment();
+
+	TUniquePtr<FArchive> Archive;
+	FString Filename;
+
+	TArray<FFootSyncAnalysisClipRecord> Clips;
+	TArray<FFootSyncAnalysisFootRecord> Feet;
+	TArray<UTF8CHAR> Strings;
+};
+
+/** Columns of one exported foot, pointing into the mapped file */
+struct FFootSyncAnalysisFootView
+{
+	FUtf8StringView BoneName;
+
+	TConstArrayView<float> PositionX;
+	TConstArrayView<float> PositionY;
+	TConstArrayView<float> PositionZ;
+
+	TConstArrayView<float> PelvisRelativeX;
+	TConstArrayView<float> PelvisRelativeY;
+	TConstArrayView<float> PelvisRelativeZ;
+
+	/** Empty when the signal was not computed */
+	TConstArrayView<float> Speed;
+	TConstArrayView<float> Curvature;
+	TConstArrayView<float> PelvisProjection;
+
+	TConstArrayView<FFootSyncAnalysisResult> Results;
+};
+
+/** Columns of one exported clip, pointing into the mapped file */
+struct FFootSyncAnalysisClipView
+{
+	FUtf8StringView Name;
+	FUtf8StringView PelvisBoneName;
+
+	EFootContactDetectionMethod DetectionMethod = EFootContactDetectionMethod::Composite;
+	EFootSyncAnalysisClipFlags Flags = EFootSyncAnalysisClipFlags::None;
+
+	TConstArrayView<double> Times;
+
+	TConstArrayView<float> PelvisX;
+	TConstArrayView<float> PelvisY;
+	TConstArrayView<float> PelvisZ;
+
+	int32 NumFeet = 0;
+};
+
+/**
+ * Read-only, memory-mapped view of an analysis export
+ * Every table and column is validated against the file size once on Open, after which the
+ * views point straight into the mapping and stay valid until the file is closed.
+ */
+class FOOTSYNCMARKERGENERATOR_API FFootSyncAnalysisFile
+{
+public:
+	FFootSyncAnalysisFile();
+	~FFootSyncAnalysisFile();
+
+	FFootSyncAnalysisFile(const FFootSyncAnalysisFile&) = delete;
+	FFootSyncAnalysisFile& operator=(const FFootSyncAnalysisFile&) = delete;
+
+	/** Map the file and validate its layout */
+	bool Open(const FString& Filename);
+
+	/** Unmap the file, invalidating every view */
+	void Close();
+
+	bool IsOpen() const { return Data != nullptr; }
+
+	int32 GetNumClips() const { return Clips.Num(); }
+
+	FFootSyncAnalysisClipView GetClip(int32 ClipIndex) const;
+
+	FFootSyncAnalysisFootView GetFoot(int32 ClipIndex, int32 FootIndex) const;
+
+	/**
+	 * Copy a clip into a sampling context, so detectors can run on it without the sequence
+	 * @return False if the clip has no frames
+	 */
+	bool MakeSamplingContext(int32 ClipIndex, FFootSyncSamplingContext& OutContext) const;
+
+private:
+	/** Whether Count aligned elements of ElementSize bytes at Offset lie inside the file (empty ranges always do) */
+	bool IsInFile(uint64 Offset, uint64 Count, uint64 ElementSize) const;
+
+	/** Like IsInFile, but offset 0 marks a column that was not written */
+	bool IsOptionalInFile(uint64 Offset, uint64 Count, uint64 ElementSize) const
+	{
+		return Offset == 0 || IsInFile(Offset, Count, ElementSize);
+	}
+
+	template <typename T>
+	TConstArrayView<T> GetColumn(uint64 Offset, uint64 Count) const
+	{
+		return Offset != 0 ? TConstArrayView<T>(reinterpret_cast<const T*>(Data + Offset), static_cast<int32>(Count)) : TConstArrayView<T>();
+	}
+
+	FUtf8StringView GetString(uint64 Offset, uint32 Length) const;
+
+	TUniquePtr<IMappedFileHandle> Handle;
+	TUniquePtr<IMappedFileRegion> Region;
+
+	const uint8* Data = nullptr;
+	uint64 Size = 0;
+
+	TConstArrayView<FFootSyncAnalysisClipRecord> Clips;
+	TConstArrayView<FFootSyncAnalysisFootRecord> Feet;
+	uint64 StringTableOffset = 0;
+	uint64 StringTableSize = 0;
+};
@@ -0,0 +1,141 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+#include "Detection/FootSyncSamplingContext.h"
+
+class UFootSyncMarkerSettings;
+
+/**
+ * Immutable snapshot of everything detection and marker selection read
+ * Resolved once per apply on the game thread, with per-modifier overrides folded in,
+ * and copied into detectors so detection never touches UObjects.
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncDetectionConfig
+{
+	// ============== Detection ==============
+
+	/** Detection method */
+	EFootContactDetectionMethod DetectionMethod = EFootContactDetectionMethod::Composite;
+
+	/** Registered detector to run instead of DetectionMethod (None runs the built-in method) */
+	FName CustomDetector;
+
+	/** Weights for composite detection */
+	FCompositeDetectionWeights CompositeWeights;
+
+	/** Run Saliency only on the clusters the cheap detectors leave open */
+	bool bTieredComposite = false;
+
+	// ============== Pelvis Crossing ==============
+
+	/** Threshold for pelvis line crossing detection (cm) */
+	float CrossingThreshold = 0.01f;
+
+	/** Position change divisor for confidence calculation (cm) */
+	float PelvisConfidenceScale = 50.0f;
+
+	/** Confidence for loop boundary crossings */
+	float LoopBoundaryConfidence = 0.7f;
+
+	// ============== Velocity Curve ==============
+
+	/** Minimum velocity threshold for foot contact detection (cm/s) */
+	float VelocityThreshold = 5.0f;
+
+	/** Default confidence when max velocity is zero */
+	float VelocityDefaultConfidence = 0.5f;
+
+	// ============== Saliency ==============
+
+	/** Analysis window size for saliency detection (seconds) */
+	float SaliencyWindowSize = 0.1f;
+
+	/** Threshold for saliency point detection (0.0 - 1.0) */
+	float SaliencyThreshold = 0.5f;
+
+	/** Default confidence when max curvature is zero */
+	float SaliencyDefaultConfidence = 0.5f;
+
+	/** Minimum confidence for saliency detection */
+	float SaliencyMinConfidence = 0.3f;
+
+	// ============== Ground Height ==============
+
+	/** Low percentile of the foot height taken as the local ground (0.0 - 1.0) */
+	float GroundPercentile = 0.1f;
+
+	/** Rolling window the ground is estimated over, from its stance frames only (seconds) */
+	float GroundWindowSize = 0.5f;
+
+	/** Height above the ground below which the foot can be planted (cm) */
+	float GroundContactHeight = 3.0f;
+
+	/** Maximum vertical foot speed at contact (cm/s) */
+	float GroundVerticalSpeedThreshold = 15.0f;
+
+	/** Minimum confidence for ground height detection */
+	float GroundHeightMinConfidence = 0.3f;
+
+	// ============== Composite ==============
+
+	/** Time threshold for merging nearby detection results (seconds) */
+	float ResultMergeThreshold = 0.05f;
+
+	/** Confidence bonus per additional detector agreement */
+	float DetectorAgreementBonus = 0.1f;
+
+	// ============== Marker Selection ==============
+
+	/** Minimum confidence threshold for marker creation */
+	float MinimumConfidence = 0.3f;
+
+	/** Maximum markers per foot (0 = unlimited) */
+	int32 MaxMarkersPerFoot = 2;
+
+	/** Guarantee at least one marker per foot even if below confidence threshold */
+	bool bGuaranteeMinimumOne = true;
+
+	/** Minimum time between consecutive markers for the same foot (seconds) */
+	float MinimumMarkerInterval = 0.1f;
+
+	// ============== Quadruped Gait ==============
+
+	/** Search the contralateral feet only around contacts predicted from the gait cycle */
+	bool bUseQuadrupedGaitSolver = false;
+
+	/** Half-width of the search window around each predicted contact (fraction of the gait cycle) */
+	float GaitSearchWindow = 0.2f;
+
+	/** Fraction of predicted contacts that must be confirmed before falling back to full detection */
+	float GaitMinimumHitRatio = 0.75f;
+
+	// ============== Sampling and Caching ==============
+
+	/** Pose sampling options */
+	FFootSyncSamplingOptions Sampling;
+
+	/** Minimum number of keys before a take is detected chunk by chunk (0 never streams) */
+	int32 StreamingMinFrames = 0;
+
+	/** Number of keys sampled per chunk of a streamed take */
+	int32 StreamingChunkFrames = 1024;
+
+	/** Store and reuse per-foot detection results in the Derived Data Cache */
+	bool bUseDerivedDataCache = true;
+
+	/** Compute trajectory signals on the GPU for batched applies */
+	bool bUseGpuTrajectoryAnalysis = false;
+
+	/**
+	 * Snapshot the project settings (game thread)
+	 */
+	static FFootSyncDetectionConfig FromSettings(const UFootSyncMarkerSettings& Settings);
+
+	/**
+	 * Snapshot the current project settings (game thread)
+	 */
+	static FFootSyncDetectionConfig FromProjectSettings();
+};
@@ -0,0 +1,90 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "IFootContactDetector.h"
+
+/** Creates a detector configured with the given snapshot */
+using FFootSyncDetectorFactory = TFunction<TUniquePtr<IFootContactDetector>(const FFootSyncDetectionConfig&)>;
+
+/**
+ * A detector known to the registry
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncDetectorRegistration
+{
+	/** Name the detector is selected by */
+	FName Name;
+
+	/** Signals the detector reads, computed once per foot by the sampling context before detection */
+	EFootSyncTrajectorySignals Signals = EFootSyncTrajectorySignals::None;
+
+	/** Bump whenever the detector's results change, so cached results are not reused */
+	int32 Version = 0;
+
+	/** Creates a detector instance (called from detection threads) */
+	FFootSyncDetectorFactory Factory;
+};
+
+/**
+ * Registry of the foot contact detectors available to the marker modifier
+ *
+ * The built-in methods are registered under their EFootContactDetectionMethod names.
+ * Other modules register their own detectors on startup (and unregister them on shutdown)
+ * and select them with the CustomDetector setting. One detector instance is created
+ * per sequence and shared by all of its feet, so DetectContacts may run concurrently
+ * on the same instance and must only read the detector's own state.
+ */
+class FOOTSYNCMARKERGENERATOR_API FFootSyncDetectorRegistry
+{
+public:
+	/** Registry singleton, with the built-in detectors registered */
+	static FFootSyncDetectorRegistry& Get();
+
+	/** Name the built-in detector of a method is registered under */
+	static FName GetMethodName(EFootContactDetectionMethod Method);
+
+	/**
+	 * Register a detector, replacing any registration with the same name
+	 * @param Registration Detector name, required signals, version and factory
+	 */
+	void Register(const FFootSyncDetectorRegistration& Registration);
+
+	/** Remove a registration, a replaced built-in detector is restored instead */
+	void Unregister(FName Name);
+
+	/**
+	 * Find a registration by name
+	 * @return False if no detector is registered under the name
+	 */
+	bool Find(FName Name, FFootSyncDetectorRegistration& OutRegistration) const;
+
+	/**
+	 * Registration of the detector selected by the configuration
+	 * The custom detector when set, otherwise the built-in detector of the detection method.
+	 * Unknown names fall back to the Composite detector.
+	 */
+	FFootSyncDetectorRegistration Resolve(const FFootSyncDetectionConfig& Config) const;
+
+	/** Create the detector selected by the configuration */
+	TUniquePtr<IFootContactDetector> CreateDetector(const FFootSyncDetectionConfig& Config) const;
+
+	/** Names of every registered detector, sorted */
+	TArray<FName> GetDetectorNames() const;
+
+private:
+	FFootSyncDetectorRegistry();
+
+	/** Register the detector of a built-in method */
+	template <typename DetectorType>
+	void RegisterBuiltIn(EFootContactDetectionMethod Method, EFootSyncTrajectorySignals Signals);
+
+	/** Guards Registrations, detection threads resolve while modules register */
+	mutable FRWLock Lock;
+
+	TMap<FName, FFootSyncDetectorRegistration> Registrations;
+
+	/** Built-in registrations, restored when their replacement is unregistered */
+	TMap<FName, FFootSyncDetectorRegistration> BuiltInRegistrations;
+};
@@ -0,0 +1,61 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IFootContactDetector.h"
+#include "FootSyncComputeBackend.h"
+
+struct FFootSyncSamplingContext;
+
+/**
+ * GPU trajectory analysis of the feet of one sampled sequence
+ */
+struct FFootSyncGpuSignals
+{
+	/** Analysis of each foot, parallel to FFootSyncSamplingContext::Feet (empty if not analyzed) */
+	TArray<FFootSyncComputeTrajectoryResult> Feet;
+
+	/** Whether the sequence was analyzed on the GPU */
+	bool IsValid() const { return Feet.Num() > 0; }
+};
+
+/**
+ * Detection from GPU-computed candidates
+ * The GPU finds the candidate frames of the whole batch; confidence, contact classification,
+ * saliency window suppression and the composite merge reuse the CPU detectors, so the
+ * results match the CPU path up to float rounding of the signals.
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncGpuDetection
+{
+	/** Whether GPU analysis can run in this process */
+	static bool IsAvailable();
+
+	/**
+	 * Analyze every foot of the given sequences in one GPU batch (game thread)
+	 * @param Contexts Sampled sequences, invalid contexts are skipped
+	 * @param Config Detection configuration shared by the batch
+	 * @param OutSignals Receives one entry per context
+	 * @return False if the GPU analysis failed, every entry is then invalid
+	 */
+	static bool Analyze(
+		TConstArrayView<const FFootSyncSamplingContext*> Contexts,
+		const FFootSyncDetectionConfig& Config,
+		TArray<FFootSyncGpuSignals>& OutSignals);
+
+	/**
+	 * Build the contact results of one foot from its GPU candidates (any thread)
+	 * @return False if the foot was not analyzed, the caller should detect on the CPU
+	 */
+	static bool DetectContacts(
+		const FFootSyncGpuSignals& Signals,
+		const FFootSyncSamplingContext& Context,
+		const FSyncFootDefinition& Foot,
+		const FLocomotionPreset& Preset,
+		const FFootSyncDetectionConfig& Config,
+		TArray<FFootContactResult>& OutResults);
+
+private:
+	/** Candidate kinds needed by the detection method */
+	static FFootSyncComputeParams MakeParams(const FFootSyncDetectionConfig& Config);
+};
@@ -0,0 +1,342 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+#include "Detection/TrajectoryFilters.h"
+
+class UAnimSequence;
+
+/**
+ * Contiguous struct-of-arrays position stream, one entry per sampled frame
+ */
+struct FOOTSYNCMARKERGENERATOR_API FTrajectoryStream
+{
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+
+	/** Resize all components to the given frame count */
+	void SetNum(int32 NumFrames)
+	{
+		X.SetNumUninitialized(NumFrames);
+		Y.SetNumUninitialized(NumFrames);
+		Z.SetNumUninitialized(NumFrames);
+	}
+
+	/** Release all samples */
+	void Reset()
+	{
+		X.Reset();
+		Y.Reset();
+		Z.Reset();
+	}
+
+	/** Number of frames in the stream */
+	int32 Num() const { return X.Num(); }
+
+	/** Position at the given frame */
+	FVector GetPosition(int32 Frame) const
+	{
+		return FVector(X[Frame], Y[Frame], Z[Frame]);
+	}
+
+	/**
+	 * Position at any frame of a cyclic stream, whose last frame repeats the first one cycle later
+	 * Frames outside [0, Num) wrap around and are offset by the displacement over a cycle (root motion).
+	 */
+	FVector GetCyclicPosition(int32 Frame) const
+	{
+		const int32 Period = Num() - 1;
+		const int32 Cycles = FMath::DivideAndRoundDown(Frame, Period);
+		return GetPosition(Frame - Cycles * Period) + (GetPosition(Period) - GetPosition(0)) * Cycles;
+	}
+
+	/** Store the position for the given frame */
+	void SetPosition(int32 Frame, const FVector& Position)
+	{
+		X[Frame] = static_cast<float>(Position.X);
+		Y[Frame] = static_cast<float>(Position.Y);
+		Z[Frame] = static_cast<float>(Position.Z);
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FTrajectoryStream& Stream)
+	{
+		Ar << Stream.X;
+		Ar << Stream.Y;
+		Ar << Stream.Z;
+		return Ar;
+	}
+};
+
+/**
+ * Derived per-frame signals of a foot trajectory that detectors can request
+ */
+enum class EFootSyncTrajectorySignals : uint8
+{
+	None				= 0,
+
+	/** Finite-difference speed of the foot position (FTrajectoryKernels::ComputeSpeed) */
+	Speed				= 1 << 0,
+
+	/** Menger curvature of the foot position (FTrajectoryKernels::ComputeCurvature) */
+	Curvature			= 1 << 1,
+
+	/** Pelvis-relative position projected on its dominant horizontal axis */
+	PelvisProjection	= 1 << 2,
+
+	All					= Speed | Curvature | PelvisProjection
+};
+ENUM_CLASS_FLAGS(EFootSyncTrajectorySignals);
+
+/**
+ * Sampled trajectories of a single foot bone
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootTrajectory
+{
+	/** Foot bone the trajectories were sampled from */
+	FName BoneName;
+
+	/** Foot position in animation (component) space */
+	FTrajectoryStream Position;
+
+	/** Foot position relative to the pelvis, in pelvis space */
+	FTrajectoryStream PelvisRelative;
+
+	// Derived signals, one entry per frame once computed (empty otherwise, never serialized)
+
+	/** Foot speed (cm/s) */
+	TArray<float> Speed;
+
+	/** Curvature of the foot path */
+	TArray<float> Curvature;
+
+	/** Pelvis-relative position along its dominant horizontal axis (cm) */
+	TArray<float> PelvisProjection;
+
+	friend FArchive& operator<<(FArchive& Ar, FFootTrajectory& Trajectory)
+	{
+		Ar << Trajectory.BoneName;
+		Ar << Trajectory.Position;
+		Ar << Trajectory.PelvisRelative;
+		return Ar;
+	}
+};
+
+/**
+ * Options controlling how poses are evaluated when sampling a sequence
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncSamplingOptions
+{
+	/** Frame stride of the coarse pass (1 evaluates every key) */
+	int32 CoarseStride = 1;
+
+	/** Minimum number of keys before the coarse pass is used */
+	int32 CoarseMinFrames = 0;
+
+	/** Extra frames evaluated at full rate on each side of a candidate interval */
+	int32 RefinementRadius = 0;
+
+	/** Whether the sequence is sampled as a cycle */
+	EFootSyncCycleMode CycleMode = EFootSyncCycleMode::Open;
+
+	/** Maximum first/last pose difference for automatic cycle detection (cm) */
+	float CyclicPoseTolerance = 1.0f;
+
+	/** Smoothing applied to every sampled trajectory once sampling is complete */
+	FTrajectoryFilterSettings Smoothing;
+};
+
+/**
+ * Frame times and bone trajectories for a single animation sequence
+ * Built once per sequence and shared by every detector and curve pass.
+ * Only the pelvis and foot bones of the preset are kept. Key-aligned samples of
+ * plain sequences read the chain bone tracks straight from the data model; other
+ * sequences evaluate full poses in bounded chunks, discarded after extraction. Component-space
+ * transforms are composed from local transforms along the parent chains of
+ * those bones only, once per frame, with shared ancestors composed once.
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncSamplingContext
+{
+	/** Sequence the trajectories were sampled from */
+	const UAnimSequence* AnimSequence = nullptr;
+
+	/** Time of each sampled frame in seconds, shared by all detectors and curve passes */
+	TArray<double> Times;
+
+	/** Pelvis bone the relative trajectories are measured from */
+	FName PelvisBoneName;
+
+	/** Pelvis position in animation (component) space */
+	FTrajectoryStream Pelvis;
+
+	/** Trajectories for each foot of the preset */
+	TArray<FFootTrajectory> Feet;
+
+	/** Number of frames whose pose was evaluated, the rest were interpolated */
+	int32 NumEvaluatedFrames = 0;
+
+	/** Whether the last frame repeats the first, so signals wrap around instead of ending */
+	bool bCyclic = false;
+
+	/**
+	 * Sample every key of the given sequence for the bones of the preset
+	 * With a coarse stride, sequences that need pose evaluation are sampled coarse-to-fine:
+	 * a strided pass is evaluated first and only frames near candidate contacts (speed and
+	 * height minima, pelvis crossings) are evaluated at full rate. The remaining frames are
+	 * linearly interpolated. Key-aligned bone track reads always cover every key. Cyclic sequences only
+	 * refine their ends around candidates, like any other frame. The optional smoothing
+	 * pre-pass runs last, once per bone, so all detectors and curve passes share it.
+	 * @param InAnimSequence Animation sequence to sample
+	 * @param Preset Locomotion preset providing the pelvis and foot bones
+	 * @param Options Coarse-to-fine sampling options
+	 * @return True if every frame was sampled
+	 */
+	bool Initialize(
+		const UAnimSequence* InAnimSequence,
+		const FLocomotionPreset& Preset,
+		const FFootSyncSamplingOptions& Options = FFootSyncSamplingOptions());
+
+	/**
+	 * Sample a range of keys only, for sequences processed in chunks
+	 * Times and trajectories hold just the given keys (index 0 is FirstFrame). The range is never cyclic.
+	 * @param InAnimSequence Animation sequence to sample
+	 * @param Preset Locomotion preset providing the pelvis and foot bones
+	 * @param FirstFrame First key to sample
+	 * @param NumFrames Number of keys to sample
+	 * @return True if every frame of the range was sampled
+	 */
+	bool InitializeFrameRange(
+		const UAnimSequence* InAnimSequence,
+		const FLocomotionPreset& Preset,
+		int32 FirstFrame,
+		int32 NumFrames);
+
+	/**
+	 * Compute the requested signals of every foot once, so all detectors share them
+	 * Speed and curvature are fused into a single pass over the foot positions.
+	 * Signals that are already computed are kept. Detectors compute any signal
+	 * that was not requested themselves, so this is purely an optimization.
+	 * @param Signals Signals to compute
+	 */
+	void ComputeSignals(EFootSyncTrajectorySignals Signals);
+
+	/**
+	 * Serialize the sampled data (the source sequence is not serialized)
+	 * Allows recorded trajectories to be replayed without the animation asset
+	 */
+	void Serialize(FArchive& Ar);
+
+	/** Number of sampled frames */
+	int32 GetNumFrames() const { return Times.Num(); }
+
+	/** Duration of one cycle (seconds), only meaningful for cyclic sequences */
+	double GetCyclePeriod() const { return Times.Num() > 1 ? Times.Last() - Times[0] : 0.0; }
+
+	/** Whether trajectories were sampled for every frame */
+	bool IsValid() const { return Times.Num() > 0 && Pelvis.Num() == Times.Num(); }
+
+	/** Find the trajectories of the given foot bone (nullptr if not sampled) */
+	const FFootTrajectory* FindFoot(FName BoneName) const
+	{
+		return Feet.FindByPredicate([BoneName](const FFootTrajectory& Foot)
+		{
+			return Foot.BoneName == BoneName;
+		});
+	}
+
+private:
+	/** Maximum number of full poses alive at once during extraction */
+	static constexpr int32 PoseChunkSize = 256;
+
+	/** Bones on the parent chains of the pelvis and feet, parents before children */
+	TArray<FName> ChainBoneNames;
+
+	/** Parent of each chain bone as an index into ChainBoneNames (INDEX_NONE for the root) */
+	TArray<int32> ChainParentIndices;
+
+	/** Chain index of the pelvis bone */
+	int32 PelvisChainIndex = INDEX_NONE;
+
+	/** Chain index of each foot bone, parallel to Feet */
+	TArray<int32> FootChainIndices;
+
+	/** Reference pose local transform of each chain bone, used for bones without a track */
+	TArray<FTransform> ChainRefTransforms;
+
+	/** Chain bones whose translation comes from the skeleton (Skeleton translation retargeting) */
+	TBitArray<> ChainRefTranslations;
+
+	/** First key of the sampled range */
+	int32 FirstKey = 0;
+
+	/** Whether frames can be read from the bone tracks instead of evaluating poses */
+	bool bReadBoneTracks = false;
+
+	/**
+	 * Reset the context and allocate the buffers for the given range of keys
+	 * @return False if the sequence, pelvis bone or range is invalid
+	 */
+	bool SetupFrames(
+		const UAnimSequence* InAnimSequence,
+		const FLocomotionPreset& Preset,
+		int32 FirstFrame,
+		int32 NumFrames);
+
+	/**
+	 * Collect the parent chains of the pelvis and foot bones from the reference skeleton
+	 * @return False if the skeleton is missing or a bone is not part of it
+	 */
+	bool BuildBoneChains();
+
+	/**
+	 * Evaluate the poses of the given frames and store the bone positions
+	 * @return False if pose evaluation failed
+	 */
+	bool EvaluateFrames(TConstArrayView<int32> Frames);
+
+	/**
+	 * Whether every sample is a key and a key's pose equals its bone track keys
+	 * Additive, root-locked and retarget-source sequences are modified on evaluation.
+	 */
+	bool CanReadBoneTracks() const;
+
+	/**
+	 * Read the chain bone tracks at the keys of the given frames and store the bone positions
+	 * No pose is built and nothing is interpolated.
+	 */
+	void ReadBoneTracks(TConstArrayView<int32> Frames);
+
+	/**
+	 * Compose the component-space chain transforms of a frame and store the bone positions
+	 * @param Frame Frame to store
+	 * @param ChainTransforms Local transforms of the chain bones on input, component space on output
+	 */
+	void StoreChainFrame(int32 Frame, TArray<FTransform>& ChainTransforms);
+
+	/**
+	 * Decide whether the sequence is cyclic from the options and the first and last frames
+	 * Cyclic sequences need at least three frames, so one frame separates the seam.
+	 */
+	void ResolveCycle(const FFootSyncSamplingOptions& Options);
+
+	/**
+	 * Mark the frames around candidate contacts found in the coarse samples
+	 * Pelvis line crossings are found on each foot's dominant pelvis-relative axis,
+	 * the same axis the pelvis crossing detector projects the full-rate frames onto.
+	 * @param CoarseFrames Frames evaluated by the coarse pass, in ascending order
+	 * @param Radius Extra frames marked on each side of a candidate interval
+	 * @param OutRefine Set for every frame to evaluate at full rate
+	 */
+	void FindRefinementFrames(
+		TConstArrayView<int32> CoarseFrames,
+		int32 Radius,
+		TBitArray<>& OutRefine) const;
+
+	/** Smooth the pelvis and foot trajectories in place */
+	void SmoothTrajectories(const FTrajectoryFilterSettings& Smoothing);
+
+	/** Linearly interpolate every frame that was not evaluated */
+	void InterpolateFrames(const TBitArray<>& Evaluated);
+};
@@ -0,0 +1,67 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+#include "Detection/FootSyncSamplingContext.h"
+
+/**
+ * Golden detection results of a single foot, one set per detection method
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncFixtureFootResults
+{
+	/** Foot bone the results belong to */
+	FName BoneName;
+
+	TArray<FFootContactResult> PelvisCrossing;
+	TArray<FFootContactResult> VelocityCurve;
+	TArray<FFootContactResult> Saliency;
+	TArray<FFootContactResult> Composite;
+	TArray<FFootContactResult> GroundHeight;
+
+	/** Results recorded for the given method */
+	TArray<FFootContactResult>& GetResults(EFootContactDetectionMethod Method);
+	const TArray<FFootContactResult>& GetResults(EFootContactDetectionMethod Method) const;
+};
+
+/**
+ * Recorded trajectories and golden results used by the detector benchmark
+ * Holds everything the detectors read, so fixtures replay without the source
+ * animation asset and can be checked into a repository alongside the plugin.
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncTrajectoryFixture
+{
+	/** Display name, usually the source sequence name */
+	FString Name;
+
+	/** Preset the trajectories were sampled with */
+	FLocomotionPreset Preset;
+
+	/** Sampled trajectories */
+	FFootSyncSamplingContext Context;
+
+	/** Golden results for each foot of the preset */
+	TArray<FFootSyncFixtureFootResults> Feet;
+
+	/** File extension of fixture files */
+	static const TCHAR* FileExtension;
+
+	/**
+	 * Save the fixture to disk
+	 * @return True if the file was written
+	 */
+	bool SaveToFile(const FString& Filename) const;
+
+	/**
+	 * Load a fixture from disk
+	 * @return False if the file is missing or holds an incompatible format
+	 */
+	bool LoadFromFile(const FString& Filename);
+
+	/**
+	 * Serialize the fixture in the versioned fixture format
+	 * @return False if the archive holds an incompatible format
+	 */
+	bool Serialize(FArchive& Ar);
+};
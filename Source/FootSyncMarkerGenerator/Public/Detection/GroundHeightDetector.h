@@ -0,0 +1,87 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IFootContactDetector.h"
+
+/**
+ * Detects foot contacts from the foot height above the local ground
+ *
+ * The ground is estimated per frame as a low percentile of the foot height over a rolling
+ * window, so slopes and stairs follow the stance height of the current step. Only stance
+ * frames enter the window, so a window that falls inside a long swing has no ground and
+ * the vertically still apex of the swing is never taken for a contact. The foot plants
+ * when it is close to the ground and not moving vertically, and lifts off once it rises above
+ * twice the contact height (the hysteresis keeps heel-toe roll from toggling contacts).
+ * Both contacts and lift-offs are reported, in time order.
+ */
+class FOOTSYNCMARKERGENERATOR_API FGroundHeightDetector : public IFootContactDetector
+{
+public:
+	/** Detector configured from the current project settings (game thread) */
+	FGroundHeightDetector();
+	explicit FGroundHeightDetector(const FFootSyncDetectionConfig& InConfig);
+	virtual ~FGroundHeightDetector() = default;
+
+	// IFootContactDetector interface
+	virtual TArray<FFootContactResult> DetectContacts(
+		const FFootSyncSamplingContext& Context,
+		const FSyncFootDefinition& Foot,
+		const FLocomotionPreset& Preset) override;
+
+	virtual FString GetDetectorName() const override { return TEXT("GroundHeight"); }
+
+	/**
+	 * Height of each frame above its rolling low-percentile ground
+	 * A histogram of the heights in the window is slid along the frames with a cursor kept
+	 * on the percentile bin, so each frame costs a few bin steps instead of a sort.
+	 * @param Heights Foot height at each frame
+	 * @param HalfWindow Frames on each side of the frame the ground is estimated for
+	 * @param Percentile Rank of the ground height in the window (0.0 - 1.0)
+	 * @param bCyclic Whether the last frame repeats the first one cycle later
+	 * @param GroundFrames Frames the ground is estimated from, empty for all frames
+	 * @param OutClearances Height above the ground at each frame, the float maximum where
+	 *        the window holds no ground frame
+	 */
+	static void CalculateClearances(
+		TConstArrayView<float> Heights,
+		int32 HalfWindow,
+		float Percentile,
+		bool bCyclic,
+		const TBitArray<>& GroundFrames,
+		TArrayView<float> OutClearances);
+
+	/**
+	 * Frames the foot may be on the ground at
+	 * These are the runs of vertically still frames the foot enters descending and leaves
+	 * ascending. The apex of a swing is entered ascending, so it is never ground. Runs at open
+	 * clip ends are checked on their one side, and a clip without vertical motion is all ground.
+	 * @param VerticalSpeeds Vertical speed of each frame (cm/s)
+	 * @param SpeedThreshold Largest vertical speed of a still frame (cm/s)
+	 * @param bCyclic Whether the last frame repeats the first one cycle later
+	 * @param OutGroundFrames Set for the ground frames, empty if there are none
+	 */
+	static void FindGroundFrames(
+		TConstArrayView<float> VerticalSpeeds,
+		float SpeedThreshold,
+		bool bCyclic,
+		TBitArray<>& OutGroundFrames);
+
+	/**
+	 * Central-difference vertical speed of each frame (cm/s)
+	 * Open ends use one-sided differences, cyclic ends difference across the seam.
+	 */
+	static void CalculateVerticalSpeeds(
+		TConstArrayView<float> Heights,
+		TConstArrayView<double> Times,
+		bool bCyclic,
+		TArrayView<float> OutSpeeds);
+
+private:
+	/** Configuration snapshot */
+	const FFootSyncDetectionConfig Config;
+
+	/** Confidence of a transition, higher for a vertically still foot */
+	float GetConfidence(float VerticalSpeed) const;
+};
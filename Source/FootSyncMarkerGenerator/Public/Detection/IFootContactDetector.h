@@ -4,11 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "LocomotionPresets.h"
+#include "FootSyncDetectionConfig.h"
 
-class UAnimSequence;
+struct FFootSyncSamplingContext;
+struct FFootSyncClipStats;
 
 /**
  * Interface for foot contact detection algorithms
+ * Implementations are configured with an FFootSyncDetectionConfig snapshot at construction
+ * and only read their inputs, so DetectContacts can run on any thread.
  */
 class FOOTSYNCMARKERGENERATOR_API IFootContactDetector
 {
@@ -17,22 +21,19 @@ public:
 
 	/**
 	 * Detect foot contact times in the given animation sequence
-	 * @param AnimSequence Animation sequence to analyze
+	 * @param Context Frame times and poses sampled from the sequence to analyze
 	 * @param Foot Foot definition (bone name, etc.)
 	 * @param Preset Locomotion preset (pelvis bone, move axis, etc.)
 	 * @return Array of contact results with times and confidence
 	 */
 	virtual TArray<FFootContactResult> DetectContacts(
-		UAnimSequence* AnimSequence,
+		const FFootSyncSamplingContext& Context,
 		const FSyncFootDefinition& Foot,
 		const FLocomotionPreset& Preset) = 0;
 
 	/** Get detector name for logging/debugging */
 	virtual FString GetDetectorName() const = 0;
 
-	/** Set velocity threshold (optional, for detectors that use it) */
-	virtual void SetVelocityThreshold(float Threshold) {}
-
-	/** Set saliency threshold (optional, for detectors that use it) */
-	virtual void SetSaliencyThreshold(float Threshold) {}
+	/** Add the counters gathered by DetectContacts to the statistics of the clip */
+	virtual void AddClipStats(FFootSyncClipStats& OutStats) const {}
 };
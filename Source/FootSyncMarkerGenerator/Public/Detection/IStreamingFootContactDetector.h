@@ -0,0 +1,53 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+#include "FootSyncDetectionConfig.h"
+#include "FootSyncFrameHistory.h"
+
+struct FFootTrajectory;
+
+/**
+ * Incremental foot contact detection over consecutive chunks of frames
+ * Detectors keep only a small lookback window, so memory does not grow with the
+ * take length. Results are appended as soon as no later frame can change them.
+ *
+ * Usage: Begin once per foot, ProcessChunk for each chunk in time order, then Finish.
+ */
+class FOOTSYNCMARKERGENERATOR_API IStreamingFootContactDetector
+{
+public:
+	virtual ~IStreamingFootContactDetector() = default;
+
+	/**
+	 * Start a new take, discarding any previous state
+	 * @param Foot Foot definition (bone name, etc.)
+	 * @param Preset Locomotion preset (move axis, etc.)
+	 */
+	virtual void Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset) = 0;
+
+	/**
+	 * Consume the next frames of the take
+	 * @param Times Time of each frame in seconds, continuing the previous chunk
+	 * @param Frames Foot positions for the same frames (Position and PelvisRelative)
+	 * @param OutResults Receives the results that became final, in time order
+	 */
+	virtual void ProcessChunk(
+		TConstArrayView<double> Times,
+		const FFootTrajectory& Frames,
+		TArray<FFootContactResult>& OutResults) = 0;
+
+	/**
+	 * End the take and flush the results still waiting for lookahead frames
+	 * @param OutResults Receives the remaining results, in time order
+	 */
+	virtual void Finish(TArray<FFootContactResult>& OutResults) = 0;
+
+	/** Time before which no further results will be emitted */
+	virtual double GetFinalizedTime() const = 0;
+
+	/** Get detector name for logging/debugging */
+	virtual FString GetDetectorName() const = 0;
+};
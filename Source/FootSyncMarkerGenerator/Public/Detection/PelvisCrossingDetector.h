@@ -12,38 +12,19 @@
 class FOOTSYNCMARKERGENERATOR_API FPelvisCrossingDetector : public IFootContactDetector
 {
 public:
-	FPelvisCrossingDetector() = default;
+	/** Detector configured from the current project settings (game thread) */
+	FPelvisCrossingDetector();
+	explicit FPelvisCrossingDetector(const FFootSyncDetectionConfig& InConfig);
 	virtual ~FPelvisCrossingDetector() = default;
 
 	// IFootContactDetector interface
 	virtual TArray<FFootContactResult> DetectContacts(
-		UAnimSequence* AnimSequence,
+		const FFootSyncSamplingContext& Context,
 		const FSyncFootDefinition& Foot,
 		const FLocomotionPreset& Preset) override;
 
 	virtual FString GetDetectorName() const override { return TEXT("PelvisCrossing"); }
 
-private:
-	/**
-	 * Get foot position relative to pelvis
-	 * @param Pose Animation pose at a given time
-	 * @param PelvisBone Name of the pelvis bone
-	 * @param FootBone Name of the foot bone
-	 * @return 3D position relative to pelvis
-	 */
-	FVector GetFootRelativePosition(
-		const struct FAnimPose& Pose,
-		FName PelvisBone,
-		FName FootBone);
-
-	/**
-	 * Determine the primary movement axis from foot trajectory
-	 * Analyzes X and Y range to find the dominant movement direction
-	 * @param Positions Array of foot positions relative to pelvis
-	 * @return Normalized axis vector (X or Y dominant)
-	 */
-	FVector DeterminePrimaryMoveAxis(const TArray<FVector>& Positions);
-
 	/**
 	 * Interpolate the exact crossing time between two frames
 	 * @param Time1 Time of first frame
@@ -52,5 +33,20 @@ private:
 	 * @param Pos2 Position at second frame
 	 * @return Interpolated time when position crosses zero
 	 */
-	float InterpolateCrossingTime(float Time1, float Pos1, float Time2, float Pos2);
+	static float InterpolateCrossingTime(float Time1, float Pos1, float Time2, float Pos2);
+
+	/**
+	 * Build the result for a sign change of the projected foot position between two frames
+	 * Shared with the GPU trajectory analysis, which finds the crossings on the device
+	 */
+	FFootContactResult MakeCrossingResult(double PrevTime, float PrevPos, double CurrTime, float CurrPos) const;
+
+	/**
+	 * Build the result for a crossing between the last and first frame (looping animations)
+	 */
+	FFootContactResult MakeLoopBoundaryResult(double LastTime, float FirstPos, float LastPos) const;
+
+private:
+	/** Configuration snapshot */
+	const FFootSyncDetectionConfig Config;
 };
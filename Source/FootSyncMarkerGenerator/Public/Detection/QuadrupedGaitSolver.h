@@ -0,0 +1,77 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+#include "FootSyncDetectionConfig.h"
+
+struct FFootSyncSamplingContext;
+
+/**
+ * Gait-aware contact detection for four-legged presets
+ *
+ * Walk, trot and pace all alternate the left and right feet of a pair half a cycle
+ * apart. The left fore and hind feet are detected over the whole sequence; their
+ * contacts give the gait period, and the right feet are only searched in windows
+ * around the contacts shifted by half a period. A foot falls back to full detection
+ * when the period is irregular or too few predicted contacts are confirmed (e.g. gallop).
+ */
+class FOOTSYNCMARKERGENERATOR_API FQuadrupedGaitSolver
+{
+public:
+	/** Full detection of a single foot over the given trajectories */
+	using FDetectFootFunc = TFunctionRef<TArray<FFootContactResult>(const FFootSyncSamplingContext&, const FSyncFootDefinition&)>;
+
+	explicit FQuadrupedGaitSolver(const FFootSyncDetectionConfig& InConfig);
+
+	/**
+	 * Detect the contacts of all four feet
+	 * @param Context Trajectories sampled for every foot of the preset
+	 * @param Preset Quadruped preset with front/back, left/right labels
+	 * @param DetectFoot Full detection of one foot (thread-safe)
+	 * @param OutResults Receives the results of each foot bone
+	 * @return False if the preset does not label all four feet; nothing is detected then
+	 */
+	bool Solve(
+		const FFootSyncSamplingContext& Context,
+		const FLocomotionPreset& Preset,
+		FDetectFootFunc DetectFoot,
+		TMap<FName, TArray<FFootContactResult>>& OutResults) const;
+
+private:
+	/** Maximum relative spread of the step intervals for the gait period to be trusted */
+	static constexpr float MaxPeriodDeviation = 0.25f;
+
+	/** Configuration snapshot */
+	const FFootSyncDetectionConfig Config;
+
+	/**
+	 * Estimate the gait period from the confident contacts of a foot
+	 * @return Median interval between contacts in seconds, or zero if irregular or too few contacts
+	 */
+	float EstimatePeriod(const TArray<FFootContactResult>& Results) const;
+
+	/**
+	 * Detect a foot only around the predicted contact times
+	 * @param OutResults Receives the results found inside the search windows
+	 * @return False if too few predicted contacts were confirmed
+	 */
+	bool DetectPredicted(
+		const FFootSyncSamplingContext& Context,
+		const FSyncFootDefinition& Foot,
+		TConstArrayView<float> PredictedTimes,
+		float WindowRadius,
+		FDetectFootFunc DetectFoot,
+		TArray<FFootContactResult>& OutResults) const;
+
+	/**
+	 * Copy a range of frames of one foot into a standalone context
+	 */
+	static void MakeSlice(
+		const FFootSyncSamplingContext& Context,
+		const FFootTrajectory& Foot,
+		int32 FirstFrame,
+		int32 NumFrames,
+		FFootSyncSamplingContext& OutSlice);
+};
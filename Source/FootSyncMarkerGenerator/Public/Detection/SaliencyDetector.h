@@ -15,59 +15,74 @@
 class FOOTSYNCMARKERGENERATOR_API FSaliencyDetector : public IFootContactDetector
 {
 public:
-	FSaliencyDetector() = default;
+	/** Detector configured from the current project settings (game thread) */
+	FSaliencyDetector();
+	explicit FSaliencyDetector(const FFootSyncDetectionConfig& InConfig);
 	virtual ~FSaliencyDetector() = default;
 
 	// IFootContactDetector interface
 	virtual TArray<FFootContactResult> DetectContacts(
-		UAnimSequence* AnimSequence,
+		const FFootSyncSamplingContext& Context,
 		const FSyncFootDefinition& Foot,
 		const FLocomotionPreset& Preset) override;
 
 	virtual FString GetDetectorName() const override { return TEXT("Saliency"); }
 
-	virtual void SetSaliencyThreshold(float Threshold) override { SaliencyThresholdOverride = Threshold; bHasThresholdOverride = true; }
+	/**
+	 * Build the result for an accepted salient point
+	 * Shared with the GPU trajectory analysis, which finds the candidates on the device
+	 * @param Positions Foot positions, used to classify contact vs lift-off
+	 * @param Times Time at each frame
+	 * @param Index Frame of the salient point
+	 * @param Curvature Curvature at the salient point
+	 * @param MaxCurvature Maximum curvature of the trajectory
+	 * @param bCyclic Whether the trajectory wraps around from the last frame to the first
+	 */
+	FFootContactResult MakeSalientResult(
+		const struct FTrajectoryStream& Positions,
+		TConstArrayView<double> Times,
+		int32 Index,
+		float Curvature,
+		float MaxCurvature,
+		bool bCyclic = false) const;
 
 private:
-	bool bHasThresholdOverride = false;
-	float SaliencyThresholdOverride = 0.0f;
+	/** Configuration snapshot */
+	const FFootSyncDetectionConfig Config;
 
 	/**
 	 * Calculate curvature at each point on the trajectory
-	 * Curvature k = |dT/ds| where T is the unit tangent vector
-	 * @param Positions Array of 3D positions
-	 * @param Times Array of times
+	 * Uses the discrete Menger curvature of each frame and its neighbors
+	 * @param Positions 3D positions at each frame
+	 * @param bCyclic Whether the trajectory wraps around from the last frame to the first
 	 * @return Array of curvature values
 	 */
-	TArray<float> CalculateCurvature(
-		const TArray<FVector>& Positions,
-		const TArray<float>& Times);
-
-	/**
-	 * Calculate the discrete curvature at a single point using Menger curvature
-	 * k = 4*Area(P0,P1,P2) / (|P0-P1| * |P1-P2| * |P2-P0|)
-	 */
-	float CalculatePointCurvature(const FVector& P0, const FVector& P1, const FVector& P2);
+	TArray<float> CalculateCurvature(const struct FTrajectoryStream& Positions, bool bCyclic);
 
 	/**
 	 * Find salient points where curvature changes rapidly
+	 * Single time-ordered pass; accepted points are at least WindowSize apart
+	 * (across the seam too for cyclic data, whose last frame is not tested again)
 	 * @param Curvatures Array of curvature values
-	 * @param Times Array of times
+	 * @param Times Array of times (non-decreasing)
 	 * @param WindowSize Size of analysis window in seconds
 	 * @param Threshold Saliency threshold for detection
+	 * @param bCyclic Whether the data wraps around from the last frame to the first
 	 * @return Indices of salient points
 	 */
 	TArray<int32> FindSalientPoints(
-		const TArray<float>& Curvatures,
-		const TArray<float>& Times,
+		TConstArrayView<float> Curvatures,
+		TConstArrayView<double> Times,
 		float WindowSize,
-		float Threshold);
+		float Threshold,
+		bool bCyclic);
 
 	/**
 	 * Determine if a salient point represents a foot contact (vs lift-off)
 	 * based on the height change direction
 	 */
 	bool IsFootContact(
-		const TArray<FVector>& Positions,
-		int32 SalientIndex);
+		const struct FTrajectoryStream& Positions,
+		int32 SalientIndex,
+		bool bCyclic) const;
 };
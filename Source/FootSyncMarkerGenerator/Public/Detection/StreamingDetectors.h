@@ -0,0 +1,235 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IStreamingFootContactDetector.h"
+#include "CompositeDetector.h"
+
+class UAnimSequence;
+
+/**
+ * Streaming counterpart of FPelvisCrossingDetector
+ * Needs one frame of lookback. Crossings are projected onto the preset's primary move
+ * axis, since the dominant axis of the whole take is not known up front.
+ */
+class FOOTSYNCMARKERGENERATOR_API FStreamingPelvisCrossingDetector : public IStreamingFootContactDetector
+{
+public:
+	explicit FStreamingPelvisCrossingDetector(const FFootSyncDetectionConfig& InConfig);
+
+	// IStreamingFootContactDetector interface
+	virtual void Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset) override;
+	virtual void ProcessChunk(TConstArrayView<double> Times, const FFootTrajectory& Frames, TArray<FFootContactResult>& OutResults) override;
+	virtual void Finish(TArray<FFootContactResult>& OutResults) override;
+	virtual double GetFinalizedTime() const override;
+	virtual FString GetDetectorName() const override { return TEXT("PelvisCrossing"); }
+
+private:
+	/** Configuration snapshot */
+	const FFootSyncDetectionConfig Config;
+
+	/** Axis the pelvis-relative positions are projected onto */
+	FVector MoveAxis = FVector::ForwardVector;
+
+	/** Projected position of the first frame (loop boundary test) */
+	float FirstPosition = 0.0f;
+
+	/** Time and projected position of the newest frame */
+	double LastTime = 0.0;
+	float LastPosition = 0.0f;
+
+	/** Number of frames consumed */
+	int64 NumFrames = 0;
+
+	bool bFinished = false;
+};
+
+/**
+ * Streaming counterpart of FVelocityCurveDetector
+ * A minimum is final two frames later. Confidence is scaled by the highest speed seen
+ * so far instead of the highest speed of the whole take.
+ */
+class FOOTSYNCMARKERGENERATOR_API FStreamingVelocityCurveDetector : public IStreamingFootContactDetector
+{
+public:
+	explicit FStreamingVelocityCurveDetector(const FFootSyncDetectionConfig& InConfig);
+
+	// IStreamingFootContactDetector interface
+	virtual void Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset) override;
+	virtual void ProcessChunk(TConstArrayView<double> Times, const FFootTrajectory& Frames, TArray<FFootContactResult>& OutResults) override;
+	virtual void Finish(TArray<FFootContactResult>& OutResults) override;
+	virtual double GetFinalizedTime() const override;
+	virtual FString GetDetectorName() const override { return TEXT("VelocityCurve"); }
+
+private:
+	/** Number of speeds kept (the candidate and its neighbors) */
+	static constexpr int32 SpeedWindow = 3;
+
+	/** Configuration snapshot */
+	const FFootSyncDetectionConfig Config;
+
+	/** Most recent frames */
+	FFootSyncFrameHistory History;
+
+	/** Most recent speeds and their frame times (index 0 = newest) */
+	float Speeds[SpeedWindow] = {};
+	double SpeedTimes[SpeedWindow] = {};
+	int64 NumSpeeds = 0;
+
+	/** Highest speed seen so far */
+	float MaxSpeed = 0.0f;
+
+	bool bFinished = false;
+
+	/** Add the speed of the next frame and test the frame before it for a minimum */
+	void AddSpeed(float Speed, double Time, TArray<FFootContactResult>& OutResults);
+
+	/** Append a contact at the given speed */
+	void AddResult(float Speed, double Time, TArray<FFootContactResult>& OutResults) const;
+};
+
+/**
+ * Streaming counterpart of FSaliencyDetector
+ * A salient point is final two frames later. The adaptive threshold and the confidence
+ * scale come from the curvature statistics seen so far, and suppression only needs the
+ * last accepted point (SaliencyWindowSize).
+ */
+class FOOTSYNCMARKERGENERATOR_API FStreamingSaliencyDetector : public IStreamingFootContactDetector
+{
+public:
+	explicit FStreamingSaliencyDetector(const FFootSyncDetectionConfig& InConfig);
+
+	// IStreamingFootContactDetector interface
+	virtual void Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset) override;
+	virtual void ProcessChunk(TConstArrayView<double> Times, const FFootTrajectory& Frames, TArray<FFootContactResult>& OutResults) override;
+	virtual void Finish(TArray<FFootContactResult>& OutResults) override;
+	virtual double GetFinalizedTime() const override;
+	virtual FString GetDetectorName() const override { return TEXT("Saliency"); }
+
+private:
+	/** Number of curvatures kept (the candidate and its neighbors) */
+	static constexpr int32 CurvatureWindow = 3;
+
+	/** Configuration snapshot */
+	const FFootSyncDetectionConfig Config;
+
+	/** Most recent frames */
+	FFootSyncFrameHistory History;
+
+	/** Most recent curvatures, their frame times and derivatives (index 0 = newest) */
+	float Curvatures[CurvatureWindow] = {};
+	double CurvatureTimes[CurvatureWindow] = {};
+	float Derivatives[2] = {};
+	int64 NumCurvatures = 0;
+
+	/** Running statistics for the adaptive threshold and confidence */
+	double DerivativeSum = 0.0;
+	float MaxDerivative = 0.0f;
+	float MaxCurvature = 0.0f;
+
+	/** Time of the last accepted salient point (negative if none) */
+	float LastSalientTime = -1.0f;
+
+	bool bFinished = false;
+
+	/**
+	 * Add the curvature of the next frame and test the frame before it
+	 * @param CandidateAge History age of the frame before it
+	 */
+	void AddCurvature(float Curvature, double Time, int32 CandidateAge, TArray<FFootContactResult>& OutResults);
+
+	/** Contact vs lift-off from the height change around the frame with the given history age */
+	bool IsFootContact(int32 CandidateAge) const;
+};
+
+/**
+ * Streaming counterpart of FCompositeDetector
+ * Results of the individual detectors are buffered until no later result can join
+ * their cluster, then merged exactly like the batch detector.
+ */
+class FOOTSYNCMARKERGENERATOR_API FStreamingCompositeDetector : public IStreamingFootContactDetector
+{
+public:
+	explicit FStreamingCompositeDetector(const FFootSyncDetectionConfig& InConfig);
+
+	// IStreamingFootContactDetector interface
+	virtual void Begin(const FSyncFootDefinition& Foot, const FLocomotionPreset& Preset) override;
+	virtual void ProcessChunk(TConstArrayView<double> Times, const FFootTrajectory& Frames, TArray<FFootContactResult>& OutResults) override;
+	virtual void Finish(TArray<FFootContactResult>& OutResults) override;
+	virtual double GetFinalizedTime() const override;
+	virtual FString GetDetectorName() const override { return TEXT("Composite"); }
+
+private:
+	/** Configuration snapshot, shared with the individual detectors */
+	const FFootSyncDetectionConfig Config;
+
+	/** Batch detector providing the cluster merge */
+	FCompositeDetector Merger;
+
+	/** Individual detectors, nullptr when their weight is zero */
+	TUniquePtr<IStreamingFootContactDetector> Detectors[3];
+
+	/** Results not yet merged, in time order */
+	TArray<FFootContactResult> PendingResults;
+
+	/** Earliest finalized time of the individual detectors */
+	double FinalizedTime = 0.0;
+
+	/** Buffer the results of the individual detectors and emit every cluster that became final */
+	void EmitFinalClusters(TArray<FFootContactResult>& DetectorResults, TArray<FFootContactResult>& OutResults);
+};
+
+/**
+ * Chunked contact detection for sequences too long to sample at once
+ * Keys are sampled ChunkFrames at a time and fed to one streaming detector per foot,
+ * so peak memory depends on the chunk size and detector windows, not the take length.
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncStreamingDetection
+{
+	/** Default number of keys sampled per chunk */
+	static constexpr int32 DefaultChunkFrames = 1024;
+
+	/**
+	 * Create a streaming detector for the given method
+	 * @return nullptr, with a warning, for methods without a streaming detector (GroundHeight)
+	 */
+	static TUniquePtr<IStreamingFootContactDetector> CreateDetector(
+		EFootContactDetectionMethod Method,
+		const FFootSyncDetectionConfig& Config);
+
+	/**
+	 * Whether the configured detection gives the same kind of results streamed
+	 * Registered detectors, ground height (alone or weighted into Composite), tiered
+	 * Composite, smoothing and forced cyclic sampling all need the whole take at once.
+	 */
+	static bool SupportsConfig(const FFootSyncDetectionConfig& Config);
+
+	/**
+	 * Detect the contacts of every foot of the preset with the configured method
+	 * @param AnimSequence Animation sequence to analyze
+	 * @param Preset Locomotion preset providing the pelvis and foot bones
+	 * @param Config Detection configuration
+	 * @param ChunkFrames Number of keys sampled at once
+	 * @param OutResults Receives the time-ordered results of each foot bone
+	 * @return False if the configuration cannot be streamed or sampling failed
+	 */
+	static bool DetectContacts(
+		const UAnimSequence* AnimSequence,
+		const FLocomotionPreset& Preset,
+		const FFootSyncDetectionConfig& Config,
+		int32 ChunkFrames,
+		TMap<FName, TArray<FFootContactResult>>& OutResults);
+
+	/**
+	 * Detect the contacts of every foot, handing each sampled chunk to the caller as well
+	 * @param OnChunk Called with every chunk in order, after its frames were detected
+	 */
+	static bool DetectContacts(
+		const UAnimSequence* AnimSequence,
+		const FLocomotionPreset& Preset,
+		const FFootSyncDetectionConfig& Config,
+		int32 ChunkFrames,
+		TMap<FName, TArray<FFootContactResult>>& OutResults,
+		TFunctionRef<void(const FFootSyncSamplingContext& Chunk)> OnChunk);
+};
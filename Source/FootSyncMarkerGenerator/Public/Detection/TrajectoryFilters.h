@@ -0,0 +1,69 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+
+struct FTrajectoryStream;
+
+/**
+ * Settings of the smoothing pre-pass applied to sampled trajectories
+ */
+struct FOOTSYNCMARKERGENERATOR_API FTrajectoryFilterSettings
+{
+	/** Filter to apply (None leaves the trajectories untouched) */
+	EFootSyncSmoothingFilter Filter = EFootSyncSmoothingFilter::None;
+
+	/** Savitzky-Golay half window in frames (the window spans 2 * HalfWindow + 1 frames) */
+	int32 HalfWindow = 2;
+
+	/** Butterworth cutoff frequency (Hz) */
+	float CutoffFrequency = 8.0f;
+};
+
+/**
+ * Linear-time smoothing filters over trajectory streams
+ * Both filters run in place on each component with a constant amount of work per frame.
+ * The ends are extended before filtering so no frame loses its neighbors: open streams
+ * by odd reflection (keeps the local slope), cyclic streams by wrapping around the seam.
+ */
+struct FOOTSYNCMARKERGENERATOR_API FTrajectoryFilters
+{
+	/**
+	 * Smooth every component of the stream
+	 * @param Stream Positions to smooth in place
+	 * @param Settings Filter and its parameters
+	 * @param SampleRate Uniform sample rate of the stream (Hz)
+	 * @param bCyclic Whether the last frame repeats the first one cycle later
+	 */
+	static void Smooth(
+		FTrajectoryStream& Stream,
+		const FTrajectoryFilterSettings& Settings,
+		double SampleRate,
+		bool bCyclic);
+
+	/**
+	 * Quadratic Savitzky-Golay smoothing with running moment sums
+	 * @param Values Samples to smooth in place
+	 * @param HalfWindow Frames on each side of the smoothed frame
+	 * @param bCyclic Whether the last sample repeats the first one cycle later
+	 */
+	static void SavitzkyGolay(TArrayView<float> Values, int32 HalfWindow, bool bCyclic);
+
+	/**
+	 * Zero-phase second-order Butterworth low-pass (forward and backward pass)
+	 * @param Values Samples to smooth in place
+	 * @param CutoffFrequency Cutoff frequency (Hz)
+	 * @param SampleRate Sample rate (Hz)
+	 * @param bCyclic Whether the last sample repeats the first one cycle later
+	 */
+	static void Butterworth(TArrayView<float> Values, float CutoffFrequency, double SampleRate, bool bCyclic);
+
+private:
+	/**
+	 * Copy the samples with Padding extra samples on each side
+	 * @return Index of the first original sample in OutPadded
+	 */
+	static int32 PadSamples(TConstArrayView<float> Values, int32 Padding, bool bCyclic, TArray<float>& OutPadded);
+};
@@ -0,0 +1,107 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FTrajectoryStream;
+
+/**
+ * Signal kernels over struct-of-arrays trajectory streams
+ * The vectorized paths process four frames per iteration with edge frames handled
+ * outside the hot loop. The scalar paths are the reference implementation.
+ * Cyclic streams repeat their first frame on the last one; their edge frames use
+ * the neighbors across the seam instead of one-sided differences. Speed and curvature
+ * share one templated pass, so requesting both loads every frame once.
+ */
+struct FOOTSYNCMARKERGENERATOR_API FTrajectoryKernels
+{
+	/**
+	 * Finite-difference speed at each frame (cm/s)
+	 * Central difference for interior frames, forward/backward difference at the ends of open streams
+	 * @param Positions Positions at each frame
+	 * @param Times Time at each frame
+	 * @param OutSpeeds Receives one speed per frame (must be sized to the frame count)
+	 * @param bCyclic Wrap around at the ends (needs at least three frames)
+	 */
+	static void ComputeSpeed(
+		const FTrajectoryStream& Positions,
+		TConstArrayView<double> Times,
+		TArrayView<float> OutSpeeds,
+		bool bCyclic = false);
+
+	/** Scalar reference for ComputeSpeed */
+	static void ComputeSpeedScalar(
+		const FTrajectoryStream& Positions,
+		TConstArrayView<double> Times,
+		TArrayView<float> OutSpeeds,
+		bool bCyclic = false);
+
+	/**
+	 * Discrete Menger curvature at each frame
+	 * k = 4*Area(P0,P1,P2) / (|P0-P1| * |P1-P2| * |P2-P0|), first and last frames of open streams are zero
+	 * @param Positions Positions at each frame
+	 * @param OutCurvatures Receives one curvature per frame (must be sized to the frame count)
+	 * @param bCyclic Wrap around at the ends (needs at least three frames)
+	 */
+	static void ComputeCurvature(
+		const FTrajectoryStream& Positions,
+		TArrayView<float> OutCurvatures,
+		bool bCyclic = false);
+
+	/** Scalar reference for ComputeCurvature */
+	static void ComputeCurvatureScalar(
+		const FTrajectoryStream& Positions,
+		TArrayView<float> OutCurvatures,
+		bool bCyclic = false);
+
+	/**
+	 * Speed and curvature at each frame in one fused pass (same results as the separate kernels)
+	 * @param Positions Positions at each frame
+	 * @param Times Time at each frame
+	 * @param OutSpeeds Receives one speed per frame (must be sized to the frame count)
+	 * @param OutCurvatures Receives one curvature per frame (must be sized to the frame count)
+	 * @param bCyclic Wrap around at the ends (needs at least three frames)
+	 */
+	static void ComputeSpeedAndCurvature(
+		const FTrajectoryStream& Positions,
+		TConstArrayView<double> Times,
+		TArrayView<float> OutSpeeds,
+		TArrayView<float> OutCurvatures,
+		bool bCyclic = false);
+
+	/**
+	 * Horizontal axis the stream moves along the most
+	 * @return X (forward/backward) or Y (strafing), whichever spans the larger range
+	 */
+	static FVector FindDominantHorizontalAxis(const FTrajectoryStream& Positions);
+
+	/**
+	 * Horizontal axis the stream moves along the most over some of its frames
+	 * @param Frames Frames to measure the ranges over (e.g. the coarse samples)
+	 * @return X (forward/backward) or Y (strafing), whichever spans the larger range
+	 */
+	static FVector FindDominantHorizontalAxis(const FTrajectoryStream& Positions, TConstArrayView<int32> Frames);
+
+	/**
+	 * Project every frame onto an axis
+	 * @param Positions Positions at each frame
+	 * @param Axis Axis to project onto
+	 * @param OutProjections Receives one projection per frame (must be sized to the frame count)
+	 */
+	static void ProjectOnAxis(
+		const FTrajectoryStream& Positions,
+		const FVector& Axis,
+		TArrayView<float> OutProjections);
+
+	/** Time at any frame of a cyclic stream, frames outside [0, Num) are shifted by whole cycles */
+	static double GetCyclicTime(TConstArrayView<double> Times, int32 Frame)
+	{
+		const int32 Period = Times.Num() - 1;
+		const int32 Cycles = FMath::DivideAndRoundDown(Frame, Period);
+		return Times[Frame - Cycles * Period] + (Times[Period] - Times[0]) * Cycles;
+	}
+
+	/** Menger curvature of a single triangle (scalar reference) */
+	static float CalculatePointCurvature(const FVector& P0, const FVector& P1, const FVector& P2);
+};
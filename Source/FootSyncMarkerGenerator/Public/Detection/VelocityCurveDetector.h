@@ -12,43 +12,55 @@
 class FOOTSYNCMARKERGENERATOR_API FVelocityCurveDetector : public IFootContactDetector
 {
 public:
-	FVelocityCurveDetector() = default;
+	/** Detector configured from the current project settings (game thread) */
+	FVelocityCurveDetector();
+	explicit FVelocityCurveDetector(const FFootSyncDetectionConfig& InConfig);
 	virtual ~FVelocityCurveDetector() = default;
 
 	// IFootContactDetector interface
 	virtual TArray<FFootContactResult> DetectContacts(
-		UAnimSequence* AnimSequence,
+		const FFootSyncSamplingContext& Context,
 		const FSyncFootDefinition& Foot,
 		const FLocomotionPreset& Preset) override;
 
 	virtual FString GetDetectorName() const override { return TEXT("VelocityCurve"); }
 
-	virtual void SetVelocityThreshold(float Threshold) override { VelocityThresholdOverride = Threshold; bHasThresholdOverride = true; }
+	/**
+	 * Build the contact result for a velocity minimum
+	 * Shared with the GPU trajectory analysis, which finds the minima on the device
+	 * @param Time Time of the minimum
+	 * @param Velocity Foot speed at the minimum
+	 * @param MaxVelocity Maximum foot speed of the trajectory
+	 */
+	FFootContactResult MakeMinimumResult(double Time, float Velocity, float MaxVelocity) const;
 
 private:
-	bool bHasThresholdOverride = false;
-	float VelocityThresholdOverride = 0.0f;
+	/** Configuration snapshot */
+	const FFootSyncDetectionConfig Config;
 
 	/**
-	 * Calculate foot velocities from pose data
-	 * @param Poses Array of poses
-	 * @param Times Time at each pose
-	 * @param FootBone Name of the foot bone
+	 * Calculate foot velocities from the sampled trajectory
+	 * @param Positions Foot positions at each frame
+	 * @param Times Time at each frame
+	 * @param bCyclic Whether the trajectory wraps around from the last frame to the first
 	 * @return Array of velocities (cm/s)
 	 */
 	TArray<float> CalculateVelocities(
-		const TArray<struct FAnimPose>& Poses,
-		const TArray<float>& Times,
-		FName FootBone);
+		const struct FTrajectoryStream& Positions,
+		TConstArrayView<double> Times,
+		bool bCyclic);
 
 	/**
 	 * Find local minima in the velocity data
+	 * Cyclic data tests the first frame against its neighbors across the seam and
+	 * skips the last frame, which repeats the first.
 	 * @param Velocities Array of velocities
-	 * @param Times Time at each velocity sample
 	 * @param Threshold Minimum velocity to consider (filters noise)
+	 * @param bCyclic Whether the data wraps around from the last frame to the first
 	 * @return Indices of local minima
 	 */
 	TArray<int32> FindLocalMinima(
-		const TArray<float>& Velocities,
-		float Threshold);
+		TConstArrayView<float> Velocities,
+		float Threshold,
+		bool bCyclic);
 };
@@ -0,0 +1,81 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "LocomotionPresets.h"
+#include "FootSyncBenchmarkCommandlet.generated.h"
+
+struct FFootSyncTrajectoryFixture;
+
+/**
+ * Detector micro-benchmark and regression check over recorded trajectory fixtures
+ *
+ * Record fixtures from animation assets:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=FootSyncBenchmark -Record
+ *     -Fixtures=<Dir> [-Paths=/Game/Animations+/Game/Other] [-Locomotion=Bipedal|HumanoidFlying|Quadruped]
+ *
+ * Run the benchmark against recorded fixtures:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=FootSyncBenchmark
+ *     -Fixtures=<Dir> [-Iterations=20] [-TimeTolerance=0.0001] [-ConfidenceTolerance=0.001]
+ *
+ * Run the detectors against an analysis export of the markers commandlet (-Export):
+ *   UnrealEditor-Cmd.exe Project.uproject -run=FootSyncBenchmark
+ *     -Analysis=<File> [-Iterations=20] [-TimeTolerance=0.0001] [-ConfidenceTolerance=0.001]
+ *
+ * Each detector and FCompositeDetector::MergeResults is timed per fixture, and every
+ * result is compared against the golden results stored at record time. Golden results
+ * depend on the detection settings, so record and run with the same project settings.
+ * Analysis exports are read memory-mapped, each clip is timed with the detection method
+ * it was exported with and compared against the exported results.
+ * Returns nonzero if any fixture fails to load or any result mismatches.
+ */
+UCLASS()
+class UFootSyncBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFootSyncBenchmarkCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Default number of timed iterations per detector */
+	static constexpr int32 DefaultIterations = 20;
+
+	/**
+	 * Sample animation sequences and write one fixture per sequence
+	 * @return Commandlet exit code
+	 */
+	int32 RecordFixtures(const FString& Params, const FString& FixtureDir) const;
+
+	/**
+	 * Time and verify every fixture in the directory
+	 * @return Commandlet exit code
+	 */
+	int32 RunFixtures(const FString& Params, const FString& FixtureDir) const;
+
+	/**
+	 * Time and verify every clip of an analysis export
+	 * @return Commandlet exit code
+	 */
+	int32 RunAnalysis(const FString& Params, const FString& Filename) const;
+
+	/**
+	 * Run all detectors on every foot of the fixture and store the results as golden
+	 */
+	void ComputeGoldenResults(FFootSyncTrajectoryFixture& Fixture) const;
+
+	/**
+	 * Compare results against golden results
+	 * @return True if both have the same results within tolerance
+	 */
+	bool CompareResults(
+		const TArray<FFootContactResult>& Expected,
+		const TArray<FFootContactResult>& Actual,
+		float TimeTolerance,
+		float ConfidenceTolerance) const;
+};
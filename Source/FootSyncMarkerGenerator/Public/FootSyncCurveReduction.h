@@ -0,0 +1,36 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/RichCurve.h"
+
+/**
+ * Lossy reduction of generated per-frame curves into a few linear keys
+ * Values are first snapped to a fixed-point grid, then keys that a straight line
+ * between their neighbors reproduces within tolerance are dropped. Smooth distance
+ * and velocity curves typically keep a small fraction of their frames.
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncCurveReduction
+{
+	/**
+	 * Build linear keys that stay within MaxError of the sampled values at every frame
+	 * Half the error budget goes to quantization (grid step = MaxError), half to key removal.
+	 * The first and last frames are always kept.
+	 * @param Times Time of each frame in seconds
+	 * @param Values Value at each frame
+	 * @param MaxError Maximum absolute deviation from Values (0 keeps every frame unquantized)
+	 * @param OutKeys Receives the reduced keys in time order
+	 */
+	static void ReduceKeys(
+		TConstArrayView<double> Times,
+		TConstArrayView<float> Values,
+		float MaxError,
+		TArray<FRichCurveKey>& OutKeys);
+
+	/** Snap a value to the fixed-point grid of the given step (no-op for Step <= 0) */
+	static float Quantize(float Value, float Step)
+	{
+		return Step > 0.0f ? FMath::RoundToFloat(Value / Step) * Step : Value;
+	}
+};
@@ -0,0 +1,40 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+
+/**
+ * Derived Data Cache storage for per-foot detection results
+ * Keys combine the source-data hash, detector configuration hash and foot bone,
+ * so every workstation and build agent on a shared DDC reuses the same results.
+ */
+class FOOTSYNCMARKERGENERATOR_API FFootSyncDetectionCache
+{
+public:
+	/**
+	 * Fetch cached detection results
+	 * @param KeySuffix Plugin-specific part of the cache key
+	 * @param OutResults Cached results (unchanged on miss)
+	 * @return True on cache hit
+	 */
+	static bool Get(const FString& KeySuffix, TArray<FFootContactResult>& OutResults);
+
+	/**
+	 * Store detection results
+	 * @param KeySuffix Plugin-specific part of the cache key
+	 * @param Results Results to store
+	 */
+	static void Put(const FString& KeySuffix, const TArray<FFootContactResult>& Results);
+
+	/**
+	 * Serialize results in the versioned cache format
+	 * @return False if the archive holds an incompatible format
+	 */
+	static bool Serialize(FArchive& Ar, TArray<FFootContactResult>& Results);
+
+private:
+	/** Build the full DDC key for the given suffix */
+	static FString BuildCacheKey(const FString& KeySuffix);
+};
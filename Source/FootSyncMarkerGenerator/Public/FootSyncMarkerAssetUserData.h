@@ -0,0 +1,27 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "FootSyncMarkerAssetUserData.generated.h"
+
+/**
+ * Per-sequence record of the last FootSync Marker Generator application
+ * Used to skip re-detection when neither the source data nor the settings changed,
+ * and to find the generated curves of feet that are no longer part of the preset
+ */
+UCLASS()
+class FOOTSYNCMARKERGENERATOR_API UFootSyncMarkerAssetUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	/** Hash of the source bone tracks and effective detection settings */
+	UPROPERTY(VisibleAnywhere, Category = "FootSync")
+	FString Fingerprint;
+
+	/** Curves written by the last application, removed once they are no longer generated */
+	UPROPERTY(VisibleAnywhere, Category = "FootSync")
+	TArray<FName> GeneratedCurves;
+};
@@ -5,9 +5,108 @@
 #include "CoreMinimal.h"
 #include "AnimationModifier.h"
 #include "LocomotionPresets.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "Detection/FootSyncDetectionConfig.h"
+#include "Detection/FootSyncGpuDetection.h"
+#include "Detection/IFootContactDetector.h"
+#include "FootSyncStats.h"
 #include "FootSyncMarkerModifier.generated.h"
 
-class IFootContactDetector;
+class FFootSyncAnalysisWriter;
+
+/**
+ * Marker times selected for a single foot
+ */
+struct FFootSyncFootMarkers
+{
+	/** Foot the markers belong to */
+	FSyncFootDefinition Foot;
+
+	/** Final marker times after confidence and interval filtering */
+	TArray<float> MarkerTimes;
+
+	/** Contact results the markers were selected from */
+	TArray<FFootContactResult> Results;
+
+	/** Number of contact results before filtering */
+	int32 NumContacts = 0;
+
+	/** Number of results that passed the confidence filter */
+	int32 NumConfident = 0;
+
+	/** Confidence of the best contact used when none passed the threshold (negative if unused) */
+	float FallbackConfidence = -1.0f;
+
+	/** Whether the contact results were served from the Derived Data Cache */
+	bool bFromCache = false;
+};
+
+/**
+ * Per-frame distance and velocity curve values of a single foot
+ * Appended chunk by chunk, so streamed sequences generate curves without keeping their trajectories
+ */
+struct FFootSyncCurveValues
+{
+	/** Foot the values belong to */
+	FName BoneName;
+
+	/** Pelvis-relative distance along the primary move axis (cm) */
+	TArray<float> Distances;
+
+	/** Pelvis-relative speed (cm/s) */
+	TArray<float> Velocities;
+
+	/** Pelvis-relative position and time of the last appended frame */
+	FVector LastPosition = FVector::ZeroVector;
+	float LastTime = 0.0f;
+};
+
+/**
+ * Sampled trajectories and detection output for a single sequence
+ * Sampling and commit run on the game thread, detection can run on any thread
+ */
+struct FFootSyncSequenceJob
+{
+	/** Sequence being processed */
+	UAnimSequence* AnimSequence = nullptr;
+
+	/** Effective preset for the sequence */
+	FLocomotionPreset Preset;
+
+	/** Effective detection configuration, read by detection instead of the settings objects */
+	FFootSyncDetectionConfig Config;
+
+	/** Trajectories sampled from the sequence */
+	FFootSyncSamplingContext Context;
+
+	/** GPU candidates for each foot, when the batch was analyzed on the GPU */
+	FFootSyncGpuSignals GpuSignals;
+
+	/** Detector shared by every foot of the sequence, created from the registry */
+	TUniquePtr<IFootContactDetector> Detector;
+
+	/** Detection output for each foot */
+	TArray<FFootSyncFootMarkers> Feet;
+
+	/** Whether the quadruped gait solver detected the feet */
+	bool bGaitSolved = false;
+
+	/** Whether the take was detected chunk by chunk while sampling, leaving Context empty */
+	bool bStreamed = false;
+
+	/** Frame times and curve values of each foot, collected from the chunks of a streamed take */
+	TArray<double> StreamedTimes;
+	TArray<FFootSyncCurveValues> StreamedCurves;
+
+	/** Fingerprint stored on the sequence once the results are committed */
+	FString Fingerprint;
+
+	/** Derived Data Cache key shared by all feet (source data and detector configuration) */
+	FString DetectionCacheKey;
+
+	/** Timings and metadata filled in by each stage */
+	FFootSyncClipStats Stats;
+};
 
 /**
  * Animation Modifier that automatically generates foot sync markers
@@ -24,6 +123,29 @@ public:
 	virtual void OnApply_Implementation(UAnimSequence* AnimationSequence) override;
 	virtual void OnRevert_Implementation(UAnimSequence* AnimationSequence) override;
 
+	/**
+	 * Apply this modifier's settings to many sequences at once
+	 * Trajectories are sampled serially, detection runs in parallel across sequences,
+	 * then markers and curves are written in a single serialized pass
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FootSync")
+	void ApplyToSequences(const TArray<UAnimSequence*>& AnimSequences);
+
+	/** Per-clip statistics of the last ApplyToSequences call (sequences that were processed) */
+	const TArray<FFootSyncClipStats>& GetLastBatchStats() const { return LastBatchStats; }
+
+	/** Number of sequences skipped as unchanged by the last ApplyToSequences call */
+	int32 GetLastBatchNumSkipped() const { return LastBatchNumSkipped; }
+
+	/**
+	 * Detect contacts on many sequences and write them to an analysis export, without touching the sequences
+	 * Runs gather and detect like ApplyToSequences but never commits, and includes unchanged sequences.
+	 * Every signal is computed for exported sequences.
+	 * @param AnimSequences Sequences to export
+	 * @param Writer Open analysis writer the sequences are appended to
+	 */
+	void ExportSequences(const TArray<UAnimSequence*>& AnimSequences, FFootSyncAnalysisWriter& Writer);
+
 	// ============== Locomotion Settings ==============
 
 	/** Type of locomotion (determines default foot configuration) */
@@ -73,6 +195,15 @@ public:
 		meta = (EditCondition = "bOverrideSaliencyThreshold", ClampMin = "0.0", ClampMax = "1.0"))
 	float SaliencyThresholdOverride = 0.5f;
 
+	/** Whether to override how the ends of the sequence are treated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Detection")
+	bool bOverrideCycleMode = false;
+
+	/** Cycle mode override, e.g. Cyclic for loops whose last pose differs slightly from the first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Detection",
+		meta = (EditCondition = "bOverrideCycleMode"))
+	EFootSyncCycleMode CycleModeOverride = EFootSyncCycleMode::Cyclic;
+
 	// ============== Marker Settings ==============
 
 	/** Whether to override max markers per foot */
@@ -93,6 +224,21 @@ public:
 		meta = (EditCondition = "bOverrideGuaranteeMinimumOne"))
 	bool bGuaranteeMinimumOneOverride = true;
 
+	// ============== Incremental Settings ==============
+
+	/**
+	 * Skip sequences whose source bone tracks and effective settings are unchanged since the last apply
+	 * Only applies to ApplyToSequences (and the commandlet). Applying the modifier in the editor reverts
+	 * the previous application first, so it always runs detection.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Incremental")
+	bool bSkipUnchanged = true;
+
+	/** Run detection even if the stored fingerprint matches */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Incremental",
+		meta = (EditCondition = "bSkipUnchanged"))
+	bool bForceReapply = false;
+
 	// ============== Output Settings ==============
 
 	/** Whether to generate distance curves (pelvis-to-foot distance) */
@@ -103,22 +249,112 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output")
 	bool bGenerateVelocityCurves = false;
 
+	/** Whether to show editor notifications (never shown when running headless) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", AdvancedDisplay)
+	bool bShowNotifications = true;
+
 protected:
 	/**
 	 * Process the animation sequence with the given preset
 	 */
-	void ProcessAnimation(UAnimSequence* AnimSequence, const FLocomotionPreset& Preset);
+	void ProcessAnimation(
+		UAnimSequence* AnimSequence,
+		const FLocomotionPreset& Preset,
+		const FFootSyncDetectionConfig& Config,
+		const FString& Fingerprint);
 
 	/**
-	 * Detect foot contacts using the configured detection method
+	 * Sample the trajectories needed for detection (game thread)
+	 * @param bAllowStreaming Whether long takes may be detected chunk by chunk right away instead
 	 */
-	TArray<FFootContactResult> DetectFootContacts(
+	bool PrepareSequenceJob(
 		UAnimSequence* AnimSequence,
-		const FSyncFootDefinition& Foot,
-		const FLocomotionPreset& Preset);
+		const FLocomotionPreset& Preset,
+		const FFootSyncDetectionConfig& Config,
+		FFootSyncSequenceJob& OutJob,
+		bool bAllowStreaming = true) const;
+
+	/**
+	 * Sample a job for every sequence with a valid preset (game thread)
+	 * @param bSkipUpToDate Whether to skip and count sequences whose fingerprint matches
+	 * @param bAllowStreaming Whether long takes may be streamed (exports need the whole trajectories)
+	 */
+	void GatherJobs(
+		const TArray<UAnimSequence*>& AnimSequences,
+		const FFootSyncDetectionConfig& Config,
+		bool bSkipUpToDate,
+		bool bAllowStreaming,
+		TArray<FFootSyncSequenceJob>& OutJobs,
+		int32& OutNumSkipped) const;
+
+	/** Whether the job's take is long enough to stream and its settings allow it */
+	bool ShouldStream(const FFootSyncSequenceJob& Job, int32 NumKeys) const;
+
+	/**
+	 * Detect a long take chunk by chunk with the streaming detectors (game thread, samples poses)
+	 * Selects the markers and collects the curve values, the job skips RunDetection.
+	 * Streamed results bypass the Derived Data Cache, which holds batch detector results.
+	 */
+	bool StreamSequenceJob(FFootSyncSequenceJob& Job) const;
+
+	/**
+	 * Run detection of a batch of jobs, in parallel across sequences
+	 */
+	void DetectJobs(TArray<FFootSyncSequenceJob>& Jobs, const FFootSyncDetectionConfig& Config) const;
+
+	/**
+	 * Run detection for every foot of the job (thread-safe, reads sampled data only)
+	 */
+	void RunDetection(FFootSyncSequenceJob& Job) const;
+
+	/**
+	 * Find the candidate frames of every job in one GPU batch (game thread)
+	 * Jobs keep empty signals, and are detected on the CPU, if the GPU is unavailable
+	 */
+	void AnalyzeJobsOnGpu(TArray<FFootSyncSequenceJob>& Jobs) const;
+
+	/**
+	 * Write markers, curves and notifications for a detected job (game thread)
+	 */
+	void CommitSequenceJob(FFootSyncSequenceJob& Job);
+
+	/**
+	 * Detect contacts for a single foot and select the final marker times
+	 */
+	FFootSyncFootMarkers DetectFootMarkers(
+		const FFootSyncSequenceJob& Job,
+		const FSyncFootDefinition& Foot) const;
+
+	/**
+	 * Detect a quadruped's feet through the gait solver (thread-safe)
+	 * @return False if the preset does not label all four feet, the caller detects them independently
+	 */
+	bool DetectGaitMarkers(
+		FFootSyncSequenceJob& Job,
+		TConstArrayView<const FSyncFootDefinition*> Feet) const;
+
+	/**
+	 * Select the final marker times of a foot from its contact results
+	 */
+	void SelectMarkers(
+		const TArray<FFootContactResult>& Results,
+		const FFootSyncDetectionConfig& Config,
+		FFootSyncFootMarkers& Markers) const;
+
+	/**
+	 * Detect foot contacts with the detector of the job
+	 * @param Job Sequence job providing the detector and preset
+	 * @param Context Trajectories to analyze (the job's context or a slice of it)
+	 * @param Foot Foot to detect
+	 */
+	TArray<FFootContactResult> DetectFootContacts(
+		const FFootSyncSequenceJob& Job,
+		const FFootSyncSamplingContext& Context,
+		const FSyncFootDefinition& Foot) const;
 
 	/**
-	 * Add sync markers to the animation sequence
+	 * Append sync markers to the authored markers of the animation sequence
+	 * Does not refresh the marker data, the caller does that once per sequence.
 	 */
 	void AddSyncMarkers(
 		UAnimSequence* AnimSequence,
@@ -130,18 +366,69 @@ protected:
 	 */
 	void GenerateCurves(
 		UAnimSequence* AnimSequence,
+		const FFootSyncSamplingContext& Context,
 		const FSyncFootDefinition& Foot,
 		const FLocomotionPreset& Preset);
 
+	/** Append the curve values of every frame of the context to those of the foot */
+	void AppendCurveValues(
+		const FFootSyncSamplingContext& Context,
+		const FLocomotionPreset& Preset,
+		FFootSyncCurveValues& Values) const;
+
+	/** Write the enabled curves of a foot from its per-frame values */
+	void WriteCurves(
+		UAnimSequence* AnimSequence,
+		TConstArrayView<double> Times,
+		const FSyncFootDefinition& Foot,
+		const FFootSyncCurveValues& Values);
+
+	/**
+	 * Create or update a float curve, replacing its keys in place
+	 * A positive MaxError reduces the per-frame values to fewer quantized keys.
+	 */
+	void WriteFloatCurve(
+		UAnimSequence* AnimSequence,
+		FName CurveName,
+		TConstArrayView<double> Times,
+		const TArray<float>& Values,
+		float MaxError = 0.0f);
+
 	/**
 	 * Remove all generated data (markers and curves) from the animation
+	 * Covers the curves of the preset and every curve recorded by the last application.
 	 */
 	void RemoveGeneratedData(UAnimSequence* AnimSequence, const FLocomotionPreset& Preset);
 
 	/**
-	 * Create a detector instance for the given method
+	 * Remove the curves recorded by the last application that are not generated anymore
+	 * @param GeneratedCurves Curves the current application writes
 	 */
-	TUniquePtr<IFootContactDetector> CreateDetector(EFootContactDetectionMethod Method);
+	void RemoveStaleCurves(UAnimSequence* AnimSequence, TConstArrayView<FName> GeneratedCurves) const;
+
+	/** Names of the distance and velocity curves of a foot */
+	void GetCurveNames(const FSyncFootDefinition& Foot, FName& OutDistanceCurve, FName& OutVelocityCurve) const;
+
+	/** Hash the source bone tracks of the preset bones and their parent chains */
+	FString ComputeSourceDataHash(const UAnimSequence* AnimSequence, const FLocomotionPreset& Preset) const;
+
+	/** Hash the effective detection method, thresholds and detector tuning */
+	FString ComputeDetectionConfigHash(const FLocomotionPreset& Preset, const FFootSyncDetectionConfig& Config) const;
+
+	/**
+	 * Compute a fingerprint of the source bone tracks (preset bones and their parent chains)
+	 * and the effective preset, detection method, thresholds and output settings
+	 */
+	FString ComputeFingerprint(
+		const UAnimSequence* AnimSequence,
+		const FLocomotionPreset& Preset,
+		const FFootSyncDetectionConfig& Config) const;
+
+	/** Whether the fingerprint stored on the sequence matches and detection can be skipped */
+	bool IsUpToDate(const UAnimSequence* AnimSequence, const FString& Fingerprint) const;
+
+	/** Store the fingerprint and generated curves of the committed results on the sequence */
+	void StoreFingerprint(UAnimSequence* AnimSequence, const FString& Fingerprint, const TArray<FName>& GeneratedCurves) const;
 
 	/**
 	 * Get the preset to use (either from settings or custom)
@@ -149,22 +436,18 @@ protected:
 	FLocomotionPreset GetEffectivePreset(UAnimSequence* AnimSequence) const;
 
 	/**
-	 * Get the detection method to use
+	 * Snapshot the project settings with this modifier's overrides applied (game thread)
 	 */
-	EFootContactDetectionMethod GetEffectiveDetectionMethod() const;
-
-	/** Get effective minimum confidence (override or global) */
-	float GetEffectiveMinimumConfidence() const;
-
-	/** Get effective velocity threshold (override or global) */
-	float GetEffectiveVelocityThreshold() const;
+	FFootSyncDetectionConfig ResolveDetectionConfig() const;
 
-	/** Get effective saliency threshold (override or global) */
-	float GetEffectiveSaliencyThreshold() const;
+	/** Whether Slate notifications should be shown */
+	bool ShouldShowNotifications() const;
 
-	/** Get effective max markers per foot (override or global) */
-	int32 GetEffectiveMaxMarkersPerFoot() const;
+private:
+	/** Number of slowest clips listed in the batch summary */
+	static constexpr int32 BatchSummaryOutliers = 3;
 
-	/** Get effective guarantee minimum one (override or global) */
-	bool GetEffectiveGuaranteeMinimumOne() const;
+	/** Statistics of the last ApplyToSequences call */
+	TArray<FFootSyncClipStats> LastBatchStats;
+	int32 LastBatchNumSkipped = 0;
 };
@@ -30,12 +30,21 @@ public:
 
 	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	// ============== Detection Settings ==============
 
 	/** Default detection method */
 	UPROPERTY(config, EditAnywhere, Category = "Detection")
 	EFootContactDetectionMethod DetectionMethod = EFootContactDetectionMethod::Composite;
 
+	/** Detector registered through FFootSyncDetectorRegistry to run instead of DetectionMethod (None runs the built-in method) */
+	UPROPERTY(config, EditAnywhere, Category = "Detection",
+		meta = (GetOptions = "GetCustomDetectorOptions"))
+	FName CustomDetector;
+
 	/** Minimum confidence threshold for marker creation */
 	UPROPERTY(config, EditAnywhere, Category = "Detection",
 		meta = (ClampMin = "0.0", ClampMax = "1.0"))
@@ -46,6 +55,14 @@ public:
 		meta = (EditCondition = "DetectionMethod == EFootContactDetectionMethod::Composite"))
 	FCompositeDetectionWeights CompositeWeights;
 
+	/**
+	 * Run the cheap detectors first and Saliency only where they disagree or fall below MinimumConfidence
+	 * Feet whose contacts the cheap detectors settle skip Saliency altogether.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Detection",
+		meta = (EditCondition = "DetectionMethod == EFootContactDetectionMethod::Composite"))
+	bool bTieredComposite = false;
+
 	// ============== Pelvis Crossing Detection ==============
 
 	/** Threshold for pelvis line crossing detection (cm) */
@@ -97,6 +114,126 @@ public:
 		meta = (ClampMin = "0.0", ClampMax = "1.0"))
 	float SaliencyMinConfidence = 0.3f;
 
+	// ============== Ground Height Detection ==============
+
+	/** Low percentile of the foot height taken as the local ground (0.0 - 1.0) */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Ground Height",
+		meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float GroundPercentile = 0.1f;
+
+	/** Rolling window the ground is estimated over from its stance frames, centered on each frame (seconds) */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Ground Height",
+		meta = (ClampMin = "0.05", ClampMax = "5.0"))
+	float GroundWindowSize = 0.5f;
+
+	/** Height above the ground below which the foot can be planted (cm), lift-off at twice this height */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Ground Height",
+		meta = (ClampMin = "0.1", ClampMax = "50.0"))
+	float GroundContactHeight = 3.0f;
+
+	/** Maximum vertical foot speed at contact (cm/s) */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Ground Height",
+		meta = (ClampMin = "0.1", ClampMax = "200.0"))
+	float GroundVerticalSpeedThreshold = 15.0f;
+
+	/** Minimum confidence for ground height detection */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Ground Height",
+		meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float GroundHeightMinConfidence = 0.3f;
+
+	// ============== Sampling ==============
+
+	/**
+	 * Sample long takes coarse-to-fine: a strided pass finds candidate windows,
+	 * only frames near candidates are evaluated at full rate, the rest are interpolated
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling")
+	bool bCoarseToFineSampling = false;
+
+	/** Minimum number of keys before coarse-to-fine sampling is used */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling",
+		meta = (EditCondition = "bCoarseToFineSampling", ClampMin = "16"))
+	int32 CoarseSamplingMinFrames = 1200;
+
+	/** Frame stride of the coarse pass */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling",
+		meta = (EditCondition = "bCoarseToFineSampling", ClampMin = "2", ClampMax = "32"))
+	int32 CoarseSamplingStride = 8;
+
+	/** Extra frames evaluated at full rate on each side of a candidate coarse interval */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling",
+		meta = (EditCondition = "bCoarseToFineSampling", ClampMin = "0", ClampMax = "64"))
+	int32 CoarseRefinementRadius = 4;
+
+	/**
+	 * Whether signals wrap around from the last frame to the first
+	 * Cyclic clips repeat their first pose on the last frame; Auto treats a clip as cyclic
+	 * when the feet and pelvis height of the first and last frames match.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling")
+	EFootSyncCycleMode CycleMode = EFootSyncCycleMode::Auto;
+
+	/** Maximum difference between the first and last pose of a cyclic clip (cm) */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling",
+		meta = (EditCondition = "CycleMode == EFootSyncCycleMode::Auto", ClampMin = "0.0", ClampMax = "10.0"))
+	float CyclicPoseTolerance = 1.0f;
+
+	/**
+	 * Detect very long takes chunk by chunk instead of sampling them whole
+	 * Peak memory then follows StreamingChunkFrames instead of the take length. Only used when the
+	 * detection settings can be streamed: no ground height, smoothing, forced cycles or gait solver.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling")
+	bool bStreamLongTakes = false;
+
+	/** Minimum number of keys before a take is streamed */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling",
+		meta = (EditCondition = "bStreamLongTakes", ClampMin = "1024"))
+	int32 StreamingMinFrames = 18000;
+
+	/** Number of keys sampled per chunk of a streamed take */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Sampling",
+		meta = (EditCondition = "bStreamLongTakes", ClampMin = "64", ClampMax = "65536"))
+	int32 StreamingChunkFrames = 1024;
+
+	// ============== Smoothing ==============
+
+	/**
+	 * Filter the sampled trajectories once before detection
+	 * Suppresses mocap jitter that would otherwise produce spurious velocity minima and saliency peaks
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Smoothing")
+	EFootSyncSmoothingFilter SmoothingFilter = EFootSyncSmoothingFilter::None;
+
+	/** Frames on each side of the Savitzky-Golay window */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Smoothing",
+		meta = (EditCondition = "SmoothingFilter == EFootSyncSmoothingFilter::SavitzkyGolay", ClampMin = "1", ClampMax = "15"))
+	int32 SmoothingHalfWindow = 2;
+
+	/** Butterworth cutoff frequency (Hz), foot contacts are well below 10 Hz */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Smoothing",
+		meta = (EditCondition = "SmoothingFilter == EFootSyncSmoothingFilter::Butterworth", ClampMin = "0.5", ClampMax = "30.0"))
+	float SmoothingCutoffFrequency = 8.0f;
+
+	// ============== Quadruped Gait ==============
+
+	/**
+	 * Detect one fore/hind pair fully and search the other two feet only around
+	 * the contacts predicted from the gait cycle (quadrupeds only)
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Quadruped Gait")
+	bool bUseQuadrupedGaitSolver = false;
+
+	/** Half-width of the search window around each predicted contact (fraction of the gait cycle) */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Quadruped Gait",
+		meta = (EditCondition = "bUseQuadrupedGaitSolver", ClampMin = "0.05", ClampMax = "0.5"))
+	float GaitSearchWindow = 0.2f;
+
+	/** Fraction of predicted contacts that must be confirmed, otherwise the foot is detected in full */
+	UPROPERTY(config, EditAnywhere, Category = "Detection|Quadruped Gait",
+		meta = (EditCondition = "bUseQuadrupedGaitSolver", ClampMin = "0.0", ClampMax = "1.0"))
+	float GaitMinimumHitRatio = 0.75f;
+
 	// ============== Output Settings ==============
 
 	/** Name of the sync marker track */
@@ -139,6 +276,20 @@ public:
 		meta = (EditCondition = "bGenerateVelocityCurves"))
 	FString VelocityCurveSuffix = TEXT("_Velocity");
 
+	/** Store generated curves as a few linear keys on a fixed-point grid instead of one key per frame */
+	UPROPERTY(config, EditAnywhere, Category = "Output")
+	bool bReduceCurveKeys = false;
+
+	/** Maximum deviation of a reduced distance curve from the sampled distances (cm) */
+	UPROPERTY(config, EditAnywhere, Category = "Output",
+		meta = (ClampMin = "0.001", EditCondition = "bReduceCurveKeys"))
+	float DistanceCurveMaxError = 0.1f;
+
+	/** Maximum deviation of a reduced velocity curve from the sampled velocities (cm/s) */
+	UPROPERTY(config, EditAnywhere, Category = "Output",
+		meta = (ClampMin = "0.001", EditCondition = "bReduceCurveKeys"))
+	float VelocityCurveMaxError = 1.0f;
+
 	// ============== Bone Matching Patterns ==============
 
 	/** Patterns to match pelvis/hip bones (case-insensitive contains match) */
@@ -178,6 +329,18 @@ public:
 		meta = (ClampMin = "0.0", ClampMax = "0.5"))
 	float DetectorAgreementBonus = 0.1f;
 
+	/** Store and reuse per-foot detection results in the Derived Data Cache */
+	UPROPERTY(config, EditAnywhere, Category = "Advanced")
+	bool bUseDerivedDataCache = true;
+
+	/**
+	 * Compute velocity, curvature and pelvis-projection signals on the GPU when
+	 * applying to many sequences at once. The CPU path remains the reference and is
+	 * used for single sequences, the quadruped gait solver and when no RHI is available.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Advanced")
+	bool bUseGpuTrajectoryAnalysis = false;
+
 	// ============== Helper Functions ==============
 
 	/** Find pelvis bone from skeleton using patterns */
@@ -186,13 +349,53 @@ public:
 	/** Find a foot bone from skeleton using the given patterns */
 	FName FindFootBone(const USkeleton* Skeleton, const TArray<FString>& Patterns) const;
 
-	/** Create a preset for the given skeleton and locomotion type */
+	/**
+	 * Create a preset for the given skeleton and locomotion type
+	 * Resolved presets are cached per skeleton and type until the settings change.
+	 */
 	FLocomotionPreset CreatePresetForSkeleton(const USkeleton* Skeleton, ELocomotionType Type) const;
 
+	/** Drop all cached presets, e.g. after changing bone patterns from code */
+	void InvalidatePresetCache();
+
 	/** Reset bone patterns to defaults */
 	UFUNCTION(CallInEditor, Category = "Bone Matching")
 	void ResetToDefaultPatterns();
 
+	/** Names of the registered detectors, for the CustomDetector picker */
+	UFUNCTION()
+	TArray<FName> GetCustomDetectorOptions() const;
+
 private:
 	void InitializeDefaultPatterns();
+
+	/** Match the bone patterns against the skeleton (uncached) */
+	FLocomotionPreset BuildPresetForSkeleton(const USkeleton* Skeleton, ELocomotionType Type) const;
+
+	/** Identifies a resolved preset */
+	struct FPresetCacheKey
+	{
+		FGuid SkeletonGuid;
+		ELocomotionType Type = ELocomotionType::Bipedal;
+		uint32 SettingsVersion = 0;
+
+		bool operator==(const FPresetCacheKey& Other) const
+		{
+			return SkeletonGuid == Other.SkeletonGuid && Type == Other.Type && SettingsVersion == Other.SettingsVersion;
+		}
+
+		friend uint32 GetTypeHash(const FPresetCacheKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.SkeletonGuid), GetTypeHash(Key.Type)), Key.SettingsVersion);
+		}
+	};
+
+	/** Incremented whenever settings that affect preset resolution change */
+	uint32 PresetSettingsVersion = 0;
+
+	/** Resolved presets, shared by every modifier and batch apply */
+	mutable TMap<FPresetCacheKey, FLocomotionPreset> PresetCache;
+
+	/** Guards PresetCache and PresetSettingsVersion */
+	mutable FCriticalSection PresetCacheLock;
 };
@@ -0,0 +1,53 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AssetRegistry/AssetData.h"
+#include "FootSyncMarkersCommandlet.generated.h"
+
+/**
+ * Headless re-generation of foot sync markers for a whole project
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=FootSyncMarkers
+ *     [-Paths=/Game/Animations+/Game/Other] [-Skeleton=SK_Mannequin]
+ *     [-Locomotion=Bipedal|HumanoidFlying|Quadruped] [-Method=PelvisCrossing|VelocityCurve|Saliency|Composite]
+ *     [-BatchSize=64] [-NoSave] [-Report=Saved/FootSyncReport.csv]
+ *     [-Export=Saved/FootSync.fsanalysis]
+ *
+ * -Skeleton matches a substring of the sequence's skeleton path (case-insensitive).
+ * -Report writes per-clip frame counts, feet, method and stage timings as CSV.
+ * -Export writes the sampled trajectories, signals and contact results of every sequence
+ * to one memory-mappable analysis file (FFootSyncAnalysisFile) instead of regenerating
+ * markers. Unchanged sequences are included, and no asset is modified or saved.
+ * Sequences are loaded, processed and saved in bounded-size batches with garbage
+ * collection in between, so memory stays flat regardless of project size.
+ */
+UCLASS()
+class UFootSyncMarkersCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFootSyncMarkersCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Default number of sequences loaded at once */
+	static constexpr int32 DefaultBatchSize = 64;
+
+	/**
+	 * Find animation sequences under the given paths, optionally filtered by skeleton
+	 */
+	TArray<FAssetData> FindSequences(const TArray<FString>& PackagePaths, const FString& SkeletonFilter) const;
+
+	/**
+	 * Save the packages of all sequences that were modified
+	 * @return Number of packages that failed to save
+	 */
+	int32 SaveModifiedPackages(const TArray<class UAnimSequence*>& AnimSequences) const;
+};
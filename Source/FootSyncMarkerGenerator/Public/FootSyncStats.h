@@ -0,0 +1,104 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "LocomotionPresets.h"
+
+/**
+ * Stat group, trace channel and per-clip statistics for FootSync marker generation
+ *
+ * Every stage is visible in Unreal Insights on the FootSync channel (-trace=cpu,FootSync)
+ * and in "stat FootSync". Each clip also gets a trace scope named after the sequence,
+ * with its frame count, foot count and detection method.
+ */
+
+DECLARE_STATS_GROUP(TEXT("FootSync"), STATGROUP_FootSync, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sample Poses"), STAT_FootSync_SamplePoses, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Smooth Trajectories"), STAT_FootSync_SmoothTrajectories, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compute Signals"), STAT_FootSync_ComputeSignals, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Detect Pelvis Crossing"), STAT_FootSync_DetectPelvisCrossing, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Detect Velocity Curve"), STAT_FootSync_DetectVelocityCurve, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Detect Saliency"), STAT_FootSync_DetectSaliency, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Detect Ground Height"), STAT_FootSync_DetectGroundHeight, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Detect Composite"), STAT_FootSync_DetectComposite, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Merge Results"), STAT_FootSync_MergeResults, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GPU Trajectory Analysis"), STAT_FootSync_GpuTrajectoryAnalysis, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Add Sync Markers"), STAT_FootSync_AddSyncMarkers, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Curves"), STAT_FootSync_GenerateCurves, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Poses Evaluated"), STAT_FootSync_PosesEvaluated, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Track Frames Read"), STAT_FootSync_TrackFramesRead, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Clips Processed"), STAT_FootSync_ClipsProcessed, STATGROUP_FootSync, FOOTSYNCMARKERGENERATOR_API);
+
+UE_TRACE_CHANNEL_EXTERN(FootSyncChannel, FOOTSYNCMARKERGENERATOR_API);
+
+/** Trace and stat scope for a FootSync stage (Name matches a STAT_FootSync_<Name> cycle stat) */
+#define FOOTSYNC_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(FootSync_##Name, FootSyncChannel); \
+	SCOPE_CYCLE_COUNTER(STAT_FootSync_##Name)
+
+/**
+ * Timings and metadata of a single processed clip
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncClipStats
+{
+	/** Full object path of the sequence */
+	FString SequencePath;
+
+	/** Locomotion type of the preset */
+	ELocomotionType LocomotionType = ELocomotionType::Bipedal;
+
+	/** Detection method */
+	EFootContactDetectionMethod DetectionMethod = EFootContactDetectionMethod::Composite;
+
+	/** Number of keys */
+	int32 NumFrames = 0;
+
+	/** Number of keys whose pose was evaluated */
+	int32 NumEvaluatedFrames = 0;
+
+	/** Number of feet detected */
+	int32 NumFeet = 0;
+
+	/** Number of markers written */
+	int32 NumMarkers = 0;
+
+	/** Number of feet served from the Derived Data Cache */
+	int32 NumCacheHits = 0;
+
+	/** Number of feet detected by the tiered composite, and those of them that skipped Saliency */
+	int32 NumTieredFeet = 0;
+	int32 NumSaliencySkips = 0;
+
+	/** Wall time of each stage (seconds) */
+	double SampleSeconds = 0.0;
+	double DetectSeconds = 0.0;
+	double CommitSeconds = 0.0;
+
+	double GetTotalSeconds() const { return SampleSeconds + DetectSeconds + CommitSeconds; }
+
+	/** CSV header matching ToCsvRow */
+	static FString GetCsvHeader();
+
+	/** One CSV row for this clip */
+	FString ToCsvRow() const;
+};
+
+/**
+ * Summary helpers for a batch of processed clips
+ */
+struct FOOTSYNCMARKERGENERATOR_API FFootSyncBatchReport
+{
+	/** Log totals and the slowest clips */
+	static void LogSummary(const TArray<FFootSyncClipStats>& Clips, int32 NumSkipped, int32 NumOutliers = 10);
+
+	/**
+	 * Write per-clip statistics as CSV
+	 * @return True if the file was written
+	 */
+	static bool WriteCsv(const TArray<FFootSyncClipStats>& Clips, const FString& Filename);
+};
@@ -26,7 +26,30 @@ enum class EFootContactDetectionMethod : uint8
 	PelvisCrossing	UMETA(DisplayName = "Pelvis Line Crossing"),
 	VelocityCurve	UMETA(DisplayName = "Velocity Curve"),
 	Saliency		UMETA(DisplayName = "Saliency Based"),
-	Composite		UMETA(DisplayName = "Composite (All Combined)")
+	Composite		UMETA(DisplayName = "Composite (All Combined)"),
+	GroundHeight	UMETA(DisplayName = "Ground Height")
+};
+
+/**
+ * How the ends of a sequence are treated by the signal kernels
+ */
+UENUM(BlueprintType)
+enum class EFootSyncCycleMode : uint8
+{
+	Auto	UMETA(DisplayName = "Auto (Matching First/Last Pose)"),
+	Open	UMETA(DisplayName = "Open"),
+	Cyclic	UMETA(DisplayName = "Cyclic")
+};
+
+/**
+ * Smoothing filter applied to sampled trajectories before detection
+ */
+UENUM(BlueprintType)
+enum class EFootSyncSmoothingFilter : uint8
+{
+	None			UMETA(DisplayName = "None"),
+	SavitzkyGolay	UMETA(DisplayName = "Savitzky-Golay"),
+	Butterworth		UMETA(DisplayName = "Butterworth (Zero Phase)")
 };
 
 /**
@@ -160,6 +183,11 @@ struct FOOTSYNCMARKERGENERATOR_API FCompositeDetectionWeights
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weights",
 		meta = (ClampMin = "0.0", ClampMax = "1.0"))
 	float SaliencyWeight = 0.5f;
+
+	/** Weight for ground height detection (0.0 - 1.0), off by default */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Weights",
+		meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float GroundHeightWeight = 0.0f;
 };
 
 /**
@@ -0,0 +1,21 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class FootSyncMarkerGeneratorTests : ModuleRules
+{
+	public FootSyncMarkerGeneratorTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(new string[]
+		{
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"Projects",
+			"FootSyncRuntime",
+			"FootSyncMarkerGenerator"
+		});
+	}
+}
@@ -0,0 +1,255 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Detection/FootSyncAnalysisExport.h"
+#include "Detection/FootSyncSamplingContext.h"
+#include "Detection/VelocityCurveDetector.h"
+#include "FootSyncTestFixtures.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FootSyncAnalysisExportTests
+{
+	struct FExportedClip
+	{
+		FString Name;
+		FFootSyncSamplingContext Context;
+		bool bGaitSolver = false;
+		TMap<FName, TArray<FFootContactResult>> Results;
+	};
+
+	static bool TestColumn(FAutomationTestBase& Test, const FString& What, TConstArrayView<float> Actual, TConstArrayView<float> Expected)
+	{
+		return Test.TestEqual(What + TEXT(" frame count"), Actual.Num(), Expected.Num())
+			&& Test.TestTrue(What + TEXT(" values"), FMemory::Memcmp(Actual.GetData(), Expected.GetData(), Expected.Num() * sizeof(float)) == 0);
+	}
+
+	static void TestStream(FAutomationTestBase& Test, const FString& What,
+		TConstArrayView<float> X, TConstArrayView<float> Y, TConstArrayView<float> Z, const FTrajectoryStream& Expected)
+	{
+		TestColumn(Test, What + TEXT(".X"), X, Expected.X);
+		TestColumn(Test, What + TEXT(".Y"), Y, Expected.Y);
+		TestColumn(Test, What + TEXT(".Z"), Z, Expected.Z);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncAnalysisExportRoundTripTest, "FootSync.AnalysisExport.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncAnalysisExportRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace FootSyncAnalysisExportTests;
+
+	// A cyclic clip with every signal and results, and an open clip with neither
+	TArray<FExportedClip> Clips;
+	Clips.SetNum(2);
+
+	Clips[0].Name = TEXT("/Game/Tests/WalkCycle.WalkCycle");
+	Clips[1].Name = TEXT("/Game/Tests/StairsAscent.StairsAscent");
+	Clips[1].bGaitSolver = true;
+	if (!TestTrue(TEXT("Load WalkCycle.csv"), FootSyncTests::LoadTrajectoryFixture(TEXT("WalkCycle.csv"), Clips[0].Context))
+		|| !TestTrue(TEXT("Load StairsAscent.csv"), FootSyncTests::LoadTrajectoryFixture(TEXT("StairsAscent.csv"), Clips[1].Context)))
+	{
+		return false;
+	}
+
+	Clips[0].Context.ComputeSignals(EFootSyncTrajectorySignals::All);
+
+	FVelocityCurveDetector Detector((FFootSyncDetectionConfig()));
+	const FLocomotionPreset Preset = FootSyncTests::MakePreset(Clips[0].Context);
+	for (const FSyncFootDefinition& Foot : Preset.Feet)
+	{
+		Clips[0].Results.Add(Foot.BoneName, Detector.DetectContacts(Clips[0].Context, Foot, Preset));
+	}
+	int32 NumExportedResults = 0;
+	for (const TPair<FName, TArray<FFootContactResult>>& FootResults : Clips[0].Results)
+	{
+		NumExportedResults += FootResults.Value.Num();
+	}
+	TestTrue(TEXT("The walk cycle has contacts to export"), NumExportedResults > 0);
+
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FootSyncRoundTrip") + FString(FootSyncAnalysis::FileExtension));
+
+	{
+		FFootSyncAnalysisWriter Writer;
+		if (!TestTrue(TEXT("Open the writer"), Writer.Open(Filename)))
+		{
+			return false;
+		}
+		for (const FExportedClip& Clip : Clips)
+		{
+			Writer.AddClip(Clip.Name, Clip.Context, EFootContactDetectionMethod::VelocityCurve, Clip.bGaitSolver, Clip.Results);
+		}
+		TestEqual(TEXT("Writer clip count"), Writer.GetNumClips(), Clips.Num());
+		TestTrue(TEXT("Close the writer"), Writer.Close());
+	}
+
+	FFootSyncAnalysisFile File;
+	if (TestTrue(TEXT("Open the export"), File.Open(Filename)) && TestEqual(TEXT("File clip count"), File.GetNumClips(), Clips.Num()))
+	{
+		for (int32 ClipIndex = 0; ClipIndex < Clips.Num(); ++ClipIndex)
+		{
+			const FExportedClip& Expected = Clips[ClipIndex];
+			const FFootSyncSamplingContext& Context = Expected.Context;
+			const FFootSyncAnalysisClipView Clip = File.GetClip(ClipIndex);
+
+			TestEqual(TEXT("Clip name"), FString(Clip.Name), Expected.Name);
+			TestEqual(TEXT("Pelvis name"), FString(Clip.PelvisBoneName), Context.PelvisBoneName.ToString());
+			TestTrue(TEXT("Detection method"), Clip.DetectionMethod == EFootContactDetectionMethod::VelocityCurve);
+			TestTrue(TEXT("Cyclic flag"), EnumHasAnyFlags(Clip.Flags, EFootSyncAnalysisClipFlags::Cyclic) == Context.bCyclic);
+			TestTrue(TEXT("Gait solver flag"), EnumHasAnyFlags(Clip.Flags, EFootSyncAnalysisClipFlags::GaitSolver) == Expected.bGaitSolver);
+			TestTrue(TEXT("Times"), Clip.Times.Num() == Context.Times.Num()
+				&& FMemory::Memcmp(Clip.Times.GetData(), Context.Times.GetData(), Context.Times.Num() * sizeof(double)) == 0);
+			TestStream(*this, TEXT("Pelvis"), Clip.PelvisX, Clip.PelvisY, Clip.PelvisZ, Context.Pelvis);
+
+			if (!TestEqual(TEXT("Foot count"), Clip.NumFeet, Context.Feet.Num()))
+			{
+				continue;
+			}
+
+			for (int32 FootIndex = 0; FootIndex < Clip.NumFeet; ++FootIndex)
+			{
+				const FFootTrajectory& Trajectory = Context.Feet[FootIndex];
+				const FFootSyncAnalysisFootView Foot = File.GetFoot(ClipIndex, FootIndex);
+				const FString What = Trajectory.BoneName.ToString();
+
+				TestEqual(What + TEXT(" name"), FString(Foot.BoneName), What);
+				TestStream(*this, What + TEXT(" position"), Foot.PositionX, Foot.PositionY, Foot.PositionZ, Trajectory.Position);
+				TestStream(*this, What + TEXT(" pelvis relative"), Foot.PelvisRelativeX, Foot.PelvisRelativeY, Foot.PelvisRelativeZ, Trajectory.PelvisRelative);
+				TestColumn(*this, What + TEXT(" speed"), Foot.Speed, Trajectory.Speed);
+				TestColumn(*this, What + TEXT(" curvature"), Foot.Curvature, Trajectory.Curvature);
+				TestColumn(*this, What + TEXT(" pelvis projection"), Foot.PelvisProjection, Trajectory.PelvisProjection);
+
+				const TArray<FFootContactResult>* ExpectedResults = Expected.Results.Find(Trajectory.BoneName);
+				const int32 NumResults = ExpectedResults ? ExpectedResults->Num() : 0;
+				if (TestEqual(What + TEXT(" result count"), Foot.Results.Num(), NumResults))
+				{
+					for (int32 ResultIndex = 0; ResultIndex < NumResults; ++ResultIndex)
+					{
+						const FFootContactResult Result = Foot.Results[ResultIndex].ToResult();
+						const FFootContactResult& ExpectedResult = (*ExpectedResults)[ResultIndex];
+						TestTrue(FString::Printf(TEXT("%s result %d"), *What, ResultIndex),
+							Result.Time == ExpectedResult.Time && Result.Confidence == ExpectedResult.Confidence
+							&& Result.bIsContact == ExpectedResult.bIsContact && Result.Source == ExpectedResult.Source);
+					}
+				}
+			}
+
+			// Detectors replay the exported clip as they ran on the sampled one
+			FFootSyncSamplingContext Replayed;
+			if (TestTrue(TEXT("Make a sampling context"), File.MakeSamplingContext(ClipIndex, Replayed)))
+			{
+				TestTrue(TEXT("Replayed cyclic"), Replayed.bCyclic == Context.bCyclic);
+				TestTrue(TEXT("Replayed times"), Replayed.Times == Context.Times);
+				TestTrue(TEXT("Replayed pelvis"), Replayed.Pelvis.X == Context.Pelvis.X && Replayed.Pelvis.Y == Context.Pelvis.Y && Replayed.Pelvis.Z == Context.Pelvis.Z);
+
+				for (const TPair<FName, TArray<FFootContactResult>>& FootResults : Expected.Results)
+				{
+					const FSyncFootDefinition* Foot = Preset.Feet.FindByPredicate([&FootResults](const FSyncFootDefinition& Definition)
+					{
+						return Definition.BoneName == FootResults.Key;
+					});
+					if (Foot)
+					{
+						const TArray<FFootContactResult> ReplayedResults = Detector.DetectContacts(Replayed, *Foot, Preset);
+						TestEqual(FString::Printf(TEXT("Replayed %s result count"), *FootResults.Key.ToString()), ReplayedResults.Num(), FootResults.Value.Num());
+					}
+				}
+			}
+		}
+	}
+
+	File.Close();
+	IFileManager::Get().Delete(*Filename);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncAnalysisExportCorruptTest, "FootSync.AnalysisExport.RejectsMissingTables",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncAnalysisExportCorruptTest::RunTest(const FString& Parameters)
+{
+	FFootSyncSamplingContext Context;
+	if (!TestTrue(TEXT("Load WalkCycle.csv"), FootSyncTests::LoadTrajectoryFixture(TEXT("WalkCycle.csv"), Context)))
+	{
+		return false;
+	}
+
+	const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FootSyncValid") + FString(FootSyncAnalysis::FileExtension));
+	const FString CorruptFilename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FootSyncCorrupt") + FString(FootSyncAnalysis::FileExtension));
+
+	{
+		FFootSyncAnalysisWriter Writer;
+		if (!TestTrue(TEXT("Open the writer"), Writer.Open(Filename)))
+		{
+			return false;
+		}
+		Writer.AddClip(TEXT("/Game/Tests/WalkCycle.WalkCycle"), Context, EFootContactDetectionMethod::VelocityCurve, false, {});
+		TestTrue(TEXT("Close the writer"), Writer.Close());
+	}
+
+	TArray<uint8> Bytes;
+	if (!TestTrue(TEXT("Read the export"), FFileHelper::LoadFileToArray(Bytes, *Filename)))
+	{
+		return false;
+	}
+
+	const FFootSyncAnalysisHeader Header = *reinterpret_cast<const FFootSyncAnalysisHeader*>(Bytes.GetData());
+	if (!TestTrue(TEXT("The export has feet"), Header.NumClips == 1 && Header.NumFeet > 0))
+	{
+		return false;
+	}
+
+	// Offset 0 only marks an absent signal column, tables and required columns with elements are corrupt
+	auto TestRejected = [this, &Bytes, &CorruptFilename](const TCHAR* What, const TCHAR* ExpectedError, TFunctionRef<void(uint8*)> Corrupt)
+	{
+		TArray<uint8> Corrupted = Bytes;
+		Corrupt(Corrupted.GetData());
+		if (TestTrue(FString::Printf(TEXT("Write %s"), What), FFileHelper::SaveArrayToFile(Corrupted, *CorruptFilename)))
+		{
+			AddExpectedError(ExpectedError, EAutomationExpectedErrorFlags::Contains, 1);
+			FFootSyncAnalysisFile File;
+			TestFalse(FString::Printf(TEXT("Open %s"), What), File.Open(CorruptFilename));
+		}
+	};
+
+	auto GetClip = [&Header](uint8* Data) { return reinterpret_cast<FFootSyncAnalysisClipRecord*>(Data + Header.ClipTableOffset); };
+	auto GetFoot = [&Header](uint8* Data) { return reinterpret_cast<FFootSyncAnalysisFootRecord*>(Data + Header.FootTableOffset); };
+
+	TestRejected(TEXT("a clip table at offset 0"), TEXT("is not a version"),
+		[](uint8* Data) { reinterpret_cast<FFootSyncAnalysisHeader*>(Data)->ClipTableOffset = 0; });
+	TestRejected(TEXT("a foot table at offset 0"), TEXT("is not a version"),
+		[](uint8* Data) { reinterpret_cast<FFootSyncAnalysisHeader*>(Data)->FootTableOffset = 0; });
+	TestRejected(TEXT("a string table at offset 0"), TEXT("is not a version"),
+		[](uint8* Data) { reinterpret_cast<FFootSyncAnalysisHeader*>(Data)->StringTableOffset = 0; });
+	TestRejected(TEXT("times at offset 0"), TEXT("truncated or corrupt"),
+		[&GetClip](uint8* Data) { GetClip(Data)->TimesOffset = 0; });
+	TestRejected(TEXT("pelvis at offset 0"), TEXT("truncated or corrupt"),
+		[&GetClip](uint8* Data) { GetClip(Data)->PelvisOffset = 0; });
+	TestRejected(TEXT("foot positions at offset 0"), TEXT("truncated or corrupt"),
+		[&GetFoot](uint8* Data) { GetFoot(Data)->PositionOffset = 0; });
+	TestRejected(TEXT("pelvis relative positions at offset 0"), TEXT("truncated or corrupt"),
+		[&GetFoot](uint8* Data) { GetFoot(Data)->PelvisRelativeOffset = 0; });
+	TestRejected(TEXT("a bone name past the string table"), TEXT("truncated or corrupt"),
+		[&GetFoot](uint8* Data) { GetFoot(Data)->BoneNameOffset = TNumericLimits<uint64>::Max(); });
+
+	// Signals that were not computed are still readable
+	{
+		FFootSyncAnalysisFile File;
+		if (TestTrue(TEXT("Open the valid export"), File.Open(Filename)))
+		{
+			TestTrue(TEXT("No speed signal was exported"), File.GetFoot(0, 0).Speed.IsEmpty());
+		}
+	}
+
+	IFileManager::Get().Delete(*Filename);
+	IFileManager::Get().Delete(*CorruptFilename);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,81 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "FootSyncContactTracker.h"
+#include "FootSyncTestFixtures.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FootSyncContactTrackerTests
+{
+	/** Feed every frame of a fixture to a tracker, on a clock starting at StartTime */
+	static TArray<FFootSyncContactEvent> TrackFixture(const FFootSyncSamplingContext& Context, double StartTime)
+	{
+		FFootSyncContactTracker Tracker;
+		Tracker.Initialize(Context.Feet.Num(), FFootSyncContactTrackerSettings());
+
+		TArray<FFootSyncContactEvent> Events;
+		TArray<FVector> FootPositions;
+		TArray<FVector> PelvisRelative;
+		for (int32 Frame = 0; Frame < Context.GetNumFrames(); ++Frame)
+		{
+			FootPositions.Reset();
+			PelvisRelative.Reset();
+			for (const FFootTrajectory& Foot : Context.Feet)
+			{
+				FootPositions.Add(Foot.Position.GetPosition(Frame));
+				PelvisRelative.Add(Foot.PelvisRelative.GetPosition(Frame));
+			}
+			Tracker.Update(StartTime + Context.Times[Frame], FootPositions, PelvisRelative, Events);
+		}
+		return Events;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncTrackerWorldTimeTest, "FootSync.ContactTracker.LongUptimeKeepsPrecision",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncTrackerWorldTimeTest::RunTest(const FString& Parameters)
+{
+	using namespace FootSyncContactTrackerTests;
+
+	// A day of world time, where float seconds only resolve about 8 ms
+	const double LateStartTime = 86400.0;
+
+	for (const TCHAR* FixtureName : { TEXT("WalkCycle.csv"), TEXT("StairsAscent.csv") })
+	{
+		FFootSyncSamplingContext Context;
+		if (!TestTrue(FString::Printf(TEXT("Load %s"), FixtureName), FootSyncTests::LoadTrajectoryFixture(FixtureName, Context)))
+		{
+			continue;
+		}
+
+		const TArray<FFootSyncContactEvent> Events = TrackFixture(Context, 0.0);
+		const TArray<FFootSyncContactEvent> LateEvents = TrackFixture(Context, LateStartTime);
+
+		const bool bHasCrossings = Events.ContainsByPredicate([](const FFootSyncContactEvent& Event)
+		{
+			return Event.Source == EFootSyncContactSource::PelvisCrossing;
+		});
+		TestTrue(FString::Printf(TEXT("%s has pelvis crossings"), FixtureName), bHasCrossings);
+
+		if (!TestEqual(FString::Printf(TEXT("%s event count"), FixtureName), LateEvents.Num(), Events.Num()))
+		{
+			continue;
+		}
+
+		for (int32 EventIndex = 0; EventIndex < Events.Num(); ++EventIndex)
+		{
+			const FFootSyncContactEvent& Event = Events[EventIndex];
+			const FFootSyncContactEvent& LateEvent = LateEvents[EventIndex];
+			TestTrue(FString::Printf(TEXT("%s event %d matches"), FixtureName, EventIndex),
+				LateEvent.FootIndex == Event.FootIndex && LateEvent.Source == Event.Source && LateEvent.bIsContact == Event.bIsContact);
+			TestTrue(FString::Printf(TEXT("%s event %d time %f, expected %f"), FixtureName, EventIndex, LateEvent.Time - LateStartTime, Event.Time),
+				FMath::IsNearlyEqual(LateEvent.Time - LateStartTime, Event.Time, 1.0e-6));
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,86 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "FootSyncCurveReduction.h"
+#include "FootSyncTestFixtures.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FootSyncCurveReductionTests
+{
+	/** Float slack on top of the error bound for evaluating the reduced curve */
+	static constexpr float EvaluationSlack = 1.0e-4f;
+
+	/**
+	 * Reduce a curve and check that the keys reproduce every frame within the error bound
+	 * @return Number of keys kept
+	 */
+	static int32 TestReduction(FAutomationTestBase& Test, const FString& What, TConstArrayView<double> Times, TConstArrayView<float> Values, float MaxError)
+	{
+		TArray<FRichCurveKey> Keys;
+		FFootSyncCurveReduction::ReduceKeys(Times, Values, MaxError, Keys);
+
+		if (!Test.TestTrue(What + TEXT(" keeps the end frames"), Keys.Num() >= 2
+			&& Keys[0].Time == static_cast<float>(Times[0]) && Keys.Last().Time == static_cast<float>(Times.Last())))
+		{
+			return Keys.Num();
+		}
+
+		FRichCurve Curve;
+		Curve.SetKeys(Keys);
+
+		for (int32 Frame = 0; Frame < Times.Num(); ++Frame)
+		{
+			const float Evaluated = Curve.Eval(static_cast<float>(Times[Frame]));
+			if (FMath::Abs(Evaluated - Values[Frame]) > MaxError + EvaluationSlack)
+			{
+				Test.AddError(FString::Printf(TEXT("%s (MaxError %g) is off by %f at frame %d"),
+					*What, MaxError, FMath::Abs(Evaluated - Values[Frame]), Frame));
+				break;
+			}
+		}
+
+		return Keys.Num();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncCurveReductionErrorBoundTest, "FootSync.CurveReduction.ErrorBound",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncCurveReductionErrorBoundTest::RunTest(const FString& Parameters)
+{
+	using namespace FootSyncCurveReductionTests;
+
+	for (const TCHAR* FixtureName : { TEXT("WalkCycle.csv"), TEXT("StairsAscent.csv") })
+	{
+		FFootSyncSamplingContext Context;
+		if (!TestTrue(FString::Printf(TEXT("Load %s"), FixtureName), FootSyncTests::LoadTrajectoryFixture(FixtureName, Context)))
+		{
+			continue;
+		}
+		Context.ComputeSignals(EFootSyncTrajectorySignals::Speed | EFootSyncTrajectorySignals::PelvisProjection);
+
+		const int32 NumFrames = Context.GetNumFrames();
+		for (const FFootTrajectory& Foot : Context.Feet)
+		{
+			// The same curves the modifier generates: pelvis distance and foot speed
+			const FString Name = FString::Printf(TEXT("%s %s"), FixtureName, *Foot.BoneName.ToString());
+			for (const float MaxError : { 0.01f, 0.1f, 1.0f })
+			{
+				TestReduction(*this, Name + TEXT(" distance"), Context.Times, Foot.PelvisProjection, MaxError);
+				TestReduction(*this, Name + TEXT(" speed"), Context.Times, Foot.Speed, MaxError);
+			}
+
+			// No error budget keeps every frame as it is
+			TestEqual(Name + TEXT(" keeps every frame without an error budget"),
+				TestReduction(*this, Name + TEXT(" lossless"), Context.Times, Foot.PelvisProjection, 0.0f), NumFrames);
+
+			const int32 NumCoarseKeys = TestReduction(*this, Name + TEXT(" coarse distance"), Context.Times, Foot.PelvisProjection, 1.0f);
+			TestTrue(Name + TEXT(" drops frames of the distance curve"), NumCoarseKeys < NumFrames);
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,5 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, FootSyncMarkerGeneratorTests)
@@ -0,0 +1,124 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncTestFixtures.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace FootSyncTests
+{
+	FString GetFixtureDir()
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("FootSyncMarkerGenerator"));
+		return Plugin.IsValid() ? FPaths::Combine(Plugin->GetBaseDir(), TEXT("Tests"), TEXT("Fixtures")) : FString();
+	}
+
+	bool LoadTrajectoryFixture(const FString& Name, FFootSyncSamplingContext& OutContext)
+	{
+		OutContext = FFootSyncSamplingContext();
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *FPaths::Combine(GetFixtureDir(), Name)))
+		{
+			return false;
+		}
+
+		TArray<FName> BoneNames;
+		TArray<FString> Columns;
+		for (const FString& Line : Lines)
+		{
+			const FString Trimmed = Line.TrimStartAndEnd();
+			if (Trimmed.IsEmpty())
+			{
+				continue;
+			}
+
+			if (Trimmed.StartsWith(TEXT("#")))
+			{
+				if (Trimmed.Equals(TEXT("# Cyclic"), ESearchCase::IgnoreCase))
+				{
+					OutContext.bCyclic = true;
+				}
+				continue;
+			}
+
+			Trimmed.ParseIntoArray(Columns, TEXT(","));
+
+			// Header: Time followed by an X, Y and Z column per bone
+			if (BoneNames.IsEmpty())
+			{
+				if (Columns.Num() < 4 || (Columns.Num() - 1) % 3 != 0)
+				{
+					return false;
+				}
+				for (int32 Column = 1; Column < Columns.Num(); Column += 3)
+				{
+					FString BoneName;
+					if (!Columns[Column].Split(TEXT("."), &BoneName, nullptr))
+					{
+						return false;
+					}
+					BoneNames.Add(FName(*BoneName));
+				}
+				continue;
+			}
+
+			if (Columns.Num() != 1 + BoneNames.Num() * 3)
+			{
+				return false;
+			}
+
+			OutContext.Times.Add(FCString::Atod(*Columns[0]));
+
+			TArray<FVector> Positions;
+			for (int32 Bone = 0; Bone < BoneNames.Num(); ++Bone)
+			{
+				Positions.Emplace(
+					FCString::Atod(*Columns[1 + Bone * 3]),
+					FCString::Atod(*Columns[2 + Bone * 3]),
+					FCString::Atod(*Columns[3 + Bone * 3]));
+			}
+
+			if (OutContext.Feet.IsEmpty())
+			{
+				OutContext.PelvisBoneName = BoneNames[0];
+				for (int32 Bone = 1; Bone < BoneNames.Num(); ++Bone)
+				{
+					OutContext.Feet.AddDefaulted_GetRef().BoneName = BoneNames[Bone];
+				}
+			}
+
+			// Fixtures carry no rotations, so pelvis space is the pelvis-relative offset
+			const int32 Frame = OutContext.Times.Num() - 1;
+			OutContext.Pelvis.SetNum(Frame + 1);
+			OutContext.Pelvis.SetPosition(Frame, Positions[0]);
+			for (int32 FootIndex = 0; FootIndex < OutContext.Feet.Num(); ++FootIndex)
+			{
+				FFootTrajectory& Foot = OutContext.Feet[FootIndex];
+				Foot.Position.SetNum(Frame + 1);
+				Foot.PelvisRelative.SetNum(Frame + 1);
+				Foot.Position.SetPosition(Frame, Positions[FootIndex + 1]);
+				Foot.PelvisRelative.SetPosition(Frame, Positions[FootIndex + 1] - Positions[0]);
+			}
+		}
+
+		OutContext.NumEvaluatedFrames = OutContext.GetNumFrames();
+		OutContext.bCyclic &= OutContext.GetNumFrames() >= 3;
+		return OutContext.IsValid() && OutContext.Feet.Num() > 0;
+	}
+
+	FLocomotionPreset MakePreset(const FFootSyncSamplingContext& Context)
+	{
+		FLocomotionPreset Preset;
+		Preset.Type = ELocomotionType::Bipedal;
+		Preset.PelvisBoneName = Context.PelvisBoneName;
+
+		const FFootMarkerNameSettings Naming;
+		for (int32 FootIndex = 0; FootIndex < Context.Feet.Num(); ++FootIndex)
+		{
+			const EFootLabel Label = (FootIndex % 2 == 0) ? EFootLabel::Left : EFootLabel::Right;
+			Preset.Feet.Emplace(Context.Feet[FootIndex].BoneName, Naming.GetMarkerName(Label), Label);
+		}
+		return Preset;
+	}
+}
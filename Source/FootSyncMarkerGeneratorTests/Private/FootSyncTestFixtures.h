@@ -0,0 +1,31 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LocomotionPresets.h"
+#include "Detection/FootSyncSamplingContext.h"
+
+/**
+ * Trajectory fixtures checked in under Tests/Fixtures
+ *
+ * Fixtures are CSV files with one row per frame: a Time column followed by X, Y and Z
+ * columns for each bone ("foot_l.X", ...). The first bone is the pelvis, the others are
+ * feet. Lines starting with '#' are comments, a "# Cyclic" line marks a cyclic clip.
+ */
+namespace FootSyncTests
+{
+	/** Directory holding the checked-in fixtures */
+	FString GetFixtureDir();
+
+	/**
+	 * Load a fixture into a sampling context, as if it had been sampled from a sequence
+	 * @param Name Fixture file name, without directory
+	 * @param OutContext Receives the frame times and trajectories
+	 * @return False if the file is missing or malformed
+	 */
+	bool LoadTrajectoryFixture(const FString& Name, FFootSyncSamplingContext& OutContext);
+
+	/** Bipedal preset matching the bones of a loaded fixture */
+	FLocomotionPreset MakePreset(const FFootSyncSamplingContext& Context);
+}
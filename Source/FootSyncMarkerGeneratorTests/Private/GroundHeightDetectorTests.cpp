@@ -0,0 +1,173 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Detection/GroundHeightDetector.h"
+#include "FootSyncTestFixtures.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FootSyncGroundHeightTests
+{
+	/** Histogram grounds are bin centres, the fixtures span far less than 4096 bins of 0.1 cm */
+	static constexpr float BinTolerance = 0.05f + 1.0e-3f;
+
+	/** Ground of every frame by sorting the ground frames of its window, ranked like the histogram */
+	static TArray<float> CalculateReferenceClearances(TConstArrayView<float> Heights, int32 HalfWindow, float Percentile, bool bCyclic,
+		const TBitArray<>& GroundFrames)
+	{
+		const int32 NumFrames = Heights.Num();
+		const int32 LastIndex = NumFrames - 1;
+		const float CycleOffset = bCyclic ? Heights[LastIndex] - Heights[0] : 0.0f;
+		HalfWindow = FMath::Clamp(HalfWindow, 0, bCyclic ? (LastIndex - 1) / 2 : LastIndex);
+
+		TArray<float> Clearances;
+		Clearances.SetNumUninitialized(NumFrames);
+
+		TArray<float> Window;
+		for (int32 i = 0; i < (bCyclic ? LastIndex : NumFrames); ++i)
+		{
+			Window.Reset();
+			if (bCyclic)
+			{
+				for (int32 Frame = i - HalfWindow; Frame <= i + HalfWindow; ++Frame)
+				{
+					const int32 Cycles = FMath::DivideAndRoundDown(Frame, LastIndex);
+					if (GroundFrames.Num() == 0 || GroundFrames[Frame - Cycles * LastIndex])
+					{
+						Window.Add(Heights[Frame - Cycles * LastIndex] + CycleOffset * Cycles);
+					}
+				}
+			}
+			else
+			{
+				for (int32 Frame = FMath::Max(0, i - HalfWindow); Frame <= FMath::Min(LastIndex, i + HalfWindow); ++Frame)
+				{
+					if (GroundFrames.Num() == 0 || GroundFrames[Frame])
+					{
+						Window.Add(Heights[Frame]);
+					}
+				}
+			}
+
+			if (Window.IsEmpty())
+			{
+				Clearances[i] = TNumericLimits<float>::Max();
+				continue;
+			}
+
+			Window.Sort();
+			const int32 Rank = FMath::Clamp(FMath::FloorToInt32(Percentile * (Window.Num() - 1)), 0, Window.Num() - 1);
+			Clearances[i] = Heights[i] - Window[Rank];
+		}
+
+		if (bCyclic)
+		{
+			Clearances[LastIndex] = Clearances[0];
+		}
+		return Clearances;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncGroundPercentileTest, "FootSync.GroundHeight.PercentileMatchesSortedWindow",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncGroundPercentileTest::RunTest(const FString& Parameters)
+{
+	using namespace FootSyncGroundHeightTests;
+
+	for (const TCHAR* FixtureName : { TEXT("WalkCycle.csv"), TEXT("StairsAscent.csv"), TEXT("HeldSwing.csv") })
+	{
+		FFootSyncSamplingContext Context;
+		if (!TestTrue(FString::Printf(TEXT("Load %s"), FixtureName), FootSyncTests::LoadTrajectoryFixture(FixtureName, Context)))
+		{
+			continue;
+		}
+
+		for (const FFootTrajectory& Foot : Context.Feet)
+		{
+			const TConstArrayView<float> Heights = Foot.Position.Z;
+
+			TArray<float> VerticalSpeeds;
+			VerticalSpeeds.SetNumUninitialized(Heights.Num());
+			FGroundHeightDetector::CalculateVerticalSpeeds(Heights, Context.Times, Context.bCyclic, VerticalSpeeds);
+
+			TBitArray<> StanceFrames;
+			FGroundHeightDetector::FindGroundFrames(VerticalSpeeds, FFootSyncDetectionConfig().GroundVerticalSpeedThreshold, Context.bCyclic, StanceFrames);
+			TestTrue(FString::Printf(TEXT("%s %s has stance frames"), FixtureName, *Foot.BoneName.ToString()), StanceFrames.Num() == Heights.Num());
+
+			// Every frame and the stance frames alone, windows from a few frames to wider than the clip,
+			// ranks from the minimum to the maximum
+			const TBitArray<> AllFrames;
+			for (const TBitArray<>* GroundFrames : { &AllFrames, &StanceFrames })
+			{
+				for (const int32 HalfWindow : { 1, 4, 7, 15, 100 })
+				{
+					for (const float Percentile : { 0.0f, 0.1f, 0.5f, 1.0f })
+					{
+						TArray<float> Clearances;
+						Clearances.SetNumUninitialized(Heights.Num());
+						FGroundHeightDetector::CalculateClearances(Heights, HalfWindow, Percentile, Context.bCyclic, *GroundFrames, Clearances);
+
+						const TArray<float> Expected = CalculateReferenceClearances(Heights, HalfWindow, Percentile, Context.bCyclic, *GroundFrames);
+						for (int32 Frame = 0; Frame < Heights.Num(); ++Frame)
+						{
+							if (!FMath::IsNearlyEqual(Clearances[Frame], Expected[Frame], BinTolerance))
+							{
+								AddError(FString::Printf(TEXT("%s %s (%s, half window %d, percentile %g): clearance %f at frame %d, expected %f"),
+									FixtureName, *Foot.BoneName.ToString(), GroundFrames->Num() ? TEXT("stance frames") : TEXT("all frames"),
+									HalfWindow, Percentile, Clearances[Frame], Frame, Expected[Frame]));
+								break;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncGroundHeldSwingTest, "FootSync.GroundHeight.HeldSwingApexIsNotGround",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncGroundHeldSwingTest::RunTest(const FString& Parameters)
+{
+	// Each swing holds the foot 30 cm up for longer than the ground window, so a window
+	// inside the hold sees only the still apex
+	FFootSyncSamplingContext Context;
+	if (!TestTrue(TEXT("Load HeldSwing.csv"), FootSyncTests::LoadTrajectoryFixture(TEXT("HeldSwing.csv"), Context)))
+	{
+		return false;
+	}
+
+	const float StanceHeight = 8.0f;
+	const float ApexHeight = 38.0f;
+
+	FGroundHeightDetector Detector((FFootSyncDetectionConfig()));
+	const FLocomotionPreset Preset = FootSyncTests::MakePreset(Context);
+	for (const FSyncFootDefinition& Foot : Preset.Feet)
+	{
+		const TConstArrayView<float> Heights = Context.FindFoot(Foot.BoneName)->Position.Z;
+		const TArray<FFootContactResult> Results = Detector.DetectContacts(Context, Foot, Preset);
+
+		int32 NumContacts = 0;
+		for (const FFootContactResult& Result : Results)
+		{
+			NumContacts += Result.bIsContact ? 1 : 0;
+
+			// Transitions happen near the stance height, never up at the held apex
+			const int32 Frame = FMath::Clamp(FMath::RoundToInt32(Result.Time * 30.0f), 0, Heights.Num() - 1);
+			if (Heights[Frame] > 0.5f * (StanceHeight + ApexHeight))
+			{
+				AddError(FString::Printf(TEXT("%s: %s at %.3f s with the foot %.1f cm up in its swing"),
+					*Foot.BoneName.ToString(), Result.bIsContact ? TEXT("contact") : TEXT("lift-off"), Result.Time, Heights[Frame]));
+			}
+		}
+		TestTrue(FString::Printf(TEXT("%s plants at least once"), *Foot.BoneName.ToString()), NumContacts > 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,116 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Detection/TrajectoryFilters.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FootSyncFiltersTests
+{
+	/** One second at 30 fps, the last sample one period after the first */
+	static constexpr int32 NumSamples = 31;
+	static constexpr double SampleRate = 30.0;
+
+	/** Sample a function of time (seconds) at every frame */
+	template <typename FunctionType>
+	static TArray<float> MakeSignal(FunctionType&& Function)
+	{
+		TArray<float> Values;
+		Values.SetNumUninitialized(NumSamples);
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			Values[i] = static_cast<float>(Function(i / SampleRate));
+		}
+		return Values;
+	}
+
+	static bool TestNearlyEqual(FAutomationTestBase& Test, const FString& What, TConstArrayView<float> Actual, TConstArrayView<float> Expected,
+		float Tolerance, int32 FirstSample = 0, int32 LastSample = NumSamples - 1)
+	{
+		for (int32 i = FirstSample; i <= LastSample; ++i)
+		{
+			if (!FMath::IsNearlyEqual(Actual[i], Expected[i], Tolerance))
+			{
+				Test.AddError(FString::Printf(TEXT("%s differs at sample %d: %f, expected %f"), *What, i, Actual[i], Expected[i]));
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncSavitzkyGolayTest, "FootSync.Filters.SavitzkyGolay",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncSavitzkyGolayTest::RunTest(const FString& Parameters)
+{
+	using namespace FootSyncFiltersTests;
+	constexpr int32 HalfWindow = 2;
+
+	// A quadratic fit reproduces lines everywhere, odd reflection keeps them straight past the ends
+	const TArray<float> Ramp = MakeSignal([](double Time) { return 150.0 * Time - 20.0; });
+	TArray<float> SmoothedRamp = Ramp;
+	FTrajectoryFilters::SavitzkyGolay(SmoothedRamp, HalfWindow, false);
+	TestNearlyEqual(*this, TEXT("Ramp"), SmoothedRamp, Ramp, 1.0e-3f);
+
+	// ...and parabolas wherever the window lies inside the samples
+	const TArray<float> Parabola = MakeSignal([](double Time) { return 45.0 * FMath::Square(Time - 0.5) + 30.0 * Time; });
+	TArray<float> SmoothedParabola = Parabola;
+	FTrajectoryFilters::SavitzkyGolay(SmoothedParabola, HalfWindow, false);
+	TestNearlyEqual(*this, TEXT("Parabola interior"), SmoothedParabola, Parabola, 1.0e-3f, HalfWindow, NumSamples - 1 - HalfWindow);
+
+	// Cyclic samples wrap around the seam, carrying the drift over the cycle with them
+	const TArray<float> Cycle = MakeSignal([](double Time) { return 10.0 * FMath::Sin(UE_DOUBLE_TWO_PI * Time) + 20.0 * Time; });
+	TArray<float> SmoothedCycle = Cycle;
+	FTrajectoryFilters::SavitzkyGolay(SmoothedCycle, HalfWindow, true);
+	TestNearlyEqual(*this, TEXT("Cyclic sine"), SmoothedCycle, Cycle, 0.01f);
+	TestEqual(TEXT("Cyclic drift is kept"), SmoothedCycle.Last() - SmoothedCycle[0], 20.0f, 1.0e-3f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncButterworthTest, "FootSync.Filters.Butterworth",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncButterworthTest::RunTest(const FString& Parameters)
+{
+	using namespace FootSyncFiltersTests;
+
+	const TArray<float> Constant = MakeSignal([](double Time) { return 42.0; });
+	TArray<float> SmoothedConstant = Constant;
+	FTrajectoryFilters::Butterworth(SmoothedConstant, 6.0f, SampleRate, false);
+	TestNearlyEqual(*this, TEXT("Constant"), SmoothedConstant, Constant, 1.0e-4f);
+
+	// Zero phase: the backward pass cancels the lag of the forward pass
+	const TArray<float> Ramp = MakeSignal([](double Time) { return 150.0 * Time - 20.0; });
+	TArray<float> SmoothedRamp = Ramp;
+	FTrajectoryFilters::Butterworth(SmoothedRamp, 6.0f, SampleRate, false);
+	TestNearlyEqual(*this, TEXT("Ramp"), SmoothedRamp, Ramp, 0.01f);
+
+	// Well below the cutoff passes unchanged, well above it is removed
+	const TArray<float> Slow = MakeSignal([](double Time) { return 10.0 * FMath::Sin(UE_DOUBLE_PI * Time); });
+	TArray<float> SmoothedSlow = Slow;
+	FTrajectoryFilters::Butterworth(SmoothedSlow, 6.0f, SampleRate, false);
+	TestNearlyEqual(*this, TEXT("0.5 Hz sine"), SmoothedSlow, Slow, 0.01f);
+
+	TArray<float> Fast = MakeSignal([](double Time) { return 10.0 * FMath::Sin(24.0 * UE_DOUBLE_PI * Time); });
+	FTrajectoryFilters::Butterworth(Fast, 3.0f, SampleRate, false);
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		if (FMath::Abs(Fast[i]) >= 0.1f)
+		{
+			AddError(FString::Printf(TEXT("12 Hz sine not attenuated at sample %d: %f"), i, Fast[i]));
+			break;
+		}
+	}
+
+	const TArray<float> Cycle = MakeSignal([](double Time) { return 10.0 * FMath::Sin(UE_DOUBLE_TWO_PI * Time) + 20.0 * Time; });
+	TArray<float> SmoothedCycle = Cycle;
+	FTrajectoryFilters::Butterworth(SmoothedCycle, 8.0f, SampleRate, true);
+	TestNearlyEqual(*this, TEXT("Cyclic sine"), SmoothedCycle, Cycle, 0.01f);
+	TestEqual(TEXT("Cyclic drift is kept"), SmoothedCycle.Last() - SmoothedCycle[0], 20.0f, 1.0e-3f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,156 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "Detection/TrajectoryKernels.h"
+#include "FootSyncTestFixtures.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FootSyncKernelsTests
+{
+	/** Relative tolerance between the vectorized and scalar kernels (float reassociation) */
+	static constexpr float Tolerance = 1.0e-4f;
+
+	/** Copy the first NumFrames frames of a stream */
+	static FTrajectoryStream Truncate(const FTrajectoryStream& Stream, int32 NumFrames)
+	{
+		FTrajectoryStream Result;
+		Result.SetNum(NumFrames);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Result.SetPosition(Frame, Stream.GetPosition(Frame));
+		}
+		return Result;
+	}
+
+	static bool TestArraysNearlyEqual(FAutomationTestBase& Test, const FString& What, TConstArrayView<float> Actual, TConstArrayView<float> Expected)
+	{
+		if (!Test.TestEqual(What + TEXT(" frame count"), Actual.Num(), Expected.Num()))
+		{
+			return false;
+		}
+
+		for (int32 Frame = 0; Frame < Expected.Num(); ++Frame)
+		{
+			const float Limit = Tolerance * FMath::Max(1.0f, FMath::Abs(Expected[Frame]));
+			if (!FMath::IsNearlyEqual(Actual[Frame], Expected[Frame], Limit))
+			{
+				Test.AddError(FString::Printf(TEXT("%s differs at frame %d: %f, expected %f"), *What, Frame, Actual[Frame], Expected[Frame]));
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Compare every vectorized kernel against its scalar reference on one stream */
+	static void TestKernels(FAutomationTestBase& Test, const FString& What, const FTrajectoryStream& Positions, TConstArrayView<double> Times, bool bCyclic)
+	{
+		const int32 NumFrames = Positions.Num();
+
+		TArray<float> ScalarSpeeds, ScalarCurvatures;
+		ScalarSpeeds.SetNumZeroed(NumFrames);
+		ScalarCurvatures.SetNumZeroed(NumFrames);
+		FTrajectoryKernels::ComputeSpeedScalar(Positions, Times, ScalarSpeeds, bCyclic);
+		FTrajectoryKernels::ComputeCurvatureScalar(Positions, ScalarCurvatures, bCyclic);
+
+		TArray<float> Speeds, Curvatures;
+		Speeds.SetNumZeroed(NumFrames);
+		Curvatures.SetNumZeroed(NumFrames);
+		FTrajectoryKernels::ComputeSpeed(Positions, Times, Speeds, bCyclic);
+		FTrajectoryKernels::ComputeCurvature(Positions, Curvatures, bCyclic);
+		TestArraysNearlyEqual(Test, What + TEXT(" speed"), Speeds, ScalarSpeeds);
+		TestArraysNearlyEqual(Test, What + TEXT(" curvature"), Curvatures, ScalarCurvatures);
+
+		TArray<float> FusedSpeeds, FusedCurvatures;
+		FusedSpeeds.SetNumZeroed(NumFrames);
+		FusedCurvatures.SetNumZeroed(NumFrames);
+		FTrajectoryKernels::ComputeSpeedAndCurvature(Positions, Times, FusedSpeeds, FusedCurvatures, bCyclic);
+		TestArraysNearlyEqual(Test, What + TEXT(" fused speed"), FusedSpeeds, ScalarSpeeds);
+		TestArraysNearlyEqual(Test, What + TEXT(" fused curvature"), FusedCurvatures, ScalarCurvatures);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncKernelsVectorizedTest, "FootSync.Kernels.VectorizedMatchesScalar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncKernelsVectorizedTest::RunTest(const FString& Parameters)
+{
+	using namespace FootSyncKernelsTests;
+
+	for (const TCHAR* FixtureName : { TEXT("WalkCycle.csv"), TEXT("StairsAscent.csv") })
+	{
+		FFootSyncSamplingContext Context;
+		if (!TestTrue(FString::Printf(TEXT("Load %s"), FixtureName), FootSyncTests::LoadTrajectoryFixture(FixtureName, Context)))
+		{
+			continue;
+		}
+
+		for (const FFootTrajectory& Foot : Context.Feet)
+		{
+			const FString What = FString::Printf(TEXT("%s %s"), FixtureName, *Foot.BoneName.ToString());
+			TestKernels(*this, What, Foot.Position, Context.Times, Context.bCyclic);
+			TestKernels(*this, What + TEXT(" relative"), Foot.PelvisRelative, Context.Times, Context.bCyclic);
+
+			// Short open streams exercise the scalar tails of the vector loops
+			for (int32 NumFrames = 3; NumFrames <= 8; ++NumFrames)
+			{
+				TestKernels(*this, FString::Printf(TEXT("%s first %d frames"), *What, NumFrames),
+					Truncate(Foot.Position, NumFrames), TConstArrayView<double>(Context.Times).Left(NumFrames), false);
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFootSyncKernelsScalarCVarTest, "FootSync.Kernels.ScalarKernelsCVar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FFootSyncKernelsScalarCVarTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* ScalarKernels = IConsoleManager::Get().FindConsoleVariable(TEXT("FootSync.ScalarKernels"));
+	if (!TestNotNull(TEXT("FootSync.ScalarKernels is registered"), ScalarKernels))
+	{
+		return false;
+	}
+
+	FFootSyncSamplingContext Context;
+	if (!TestTrue(TEXT("Load StairsAscent.csv"), FootSyncTests::LoadTrajectoryFixture(TEXT("StairsAscent.csv"), Context)))
+	{
+		return false;
+	}
+
+	const FTrajectoryStream& Positions = Context.Feet[0].Position;
+	const int32 NumFrames = Positions.Num();
+
+	TArray<float> ScalarSpeeds, ScalarCurvatures;
+	ScalarSpeeds.SetNumZeroed(NumFrames);
+	ScalarCurvatures.SetNumZeroed(NumFrames);
+	FTrajectoryKernels::ComputeSpeedScalar(Positions, Context.Times, ScalarSpeeds, Context.bCyclic);
+	FTrajectoryKernels::ComputeCurvatureScalar(Positions, ScalarCurvatures, Context.bCyclic);
+
+	// With the cvar set, every entry point must take the scalar path bit for bit
+	const bool bWasScalar = ScalarKernels->GetBool();
+	ScalarKernels->Set(true, ECVF_SetByCode);
+
+	TArray<float> Speeds, Curvatures, FusedSpeeds, FusedCurvatures;
+	Speeds.SetNumZeroed(NumFrames);
+	Curvatures.SetNumZeroed(NumFrames);
+	FusedSpeeds.SetNumZeroed(NumFrames);
+	FusedCurvatures.SetNumZeroed(NumFrames);
+	FTrajectoryKernels::ComputeSpeed(Positions, Context.Times, Speeds, Context.bCyclic);
+	FTrajectoryKernels::ComputeCurvature(Positions, Curvatures, Context.bCyclic);
+	FTrajectoryKernels::ComputeSpeedAndCurvature(Positions, Context.Times, FusedSpeeds, FusedCurvatures, Context.bCyclic);
+
+	ScalarKernels->Set(bWasScalar, ECVF_SetByCode);
+
+	TestTrue(TEXT("Speed matches the scalar kernel exactly"), Speeds == ScalarSpeeds);
+	TestTrue(TEXT("Curvature matches the scalar kernel exactly"), Curvatures == ScalarCurvatures);
+	TestTrue(TEXT("Fused speed matches the scalar kernel exactly"), FusedSpeeds == ScalarSpeeds);
+	TestTrue(TEXT("Fused curvature matches the scalar kernel exactly"), FusedCurvatures == ScalarCurvatures);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
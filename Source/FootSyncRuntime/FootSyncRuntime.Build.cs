@@ -0,0 +1,18 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class FootSyncRuntime : ModuleRules
+{
+	public FootSyncRuntime(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]
+		{
+			"Core",
+			"CoreUObject",
+			"Engine"
+		});
+	}
+}
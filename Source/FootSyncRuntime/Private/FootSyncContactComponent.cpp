@@ -0,0 +1,185 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncContactComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkinnedAsset.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "EngineLogs.h"
+
+DECLARE_STATS_GROUP(TEXT("FootSyncRuntime"), STATGROUP_FootSyncRuntime, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Contact Component Tick"), STAT_FootSyncRuntime_Tick, STATGROUP_FootSyncRuntime);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracked Characters"), STAT_FootSyncRuntime_TrackedCharacters, STATGROUP_FootSyncRuntime);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contact Events"), STAT_FootSyncRuntime_Events, STATGROUP_FootSyncRuntime);
+
+static_assert(static_cast<uint8>(EFootSyncContactEventSource::PelvisCrossing) == static_cast<uint8>(EFootSyncContactSource::PelvisCrossing)
+	&& static_cast<uint8>(EFootSyncContactEventSource::VelocityMinimum) == static_cast<uint8>(EFootSyncContactSource::VelocityMinimum),
+	"EFootSyncContactEventSource must mirror EFootSyncContactSource");
+
+UFootSyncContactComponent::UFootSyncContactComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+
+	// Read the pose after animation has been evaluated
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UFootSyncContactComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!MeshComponent.IsValid())
+	{
+		if (AActor* Owner = GetOwner())
+		{
+			SetSkeletalMeshComponent(Owner->FindComponentByClass<USkeletalMeshComponent>());
+		}
+	}
+	else
+	{
+		ResolveBones();
+	}
+}
+
+void UFootSyncContactComponent::SetSkeletalMeshComponent(USkeletalMeshComponent* InMeshComponent)
+{
+	if (USkeletalMeshComponent* Previous = MeshComponent.Get())
+	{
+		RemoveTickPrerequisiteComponent(Previous);
+	}
+
+	MeshComponent = InMeshComponent;
+
+	if (InMeshComponent)
+	{
+		AddTickPrerequisiteComponent(InMeshComponent);
+	}
+
+	ResolveBones();
+}
+
+void UFootSyncContactComponent::ResetTracking()
+{
+	Tracker.Reset();
+}
+
+void UFootSyncContactComponent::ResolveBones()
+{
+	PelvisBoneIndex = INDEX_NONE;
+	FootBoneIndices.Reset();
+	ResolvedAsset.Reset();
+
+	const USkeletalMeshComponent* Mesh = MeshComponent.Get();
+	if (!Mesh || !Mesh->GetSkinnedAsset())
+	{
+		return;
+	}
+
+	ResolvedAsset = Mesh->GetSkinnedAsset();
+
+	PelvisBoneIndex = Mesh->GetBoneIndex(PelvisBoneName);
+	if (PelvisBoneIndex == INDEX_NONE)
+	{
+		UE_LOG(LogAnimation, Warning,
+			TEXT("FootSyncContactComponent: Pelvis bone %s not found on %s"),
+			*PelvisBoneName.ToString(), *GetNameSafe(ResolvedAsset.Get()));
+		return;
+	}
+
+	for (const FName& FootBoneName : FootBoneNames)
+	{
+		const int32 BoneIndex = Mesh->GetBoneIndex(FootBoneName);
+		if (BoneIndex == INDEX_NONE)
+		{
+			UE_LOG(LogAnimation, Warning,
+				TEXT("FootSyncContactComponent: Foot bone %s not found on %s"),
+				*FootBoneName.ToString(), *GetNameSafe(ResolvedAsset.Get()));
+			PelvisBoneIndex = INDEX_NONE;
+			FootBoneIndices.Reset();
+			return;
+		}
+		FootBoneIndices.Add(BoneIndex);
+	}
+
+	FFootSyncContactTrackerSettings Settings;
+	Settings.MoveAxis = MoveAxis;
+	Settings.bDetectPelvisCrossings = bDetectPelvisCrossings;
+	Settings.bDetectVelocityMinima = bDetectVelocityMinima;
+	Settings.VelocityThreshold = VelocityThreshold;
+	Settings.PelvisConfidenceScale = PelvisConfidenceScale;
+	Settings.MinimumEventInterval = MinimumEventInterval;
+	Tracker.Initialize(FootBoneIndices.Num(), Settings);
+
+	FootPositions.SetNumUninitialized(FootBoneIndices.Num());
+	PelvisRelative.SetNumUninitialized(FootBoneIndices.Num());
+}
+
+void UFootSyncContactComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	SCOPE_CYCLE_COUNTER(STAT_FootSyncRuntime_Tick);
+
+	const USkeletalMeshComponent* Mesh = MeshComponent.Get();
+	if (!Mesh || !Mesh->GetSkinnedAsset())
+	{
+		return;
+	}
+
+	if (Mesh->GetSkinnedAsset() != ResolvedAsset.Get())
+	{
+		ResolveBones();
+	}
+
+	if (PelvisBoneIndex == INDEX_NONE || FootBoneIndices.Num() == 0)
+	{
+		return;
+	}
+
+	// Empty for follower components, which do not evaluate their own pose
+	const TArray<FTransform>& ComponentSpaceTransforms = Mesh->GetComponentSpaceTransforms();
+	if (!ComponentSpaceTransforms.IsValidIndex(PelvisBoneIndex))
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_FootSyncRuntime_TrackedCharacters);
+
+	const FTransform& PelvisTransform = ComponentSpaceTransforms[PelvisBoneIndex];
+	const FTransform& ComponentToWorld = Mesh->GetComponentTransform();
+
+	for (int32 FootIndex = 0; FootIndex < FootBoneIndices.Num(); ++FootIndex)
+	{
+		const int32 BoneIndex = FootBoneIndices[FootIndex];
+		const FVector FootLocation = ComponentSpaceTransforms.IsValidIndex(BoneIndex)
+			? ComponentSpaceTransforms[BoneIndex].GetLocation()
+			: PelvisTransform.GetLocation();
+
+		FootPositions[FootIndex] = bWorldSpaceVelocity ? ComponentToWorld.TransformPosition(FootLocation) : FootLocation;
+		PelvisRelative[FootIndex] = PelvisTransform.InverseTransformPosition(FootLocation);
+	}
+
+	Events.Reset();
+	Tracker.Update(GetWorld()->GetTimeSeconds(), FootPositions, PelvisRelative, Events);
+
+	for (const FFootSyncContactEvent& Event : Events)
+	{
+		if ((bContactsOnly && !Event.bIsContact) || Event.Confidence < MinimumConfidence)
+		{
+			continue;
+		}
+
+		FFootSyncContactEventData EventData;
+		EventData.FootBoneName = FootBoneNames.IsValidIndex(Event.FootIndex) ? FootBoneNames[Event.FootIndex] : NAME_None;
+		EventData.FootIndex = Event.FootIndex;
+		EventData.Time = Event.Time;
+		EventData.Confidence = Event.Confidence;
+		EventData.bIsContact = Event.bIsContact;
+		EventData.Source = static_cast<EFootSyncContactEventSource>(Event.Source);
+
+		INC_DWORD_STAT(STAT_FootSyncRuntime_Events);
+		OnFootContactNative.Broadcast(EventData);
+		OnFootContact.Broadcast(EventData);
+	}
+}
@@ -0,0 +1,136 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncContactTracker.h"
+#include "FootSyncContactMath.h"
+
+void FFootSyncContactTracker::Initialize(int32 NumFeet, const FFootSyncContactTrackerSettings& InSettings)
+{
+	Settings = InSettings;
+	Settings.MoveAxis = Settings.MoveAxis.GetSafeNormal();
+	if (Settings.MoveAxis.IsNearlyZero())
+	{
+		Settings.MoveAxis = FVector::ForwardVector;
+	}
+
+	Feet.Reset();
+	Feet.SetNum(FMath::Max(NumFeet, 0));
+}
+
+void FFootSyncContactTracker::Reset()
+{
+	for (FFootState& Foot : Feet)
+	{
+		Foot.Reset();
+	}
+}
+
+void FFootSyncContactTracker::Update(
+	double Time,
+	TConstArrayView<FVector> FootPositions,
+	TConstArrayView<FVector> PelvisRelative,
+	TArray<FFootSyncContactEvent>& OutEvents)
+{
+	check(FootPositions.Num() == Feet.Num() && PelvisRelative.Num() == Feet.Num());
+
+	for (int32 FootIndex = 0; FootIndex < Feet.Num(); ++FootIndex)
+	{
+		FFootState& Foot = Feet[FootIndex];
+		FFootSyncFrameHistory& History = Foot.History;
+
+		// Start over after a hitch or teleport, no event spans the gap
+		if (History.Num() > 0)
+		{
+			const double DeltaTime = Time - History.GetTime(0);
+			if (DeltaTime > Settings.MaxFrameGap || DeltaTime < 0.0)
+			{
+				Foot.Reset();
+			}
+			else if (DeltaTime <= KINDA_SMALL_NUMBER)
+			{
+				// Same pose sampled twice (paused or not yet re-evaluated)
+				continue;
+			}
+		}
+
+		const float PrevPos = History.Num() > 0
+			? static_cast<float>(History.GetPelvisRelative(0) | Settings.MoveAxis)
+			: 0.0f;
+
+		History.Push(Time, FootPositions[FootIndex], PelvisRelative[FootIndex]);
+
+		// Pelvis line crossing between the previous and the newest frame
+		if (Settings.bDetectPelvisCrossings && History.Num() >= 2)
+		{
+			const float CurrPos = static_cast<float>(History.GetPelvisRelative(0) | Settings.MoveAxis);
+			if (FFootSyncContactMath::IsPelvisCrossing(PrevPos, CurrPos))
+			{
+				// Interpolated within the frame, world time is too large to keep float precision
+				const double PrevTime = History.GetTime(1);
+				const float FrameTime = static_cast<float>(History.GetTime(0) - PrevTime);
+
+				AddEvent(Foot, FootIndex,
+					PrevTime + FFootSyncContactMath::InterpolateCrossingTime(0.0f, PrevPos, FrameTime, CurrPos),
+					FFootSyncContactMath::GetCrossingConfidence(PrevPos, CurrPos, Settings.PelvisConfidenceScale),
+					FFootSyncContactMath::IsCrossingContact(PrevPos, CurrPos),
+					EFootSyncContactSource::PelvisCrossing,
+					OutEvents);
+			}
+		}
+
+		// Central-difference speed of the previous frame, then the minimum test one frame behind it
+		if (Settings.bDetectVelocityMinima && History.Num() >= 3)
+		{
+			const float Speed = FFootSyncContactMath::GetSpeed(
+				History.GetTime(2), History.GetPosition(2), History.GetTime(0), History.GetPosition(0));
+
+			for (int32 Index = SpeedWindow - 1; Index > 0; --Index)
+			{
+				Foot.Speeds[Index] = Foot.Speeds[Index - 1];
+				Foot.SpeedTimes[Index] = Foot.SpeedTimes[Index - 1];
+			}
+			Foot.Speeds[0] = Speed;
+			Foot.SpeedTimes[0] = History.GetTime(1);
+			Foot.NumSpeeds = FMath::Min(Foot.NumSpeeds + 1, SpeedWindow);
+
+			const float Decay = Settings.PeakSpeedHalfLife > KINDA_SMALL_NUMBER
+				? FMath::Exp2(-static_cast<float>(History.GetTime(0) - History.GetTime(1)) / Settings.PeakSpeedHalfLife)
+				: 0.0f;
+			Foot.PeakSpeed = FMath::Max(Speed, Foot.PeakSpeed * Decay);
+
+			if (Foot.NumSpeeds == SpeedWindow
+				&& FFootSyncContactMath::IsVelocityMinimum(Foot.Speeds[2], Foot.Speeds[1], Foot.Speeds[0], Settings.VelocityThreshold))
+			{
+				AddEvent(Foot, FootIndex,
+					Foot.SpeedTimes[1],
+					FFootSyncContactMath::GetVelocityConfidence(Foot.Speeds[1], Foot.PeakSpeed, Settings.VelocityDefaultConfidence),
+					true,  // Velocity minima indicate foot contact
+					EFootSyncContactSource::VelocityMinimum,
+					OutEvents);
+			}
+		}
+	}
+}
+
+void FFootSyncContactTracker::AddEvent(
+	FFootState& Foot,
+	int32 FootIndex,
+	double Time,
+	float Confidence,
+	bool bIsContact,
+	EFootSyncContactSource Source,
+	TArray<FFootSyncContactEvent>& OutEvents) const
+{
+	double& LastEventTime = Foot.LastEventTimes[static_cast<int32>(Source)];
+	if (Time - LastEventTime < Settings.MinimumEventInterval)
+	{
+		return;
+	}
+	LastEventTime = Time;
+
+	FFootSyncContactEvent& Event = OutEvents.AddDefaulted_GetRef();
+	Event.FootIndex = FootIndex;
+	Event.Time = Time;
+	Event.Confidence = Confidence;
+	Event.bIsContact = bIsContact;
+	Event.Source = Source;
+}
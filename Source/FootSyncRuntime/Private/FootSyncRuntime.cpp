@@ -0,0 +1,17 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#include "FootSyncRuntime.h"
+
+#define LOCTEXT_NAMESPACE "FFootSyncRuntimeModule"
+
+void FFootSyncRuntimeModule::StartupModule()
+{
+}
+
+void FFootSyncRuntimeModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FFootSyncRuntimeModule, FootSyncRuntime)
@@ -0,0 +1,167 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "FootSyncContactTracker.h"
+#include "FootSyncContactComponent.generated.h"
+
+class USkeletalMeshComponent;
+class USkinnedAsset;
+
+/**
+ * Test that produced a runtime contact event (Blueprint mirror of EFootSyncContactSource)
+ */
+UENUM(BlueprintType)
+enum class EFootSyncContactEventSource : uint8
+{
+	PelvisCrossing UMETA(DisplayName = "Pelvis Crossing"),
+	VelocityMinimum UMETA(DisplayName = "Velocity Minimum")
+};
+
+/**
+ * Contact or lift-off of a tracked foot
+ */
+USTRUCT(BlueprintType)
+struct FOOTSYNCRUNTIME_API FFootSyncContactEventData
+{
+	GENERATED_BODY()
+
+	/** Bone of the foot */
+	UPROPERTY(BlueprintReadOnly, Category = "FootSync")
+	FName FootBoneName;
+
+	/** Index of the foot in FootBoneNames */
+	UPROPERTY(BlueprintReadOnly, Category = "FootSync")
+	int32 FootIndex = INDEX_NONE;
+
+	/** World time of the event (slightly in the past for velocity minima) */
+	UPROPERTY(BlueprintReadOnly, Category = "FootSync")
+	double Time = 0.0;
+
+	/** Detection confidence (0.0 - 1.0) */
+	UPROPERTY(BlueprintReadOnly, Category = "FootSync")
+	float Confidence = 0.0f;
+
+	/** True for a contact, false for a lift-off */
+	UPROPERTY(BlueprintReadOnly, Category = "FootSync")
+	bool bIsContact = true;
+
+	/** Test that produced the event */
+	UPROPERTY(BlueprintReadOnly, Category = "FootSync")
+	EFootSyncContactEventSource Source = EFootSyncContactEventSource::PelvisCrossing;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFootSyncContact, const FFootSyncContactEventData&, Event);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnFootSyncContactNative, const FFootSyncContactEventData&);
+
+/**
+ * Live foot contact timing for retargeted, blended or motion-matched animation
+ * Reads the evaluated component-space pose of a skeletal mesh every tick and feeds an
+ * FFootSyncContactTracker. The per-tick cost is a few bone reads and constant-time tests
+ * per foot; use the tick interval to further thin out distant characters.
+ */
+UCLASS(ClassGroup = Animation, meta = (BlueprintSpawnableComponent, DisplayName = "FootSync Contact"))
+class FOOTSYNCRUNTIME_API UFootSyncContactComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UFootSyncContactComponent();
+
+	// UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Track the given mesh (defaults to the first skeletal mesh of the owner) */
+	UFUNCTION(BlueprintCallable, Category = "FootSync")
+	void SetSkeletalMeshComponent(USkeletalMeshComponent* InMeshComponent);
+
+	/** Discard the tracked history, e.g. after a teleport or a montage jump */
+	UFUNCTION(BlueprintCallable, Category = "FootSync")
+	void ResetTracking();
+
+	// ============== Bones ==============
+
+	/** Pelvis bone the feet are measured from */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Bones")
+	FName PelvisBoneName = TEXT("pelvis");
+
+	/** Feet to track */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Bones")
+	TArray<FName> FootBoneNames = { TEXT("foot_l"), TEXT("foot_r") };
+
+	// ============== Detection ==============
+
+	/** Emit pelvis line crossings (no latency) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection")
+	bool bDetectPelvisCrossings = true;
+
+	/** Emit velocity minima (two frames of latency) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection")
+	bool bDetectVelocityMinima = true;
+
+	/** Only broadcast contacts, not lift-offs */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection")
+	bool bContactsOnly = true;
+
+	/** Measure foot speed in world space, so planted feet of moving characters are at rest */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection")
+	bool bWorldSpaceVelocity = true;
+
+	/** Primary movement axis in pelvis space */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection")
+	FVector MoveAxis = FVector::ForwardVector;
+
+	/** Foot speed below which a local minimum is a contact (cm/s) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection",
+		meta = (ClampMin = "0.0", EditCondition = "bDetectVelocityMinima"))
+	float VelocityThreshold = 10.0f;
+
+	/** Position change divisor for crossing confidence (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection",
+		meta = (ClampMin = "1.0", EditCondition = "bDetectPelvisCrossings"))
+	float PelvisConfidenceScale = 50.0f;
+
+	/** Minimum time between events of the same foot and source (seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection", meta = (ClampMin = "0.0"))
+	float MinimumEventInterval = 0.1f;
+
+	/** Minimum confidence for an event to be broadcast */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FootSync|Detection",
+		meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinimumConfidence = 0.0f;
+
+	// ============== Events ==============
+
+	/** Broadcast for every detected event */
+	UPROPERTY(BlueprintAssignable, Category = "FootSync")
+	FOnFootSyncContact OnFootContact;
+
+	/** Native listeners, cheaper than the Blueprint delegate */
+	FOnFootSyncContactNative OnFootContactNative;
+
+private:
+	/** Resolve the bone indices for the current mesh asset and restart tracking */
+	void ResolveBones();
+
+	/** Mesh whose pose is read */
+	UPROPERTY(Transient)
+	TWeakObjectPtr<USkeletalMeshComponent> MeshComponent;
+
+	/** Asset the bone indices were resolved for */
+	TWeakObjectPtr<const USkinnedAsset> ResolvedAsset;
+
+	/** Bone indices of the pelvis and each foot (INDEX_NONE until resolved) */
+	int32 PelvisBoneIndex = INDEX_NONE;
+	TArray<int32> FootBoneIndices;
+
+	/** Contact detection state */
+	FFootSyncContactTracker Tracker;
+
+	/** Per-tick scratch buffers, kept to avoid allocating every frame */
+	TArray<FVector> FootPositions;
+	TArray<FVector> PelvisRelative;
+	TArray<FFootSyncContactEvent> Events;
+};
@@ -0,0 +1,80 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Per-frame foot contact tests shared by the batch, streaming and runtime detectors
+ * Header-only and Core-only, so the runtime tracker inlines them in its per-frame update.
+ */
+struct FFootSyncContactMath
+{
+	/**
+	 * Interpolate the exact crossing time between two frames
+	 * @param Time1 Time of first frame
+	 * @param Pos1 Position at first frame
+	 * @param Time2 Time of second frame
+	 * @param Pos2 Position at second frame
+	 * @return Interpolated time when position crosses zero
+	 */
+	static float InterpolateCrossingTime(float Time1, float Pos1, float Time2, float Pos2)
+	{
+		// Linear interpolation to find zero crossing
+		// t = t1 + (0 - p1) * (t2 - t1) / (p2 - p1)
+		const float DeltaPos = Pos2 - Pos1;
+
+		if (FMath::Abs(DeltaPos) < KINDA_SMALL_NUMBER)
+		{
+			return (Time1 + Time2) * 0.5f;  // Return midpoint if positions are very close
+		}
+
+		const float t = Time1 + (-Pos1) * (Time2 - Time1) / DeltaPos;
+		return FMath::Clamp(t, Time1, Time2);
+	}
+
+	/** Whether the projected foot position crossed the pelvis line between two frames */
+	static bool IsPelvisCrossing(float PrevPos, float CurrPos)
+	{
+		return PrevPos * CurrPos < 0.0f;
+	}
+
+	/** Whether a pelvis crossing is a contact (foot moving backward to forward) rather than a lift-off */
+	static bool IsCrossingContact(float PrevPos, float CurrPos)
+	{
+		return PrevPos < 0.0f && CurrPos > 0.0f;
+	}
+
+	/** Confidence of a pelvis crossing from the magnitude of the position change */
+	static float GetCrossingConfidence(float PrevPos, float CurrPos, float ConfidenceScale)
+	{
+		return FMath::Clamp(FMath::Abs(CurrPos - PrevPos) / ConfidenceScale, 0.5f, 1.0f);
+	}
+
+	/** Whether the middle of three consecutive speeds is a local (or plateau) minimum below the threshold */
+	static bool IsVelocityMinimum(float Prev, float Curr, float Next, float Threshold)
+	{
+		return Curr < Threshold
+			&& ((Curr <= Prev && Curr < Next) || (Curr < Prev && Curr <= Next));
+	}
+
+	/** Confidence of a velocity minimum, higher for lower speeds */
+	static float GetVelocityConfidence(float Velocity, float MaxVelocity, float DefaultConfidence)
+	{
+		return MaxVelocity > KINDA_SMALL_NUMBER
+			? 1.0f - FMath::Clamp(Velocity / MaxVelocity, 0.0f, 0.9f)
+			: DefaultConfidence;
+	}
+
+	/** Finite-difference speed between two positions (cm/s), zero for degenerate time steps */
+	static float GetSpeed(double FromTime, const FVector& From, double ToTime, const FVector& To)
+	{
+		const float DeltaTime = static_cast<float>(ToTime - FromTime);
+		if (DeltaTime <= KINDA_SMALL_NUMBER)
+		{
+			return 0.0f;
+		}
+
+		return (FVector3f(To) - FVector3f(From)).Size() / DeltaTime;
+	}
+};
@@ -0,0 +1,159 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FootSyncFrameHistory.h"
+
+/**
+ * Test that produced a runtime contact event
+ */
+enum class EFootSyncContactSource : uint8
+{
+	/** Foot crossed the pelvis line along the move axis */
+	PelvisCrossing,
+
+	/** Foot speed reached a local minimum below the threshold */
+	VelocityMinimum
+};
+
+/**
+ * Contact or lift-off detected by the runtime tracker
+ */
+struct FFootSyncContactEvent
+{
+	/** Index of the foot in the tracker */
+	int32 FootIndex = INDEX_NONE;
+
+	/** Time of the event, on the clock passed to Update */
+	double Time = 0.0;
+
+	/** Detection confidence (0.0 - 1.0) */
+	float Confidence = 0.0f;
+
+	/** True for a contact, false for a lift-off */
+	bool bIsContact = true;
+
+	/** Test that produced the event */
+	EFootSyncContactSource Source = EFootSyncContactSource::PelvisCrossing;
+};
+
+/**
+ * Tuning of the runtime tracker, mirrors the detection settings of the editor pipeline
+ */
+struct FFootSyncContactTrackerSettings
+{
+	/** Axis the pelvis-relative foot position is projected on, in pelvis space */
+	FVector MoveAxis = FVector::ForwardVector;
+
+	/** Emit pelvis line crossings (no latency) */
+	bool bDetectPelvisCrossings = true;
+
+	/** Emit velocity minima (two frames of latency) */
+	bool bDetectVelocityMinima = true;
+
+	/** Foot speed below which a local minimum is a contact (cm/s) */
+	float VelocityThreshold = 10.0f;
+
+	/** Default velocity confidence before any motion was seen */
+	float VelocityDefaultConfidence = 0.5f;
+
+	/** Half-life of the running peak speed that scales velocity confidence (seconds) */
+	float PeakSpeedHalfLife = 2.0f;
+
+	/** Position change divisor for crossing confidence (cm) */
+	float PelvisConfidenceScale = 50.0f;
+
+	/** Minimum time between events of the same foot and source (seconds) */
+	float MinimumEventInterval = 0.1f;
+
+	/** Gap between updates after which the history is discarded, e.g. after a teleport (seconds) */
+	float MaxFrameGap = 0.25f;
+};
+
+/**
+ * Online foot contact detection over a ring buffer of recent frames per foot
+ * Runs the same per-frame tests as the streaming detectors of the editor pipeline
+ * (FFootSyncContactMath) on live poses: constant time and no allocation per update,
+ * so many characters can be tracked within a frame budget. Velocity confidence is
+ * scaled by a decaying peak speed instead of the whole-take maximum.
+ *
+ * Core-only; feed it from any pose source (see UFootSyncContactComponent).
+ */
+class FOOTSYNCRUNTIME_API FFootSyncContactTracker
+{
+public:
+	/**
+	 * Start tracking the given number of feet, discarding any previous state
+	 * @param NumFeet Number of feet passed to every Update
+	 * @param InSettings Detection tuning
+	 */
+	void Initialize(int32 NumFeet, const FFootSyncContactTrackerSettings& InSettings);
+
+	/** Discard the history of every foot, keeping feet and settings */
+	void Reset();
+
+	/**
+	 * Feed the newest frame of every foot
+	 * @param Time Time of the frame in seconds (non-decreasing)
+	 * @param FootPositions Position of each foot in the space speeds are measured in (world space for moving characters)
+	 * @param PelvisRelative Position of each foot relative to the pelvis, in pelvis space
+	 * @param OutEvents Receives the events that became final with this frame (appended)
+	 */
+	void Update(
+		double Time,
+		TConstArrayView<FVector> FootPositions,
+		TConstArrayView<FVector> PelvisRelative,
+		TArray<FFootSyncContactEvent>& OutEvents);
+
+	/** Number of tracked feet */
+	int32 GetNumFeet() const { return Feet.Num(); }
+
+	/** Current settings */
+	const FFootSyncContactTrackerSettings& GetSettings() const { return Settings; }
+
+private:
+	/** Speeds kept per foot for the minimum test */
+	static constexpr int32 SpeedWindow = 3;
+
+	struct FFootState
+	{
+		/** Most recent frames */
+		FFootSyncFrameHistory History;
+
+		/** Most recent central-difference speeds (0 = newest) and their frame times */
+		float Speeds[SpeedWindow] = {};
+		double SpeedTimes[SpeedWindow] = {};
+		int32 NumSpeeds = 0;
+
+		/** Decaying peak speed for confidence scaling */
+		float PeakSpeed = 0.0f;
+
+		/** Time of the last event of each source */
+		double LastEventTimes[2] = { TNumericLimits<double>::Lowest(), TNumericLimits<double>::Lowest() };
+
+		void Reset()
+		{
+			History.Reset();
+			NumSpeeds = 0;
+			PeakSpeed = 0.0f;
+			LastEventTimes[0] = LastEventTimes[1] = TNumericLimits<double>::Lowest();
+		}
+	};
+
+	/** Add an event unless the same foot and source fired within MinimumEventInterval */
+	void AddEvent(
+		FFootState& Foot,
+		int32 FootIndex,
+		double Time,
+		float Confidence,
+		bool bIsContact,
+		EFootSyncContactSource Source,
+		TArray<FFootSyncContactEvent>& OutEvents) const;
+
+	/** Per-foot state (most characters have two or four feet) */
+	TArray<FFootState, TInlineAllocator<4>> Feet;
+
+	/** Detection tuning */
+	FFootSyncContactTrackerSettings Settings;
+};
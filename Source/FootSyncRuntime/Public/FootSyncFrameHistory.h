@@ -0,0 +1,60 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed-size history of the most recent frames of a foot
+ */
+struct FFootSyncFrameHistory
+{
+	/** Number of frames kept (covers a two-frame neighborhood on each side) */
+	static constexpr int32 Capacity = 5;
+
+	/** Start an empty history */
+	void Reset()
+	{
+		NumFrames = 0;
+		NumPushed = 0;
+	}
+
+	/** Add the newest frame, dropping the oldest one when full */
+	void Push(double Time, const FVector& Position, const FVector& PelvisRelative)
+	{
+		for (int32 Age = FMath::Min(NumFrames, Capacity - 1); Age > 0; --Age)
+		{
+			Frames[Age] = Frames[Age - 1];
+		}
+		Frames[0] = { Time, Position, PelvisRelative };
+		NumFrames = FMath::Min(NumFrames + 1, Capacity);
+		++NumPushed;
+	}
+
+	/** Number of frames currently kept */
+	int32 Num() const { return NumFrames; }
+
+	/** Number of frames pushed since the last reset */
+	int64 GetNumPushed() const { return NumPushed; }
+
+	/** Time of the frame with the given age (0 = newest) */
+	double GetTime(int32 Age) const { check(Age < NumFrames); return Frames[Age].Time; }
+
+	/** Position of the frame with the given age (0 = newest) */
+	const FVector& GetPosition(int32 Age) const { check(Age < NumFrames); return Frames[Age].Position; }
+
+	/** Pelvis-relative position of the frame with the given age (0 = newest) */
+	const FVector& GetPelvisRelative(int32 Age) const { check(Age < NumFrames); return Frames[Age].PelvisRelative; }
+
+private:
+	struct FFrame
+	{
+		double Time = 0.0;
+		FVector Position = FVector::ZeroVector;
+		FVector PelvisRelative = FVector::ZeroVector;
+	};
+
+	FFrame Frames[Capacity];
+	int32 NumFrames = 0;
+	int64 NumPushed = 0;
+};
@@ -0,0 +1,19 @@
+// Copyright 2025 Jeonghyeon Ha. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * Runtime foot contact detection shared with the editor pipeline
+ * The detector math (FFootSyncContactMath, FFootSyncFrameHistory, FFootSyncContactTracker)
+ * only depends on Core; UFootSyncContactComponent feeds it from a skeletal mesh.
+ */
+class FFootSyncRuntimeModule : public IModuleInterface
+{
+public:
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};